@@ -0,0 +1,115 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "particleRepresentation/container/ParticleContainer.h"
+#include "particleRepresentation/particle/Particle.h"
+#include "utils/enumsStructs.h"
+
+/**
+ * @brief Common setup of the micro-benchmarks.
+ *
+ * Most benchmarks are parameterised over the number of particles, the density and the number of dimensions. The
+ * particles are placed on a regular lattice whose spacing yields the requested density.
+ */
+namespace BenchmarkSetup {
+    /**
+     * @brief Particles on a lattice and the domain enclosing them.
+     */
+    struct Lattice {
+        std::vector<Particle> particles;
+        std::array<double, 3> domainSize;
+        double spacing;
+    };
+
+    /**
+     * @brief Place particles on a square (2D) or cubic (3D) lattice.
+     *
+     * @param numberParticles Number of particles.
+     * @param density Number of particles per unit area (2D) or unit volume (3D).
+     * @param dimensions Number of dimensions (2 or 3).
+     *
+     * @return Particles and the smallest domain containing the whole lattice.
+     */
+    inline Lattice createLattice(size_t numberParticles, double density, int dimensions) {
+        Lattice lattice;
+        lattice.spacing = std::pow(1 / density, 1.0 / dimensions);
+        const auto perSide = static_cast<size_t>(std::ceil(std::pow(static_cast<double>(numberParticles),
+                                                                    1.0 / dimensions) - 1e-9));
+        const double side = static_cast<double>(perSide) * lattice.spacing;
+        lattice.domainSize = {side, side, dimensions == 3 ? side : 0};
+
+        lattice.particles.reserve(numberParticles);
+        for (size_t i = 0; i < numberParticles; i++) {
+            std::array<double, 3> x{};
+            size_t index = i;
+            for (int dim = 0; dim < dimensions; dim++) {
+                x[dim] = (static_cast<double>(index % perSide) + 0.5) * lattice.spacing;
+                index /= perSide;
+            }
+            lattice.particles.emplace_back(x, std::array<double, 3>{0, 0, 0}, 1);
+        }
+        return lattice;
+    }
+
+    /**
+     * @brief Create the lattice described by the arguments of a benchmark registered with latticeArguments().
+     *
+     * @param state State of the benchmark.
+     *
+     * @return Particles and the domain enclosing them.
+     */
+    inline Lattice createLattice(const benchmark::State &state) {
+        return createLattice(static_cast<size_t>(state.range(0)), static_cast<double>(state.range(1)) / 1000,
+                             static_cast<int>(state.range(2)));
+    }
+
+    /**
+     * @brief Register all combinations of particle count, density (in particles per 1000 units of volume) and number
+     *        of dimensions as arguments of a benchmark.
+     *
+     * @param benchmark Benchmark to parameterise.
+     */
+    inline void latticeArguments(benchmark::internal::Benchmark *benchmark) {
+        benchmark->ArgNames({"particles", "density", "dims"})
+                ->ArgsProduct({{1000, 8000, 32000}, {200, 800}, {2, 3}});
+    }
+
+    /**
+     * @brief Add copies of all particles of a lattice to a container.
+     *
+     * @param container Container to fill.
+     * @param lattice Lattice to copy the particles from.
+     */
+    inline void addLattice(ParticleContainer &container, const Lattice &lattice) {
+        for (Particle p: lattice.particles) {
+            container.add(p);
+        }
+    }
+
+    /**
+     * @brief Create a boundary set with the same condition on all sides.
+     *
+     * @param condition Boundary condition of all sides.
+     *
+     * @return Boundary set.
+     */
+    inline enumsStructs::BoundarySet uniformBoundaries(enumsStructs::BoundaryCondition condition) {
+        return {condition, condition, condition, condition, condition, condition};
+    }
+
+    /**
+     * @brief Get a directory for the files written by the benchmarks of the output writers.
+     *
+     * @return Path of the directory, which is created if it does not exist.
+     */
+    inline std::string outputDirectory() {
+        auto directory = std::filesystem::temp_directory_path() / "MolSimBench";
+        std::filesystem::create_directories(directory);
+        return directory.string();
+    }
+}
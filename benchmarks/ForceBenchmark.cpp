@@ -0,0 +1,123 @@
+#include "BenchmarkSetup.h"
+#include "models/directSum/DirectSum.h"
+#include "models/linkedCells/LinkedCells.h"
+#include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
+#include "particleRepresentation/container/linkedCellsContainer/LinkedCellsContainer.h"
+
+namespace {
+    /**
+     * @brief Pair of particles within the cut-off radius together with their difference vector and distance.
+     */
+    struct Pair {
+        Particle *p_i;
+        Particle *p_j;
+        std::array<double, 3> difference;
+        double distance;
+    };
+
+    /**
+     * @brief Collect all pairs of particles within the cut-off radius of a lattice.
+     *
+     * @param container Linked cells container holding the lattice.
+     *
+     * @return All pairs within the cut-off radius.
+     */
+    std::vector<Pair> collectPairs(LinkedCellsContainer &container) {
+        std::vector<Pair> pairs;
+        container.forEachUniquePairInDomainOptimized([&pairs](Particle &p_i, Particle &p_j,
+                                                              std::array<double, 3> &difference, double distance) {
+            pairs.push_back({&p_i, &p_j, difference, distance});
+        });
+        return pairs;
+    }
+}
+
+/**
+ * Lennard-Jones force of all pairs within the cut-off radius, including the distance calculation.
+ */
+static void BM_LeonardJonesCompute(benchmark::State &state) {
+    auto lattice = BenchmarkSetup::createLattice(state);
+    LinkedCellsContainer container{
+        lattice.domainSize, 2.5, BenchmarkSetup::uniformBoundaries(BoundaryCondition::outflow)
+    };
+    BenchmarkSetup::addLattice(container, lattice);
+    auto pairs = collectPairs(container);
+    LeonardJonesForce lJF;
+    for (auto _: state) {
+        for (auto &pair: pairs) {
+            benchmark::DoNotOptimize(lJF.compute(*pair.p_i, *pair.p_j));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pairs.size()));
+}
+
+BENCHMARK(BM_LeonardJonesCompute)->Apply(BenchmarkSetup::latticeArguments);
+
+/**
+ * Lennard-Jones force of all pairs within the cut-off radius with precomputed difference vectors and distances.
+ */
+static void BM_LeonardJonesComputeOptimized(benchmark::State &state) {
+    auto lattice = BenchmarkSetup::createLattice(state);
+    LinkedCellsContainer container{
+        lattice.domainSize, 2.5, BenchmarkSetup::uniformBoundaries(BoundaryCondition::outflow)
+    };
+    BenchmarkSetup::addLattice(container, lattice);
+    auto pairs = collectPairs(container);
+    LeonardJonesForce lJF;
+    for (auto _: state) {
+        for (auto &pair: pairs) {
+            benchmark::DoNotOptimize(lJF.computeOptimized(*pair.p_i, *pair.p_j, pair.difference, pair.distance));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pairs.size()));
+}
+
+BENCHMARK(BM_LeonardJonesComputeOptimized)->Apply(BenchmarkSetup::latticeArguments);
+
+/**
+ * Force calculation of the linked cells model on a single thread for both particle layouts. With the structure of
+ * arrays layout, this includes copying the particles into the buffers of the cells and the forces back.
+ */
+static void BM_LinkedCellsForces(benchmark::State &state) {
+    auto lattice = BenchmarkSetup::createLattice(state);
+    const ParticleLayout layout = state.range(3) == 0 ? ParticleLayout::aos : ParticleLayout::soa;
+    LeonardJonesForce lJF;
+    LinkedCells model{
+        lJF, 0.0005, lattice.domainSize, 2.5, FileHandler::outputFormat::vtk,
+        BenchmarkSetup::uniformBoundaries(BoundaryCondition::outflow), false, 1, layout
+    };
+    for (Particle p: lattice.particles) {
+        model.addParticle(p);
+    }
+    for (auto _: state) {
+        model.updateForces();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lattice.particles.size()));
+}
+
+BENCHMARK(BM_LinkedCellsForces)
+        ->ArgNames({"particles", "density", "dims", "soa"})
+        ->ArgsProduct({{1000, 8000, 32000}, {200, 800}, {2, 3}, {0, 1}})
+        ->Unit(benchmark::kMillisecond);
+
+/**
+ * Force calculation of the direct sum model on a single thread.
+ */
+static void BM_DirectSumForces(benchmark::State &state) {
+    auto lattice = BenchmarkSetup::createLattice(static_cast<size_t>(state.range(0)), 0.8, 3);
+    LeonardJonesForce lJF;
+    DirectSum model{lJF, 0.0005, FileHandler::outputFormat::vtk, false};
+    for (Particle p: lattice.particles) {
+        model.addParticle(p);
+    }
+    for (auto _: state) {
+        model.updateForces();
+    }
+    const auto n = static_cast<int64_t>(lattice.particles.size());
+    state.SetItemsProcessed(state.iterations() * n * (n - 1) / 2);
+}
+
+BENCHMARK(BM_DirectSumForces)
+        ->ArgNames({"particles"})
+        ->Arg(1000)->Arg(4000)->Arg(16000)
+        ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,106 @@
+#include "BenchmarkSetup.h"
+#include "particleRepresentation/container/linkedCellsContainer/LinkedCellsContainer.h"
+
+/**
+ * Cell index of every particle of the lattice.
+ */
+static void BM_CalcCellIndex(benchmark::State &state) {
+    auto lattice = BenchmarkSetup::createLattice(state);
+    LinkedCellsContainer container{
+        lattice.domainSize, 2.5, BenchmarkSetup::uniformBoundaries(BoundaryCondition::outflow)
+    };
+    for (auto _: state) {
+        for (auto &p: lattice.particles) {
+            benchmark::DoNotOptimize(container.calcCellIndex(p.getX()));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lattice.particles.size()));
+}
+
+BENCHMARK(BM_CalcCellIndex)->Apply(BenchmarkSetup::latticeArguments);
+
+/**
+ * Reassignment of all particles to their cells after every particle has moved by 40 % of the lattice spacing, so
+ * that some of them change their cell.
+ */
+static void BM_UpdateCells(benchmark::State &state) {
+    auto lattice = BenchmarkSetup::createLattice(state);
+    LinkedCellsContainer container{
+        lattice.domainSize, 2.5, BenchmarkSetup::uniformBoundaries(BoundaryCondition::outflow)
+    };
+    BenchmarkSetup::addLattice(container, lattice);
+    const double shift = 0.4 * lattice.spacing;
+    const bool threeD = state.range(2) == 3;
+    double direction = 1;
+    for (auto _: state) {
+        state.PauseTiming();
+        container.applyToEachParticleInDomain([&](Particle &p) {
+            p.setX(p.getX() + std::array<double, 3>{direction * shift, direction * shift, threeD ? direction * shift : 0});
+        });
+        direction = -direction;
+        state.ResumeTiming();
+        container.updateCells();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lattice.particles.size()));
+}
+
+BENCHMARK(BM_UpdateCells)->Apply(BenchmarkSetup::latticeArguments);
+
+/**
+ * Iteration over all unique pairs within the cut-off radius.
+ */
+static void BM_ApplyToAllUniquePairsInDomainOptimized(benchmark::State &state) {
+    auto lattice = BenchmarkSetup::createLattice(state);
+    LinkedCellsContainer container{
+        lattice.domainSize, 2.5, BenchmarkSetup::uniformBoundaries(BoundaryCondition::outflow)
+    };
+    BenchmarkSetup::addLattice(container, lattice);
+    int64_t pairs = 0;
+    for (auto _: state) {
+        container.applyToAllUniquePairsInDomainOptimized([&pairs](Particle &, Particle &, std::array<double, 3>,
+                                                                  double distance) {
+            benchmark::DoNotOptimize(distance);
+            pairs++;
+        });
+    }
+    state.SetItemsProcessed(pairs);
+}
+
+BENCHMARK(BM_ApplyToAllUniquePairsInDomainOptimized)->Apply(BenchmarkSetup::latticeArguments);
+
+/**
+ * Creation and removal of the images of the ghost layer across periodic boundaries.
+ */
+static void BM_GhostLayer(benchmark::State &state) {
+    auto lattice = BenchmarkSetup::createLattice(state);
+    LinkedCellsContainer container{
+        lattice.domainSize, 2.5, BenchmarkSetup::uniformBoundaries(BoundaryCondition::periodic)
+    };
+    BenchmarkSetup::addLattice(container, lattice);
+    for (auto _: state) {
+        container.createGhostParticles();
+        container.removeGhostParticles();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lattice.particles.size()));
+}
+
+BENCHMARK(BM_GhostLayer)->Apply(BenchmarkSetup::latticeArguments);
+
+/**
+ * Copying the particles into the structure of arrays buffers of the cells and the forces back, i.e. the overhead of
+ * the structure of arrays layout compared to BM_LinkedCellsForces.
+ */
+static void BM_SoAMirror(benchmark::State &state) {
+    auto lattice = BenchmarkSetup::createLattice(state);
+    LinkedCellsContainer container{
+        lattice.domainSize, 2.5, BenchmarkSetup::uniformBoundaries(BoundaryCondition::outflow), ParticleLayout::soa
+    };
+    BenchmarkSetup::addLattice(container, lattice);
+    for (auto _: state) {
+        container.loadSoA();
+        container.extractSoA();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lattice.particles.size()));
+}
+
+BENCHMARK(BM_SoAMirror)->Apply(BenchmarkSetup::latticeArguments);
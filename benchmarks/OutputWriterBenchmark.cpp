@@ -0,0 +1,154 @@
+#include "BenchmarkSetup.h"
+#include "fileHandling/outputWriter/CheckpointWriter/CheckpointWriter.h"
+#include "fileHandling/outputWriter/PVTUWriter/PVTUWriter.h"
+#include "fileHandling/outputWriter/TXTWriter/TxtWriter.h"
+#include "fileHandling/outputWriter/TrajectoryWriter/TrajectoryWriter.h"
+#include "fileHandling/outputWriter/VTKWriter/VTKWriter.h"
+#include "fileHandling/outputWriter/VTUWriter/VTUWriter.h"
+#include "fileHandling/outputWriter/XYZWriter/XYZWriter.h"
+#include "particleRepresentation/container/defaultParticleContainer/DefaultParticleContainer.h"
+
+namespace {
+    /**
+     * @brief Register all combinations of particle count and number of dimensions as arguments of a benchmark. The
+     *        density has no influence on the output, so it is fixed.
+     *
+     * @param benchmark Benchmark to parameterise.
+     */
+    void writerArguments(benchmark::internal::Benchmark *benchmark) {
+        benchmark->ArgNames({"particles", "density", "dims"})
+                ->ArgsProduct({{1000, 8000, 32000}, {800}, {2, 3}});
+    }
+
+    /**
+     * @brief Fill a container with the lattice described by the arguments of the benchmark.
+     */
+    void fill(DefaultParticleContainer &container, const benchmark::State &state) {
+        BenchmarkSetup::addLattice(container, BenchmarkSetup::createLattice(state));
+    }
+
+    void setProcessed(benchmark::State &state, const DefaultParticleContainer &container) {
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(container.size()));
+    }
+
+    const std::string &outputBaseName() {
+        static const std::string baseName = BenchmarkSetup::outputDirectory() + "/bench";
+        return baseName;
+    }
+}
+
+static void BM_VTKWriter(benchmark::State &state) {
+    DefaultParticleContainer container;
+    fill(container, state);
+    outputWriter::VTKWriter writer;
+    for (auto _: state) {
+        writer.initializeOutput(static_cast<int>(container.size()));
+        container.forEachParticle([&writer](Particle &p) {
+            writer.plotParticle(p);
+        });
+        writer.writeFile(outputBaseName(), 0);
+    }
+    setProcessed(state, container);
+}
+
+BENCHMARK(BM_VTKWriter)->Apply(writerArguments);
+
+static void BM_VTUWriter(benchmark::State &state) {
+    DefaultParticleContainer container;
+    fill(container, state);
+    outputWriter::VTUWriter writer;
+    for (auto _: state) {
+        writer.plotParticles(container, outputBaseName(), 0);
+    }
+    setProcessed(state, container);
+}
+
+BENCHMARK(BM_VTUWriter)->Apply(writerArguments);
+
+static void BM_VTUWriterCompressed(benchmark::State &state) {
+    if (!outputWriter::VTUWriter::isCompressionAvailable()) {
+        state.SkipWithError("MolSim was built without zlib");
+        return;
+    }
+    DefaultParticleContainer container;
+    fill(container, state);
+    outputWriter::VTUWriter writer{outputWriter::VTUWriter::Precision::float32, true};
+    for (auto _: state) {
+        writer.plotParticles(container, outputBaseName(), 0);
+    }
+    setProcessed(state, container);
+}
+
+BENCHMARK(BM_VTUWriterCompressed)->Apply(writerArguments);
+
+/**
+ * Every iteration starts a new time series, so that each iteration writes one frame and a .pvd file with a single
+ * entry, independent of the number of iterations. The buffers of the pieces are reused between the iterations.
+ */
+static void BM_PVTUWriter(benchmark::State &state) {
+    DefaultParticleContainer container;
+    fill(container, state);
+    outputWriter::PVTUWriter writer;
+    for (auto _: state) {
+        writer.plotParticles(container, outputBaseName(), 0, 0);
+        state.PauseTiming();
+        writer.resetSeries();
+        state.ResumeTiming();
+    }
+    setProcessed(state, container);
+}
+
+BENCHMARK(BM_PVTUWriter)->Apply(writerArguments);
+
+static void BM_XYZWriter(benchmark::State &state) {
+    DefaultParticleContainer container;
+    fill(container, state);
+    outputWriter::XYZWriter writer;
+    for (auto _: state) {
+        writer.plotParticles(container, outputBaseName(), 0);
+    }
+    setProcessed(state, container);
+}
+
+BENCHMARK(BM_XYZWriter)->Apply(writerArguments);
+
+static void BM_TxtWriter(benchmark::State &state) {
+    DefaultParticleContainer container;
+    fill(container, state);
+    for (auto _: state) {
+        TxtWriter::writeToFile(container, outputBaseName() + ".txt");
+    }
+    setProcessed(state, container);
+}
+
+BENCHMARK(BM_TxtWriter)->Apply(writerArguments);
+
+/**
+ * The trajectory is closed after every frame, so that each iteration writes one frame and the frame index to a new
+ * file instead of growing a single file without bounds.
+ */
+static void BM_TrajectoryWriter(benchmark::State &state) {
+    DefaultParticleContainer container;
+    fill(container, state);
+    outputWriter::TrajectoryWriter writer;
+    for (auto _: state) {
+        writer.plotParticles(container, outputBaseName(), 0, 0);
+        writer.close();
+    }
+    setProcessed(state, container);
+}
+
+BENCHMARK(BM_TrajectoryWriter)->Apply(writerArguments);
+
+static void BM_CheckpointWriter(benchmark::State &state) {
+    DefaultParticleContainer container;
+    fill(container, state);
+    Checkpoint::Header header;
+    header.particleCount = container.size();
+    for (auto _: state) {
+        CheckpointWriter::writeToFile(container, header, outputBaseName() + ".bin");
+    }
+    setProcessed(state, container);
+}
+
+BENCHMARK(BM_CheckpointWriter)->Apply(writerArguments);
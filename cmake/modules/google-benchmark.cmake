@@ -0,0 +1,73 @@
+#Reference: https://github.com/google/benchmark#usage-with-cmake
+
+option(BUILD_BENCHMARKS "Build the micro-benchmarks (MolSimBench)" OFF)
+
+if (BUILD_BENCHMARKS)
+    message(STATUS "Enabled Google Benchmark")
+
+    # Use an installed Google Benchmark if available, otherwise download it
+    find_package(benchmark QUIET)
+    if (NOT benchmark_FOUND)
+        include(FetchContent)
+        FetchContent_Declare(
+                googlebenchmark
+                URL https://github.com/google/benchmark/archive/refs/tags/v1.8.3.zip
+        )
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+        FetchContent_MakeAvailable(googlebenchmark)
+    endif ()
+
+    file(GLOB_RECURSE BENCHMARKS
+            "${CMAKE_CURRENT_SOURCE_DIR}/src/*.cpp"
+            "${CMAKE_CURRENT_SOURCE_DIR}/src/*.h"
+            "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/*.cpp"
+            "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/*.h"
+    )
+
+    # BenchmarkMain.cpp provides the main of the benchmarks
+    list(FILTER BENCHMARKS EXCLUDE REGEX "MolSim.cpp")
+
+    add_executable(MolSimBench ${BENCHMARKS})
+
+    target_compile_features(MolSimBench
+            PRIVATE
+            cxx_std_17
+    )
+
+    target_include_directories(MolSimBench
+            PUBLIC
+            ${CMAKE_CURRENT_SOURCE_DIR}/src
+            ${CMAKE_CURRENT_SOURCE_DIR}/benchmarks
+            PRIVATE
+            ${CMAKE_CURRENT_SOURCE_DIR}/libs/libxsd
+    )
+
+    target_link_libraries(
+            MolSimBench
+            PUBLIC
+            benchmark::benchmark
+            spdlog::spdlog
+            XercesC::XercesC
+            OpenMP::OpenMP_CXX
+            Threads::Threads
+    )
+
+    if (ZLIB_FOUND)
+        target_compile_definitions(MolSimBench PUBLIC MOLSIM_WITH_ZLIB)
+        target_link_libraries(MolSimBench PUBLIC ZLIB::ZLIB)
+    endif ()
+
+    if (MOLSIM_WITH_PHASE_TIMERS)
+        target_compile_definitions(MolSimBench PUBLIC MOLSIM_WITH_PHASE_TIMERS)
+    endif ()
+
+    if (MOLSIM_WITH_TRACING)
+        target_compile_definitions(MolSimBench PUBLIC MOLSIM_WITH_TRACING)
+    endif ()
+
+    if (MOLSIM_WITH_MPI)
+        target_compile_definitions(MolSimBench PUBLIC MOLSIM_WITH_MPI)
+        target_link_libraries(MolSimBench PUBLIC MPI::MPI_CXX)
+    endif ()
+endif ()
@@ -34,6 +34,12 @@ list(FILTER TESTS EXCLUDE REGEX "MolSim.cpp")
 
 add_executable(MolSimTests ${TESTS})
 
+#The tests compile the sources of MolSim, so they need the same standard
+target_compile_features(MolSimTests
+        PRIVATE
+        cxx_std_17
+)
+
 target_include_directories(MolSimTests
         PUBLIC
         ${CMAKE_CURRENT_SOURCE_DIR}/src
@@ -50,13 +56,40 @@ target_link_libraries(
         GTest::gmock_main
         spdlog::spdlog
         XercesC::XercesC
+        OpenMP::OpenMP_CXX
+        Threads::Threads
 )
+
+if (ZLIB_FOUND)
+    target_compile_definitions(MolSimTests PUBLIC MOLSIM_WITH_ZLIB)
+    target_link_libraries(MolSimTests PUBLIC ZLIB::ZLIB)
+endif ()
+
+if (MOLSIM_WITH_PHASE_TIMERS)
+    target_compile_definitions(MolSimTests PUBLIC MOLSIM_WITH_PHASE_TIMERS)
+endif ()
+
+if (MOLSIM_WITH_TRACING)
+    target_compile_definitions(MolSimTests PUBLIC MOLSIM_WITH_TRACING)
+endif ()
+
+if (MOLSIM_WITH_MPI)
+    target_compile_definitions(MolSimTests PUBLIC MOLSIM_WITH_MPI)
+    target_link_libraries(MolSimTests PUBLIC MPI::MPI_CXX)
+endif ()
 enable_testing()
 
 include(GoogleTest)
 
 gtest_discover_tests(MolSimTests)
 
+# The domain decomposition tests additionally run on 4 processes
+if (MOLSIM_WITH_MPI)
+    add_test(NAME DomainDecompositionMPI
+            COMMAND ${MPIEXEC_EXECUTABLE} ${MPIEXEC_NUMPROC_FLAG} 4 ${MPIEXEC_PREFLAGS} $<TARGET_FILE:MolSimTests>
+            ${MPIEXEC_POSTFLAGS} --gtest_filter=DomainDecomposition*)
+endif ()
+
 
 
 
@@ -14,6 +14,8 @@
 # ${11} - OPTIONAL: -t for BENCHMARKING
 # ${12} - OPTIONAL: -p for PROFILING
 # ${13} - OPTIONAL: -O for optimisation
+# The memory requested for the job is taken from the environment variable MEMORY (default: 1000mb). Run MolSim with
+# --memory on a representative input to measure the peak usage and get a suggested value.
 
 # Define color codes
 RED='\033[0;31m'
@@ -23,6 +25,7 @@ NC='\033[0m'
 FLAG_T=""
 FLAG_P=""
 OPTIMISATION=""
+MEMORY="${MEMORY:-1000mb}"
 
 # Function to display help message
 function display_help() {
@@ -43,6 +46,9 @@ function display_help() {
     echo -e "${YELLOW}PROFILING${NC}          Optional flag -p for profiling"
     echo -e "${YELLOW}OPTIMISATION${NC}       Optional flag -O for optimisation"
     echo
+    echo -e "Set the environment variable ${YELLOW}MEMORY${NC} to change the memory requested for the job (default: 1000mb)."
+    echo "Run MolSim with --memory to measure the peak memory usage and get a suggested value."
+    echo
     echo "Example:"
     echo -e "${YELLOW}  $0 MolSim_Group_A serial serial_std ALL your_university_email@example.com 4 02:00:00 ../input/assignment-3/2d-cuboid-collision.xml xml vtk -t -p -O${NC}"
     echo
@@ -159,6 +165,7 @@ echo -e "${GREEN}OUTPUT_FILE_FORMAT: ${YELLOW}${10}${NC}"
 echo -e "${GREEN}BENCHMARKING: ${YELLOW}${FLAG_T}${NC}"
 echo -e "${GREEN}PROFILING: ${YELLOW}${FLAG_P}${NC}"
 echo -e "${GREEN}OPTIMISATION: ${YELLOW}${OPTIMISATION}${NC}"
+echo -e "${GREEN}MEMORY: ${YELLOW}${MEMORY}${NC}"
 
 # Remove any existing cluster_start.cmd file
 cd .. && rm -f cluster_start.cmd
@@ -174,7 +181,7 @@ cat <<EOL > cluster_start.cmd
 #SBATCH --partition=${3}
 #SBATCH --mail-type=${4}
 #SBATCH --mail-user=${5}
-#SBATCH --mem=1000mb
+#SBATCH --mem=${MEMORY}
 #SBATCH --cpus-per-task=${6}
 #SBATCH --export=NONE
 #SBATCH --time=${7}
@@ -8,7 +8,28 @@
 #include "utils/InputHandler.h"
 #include "utils/OutputHandler.h"
 
+#ifdef MOLSIM_WITH_MPI
+#include "models/linkedCells/DomainDecomposition.h"
+
+/**
+ * @brief Initialises MPI for the lifetime of the program, so it is finalised on every return path.
+ */
+struct MPIEnvironment {
+    MPIEnvironment(int *argc, char ***argv) {
+        MPI_Init(argc, argv);
+    }
+
+    ~MPIEnvironment() {
+        MPI_Finalize();
+    }
+};
+#endif
+
 int main(int argc, char *argsv[]) {
+#ifdef MOLSIM_WITH_MPI
+    //Each process simulates one subdomain of the linked cells model (see DomainDecomposition)
+    MPIEnvironment mpiEnvironment(&argc, &argsv);
+#endif
     //Parameters for simulation
     try {
         double endT;
@@ -16,9 +37,11 @@ int main(int argc, char *argsv[]) {
         std::string inputFilePath;
         std::string inputFileFormatString;
         std::string outputFileFormatString;
+        std::string stateFormatString;
         std::string pathToMolecules;
         FileHandler::outputFormat outputFormat;
         FileHandler::inputFormat inputFormat;
+        FileHandler::stateFormat stateFormat;
         enumsStructs::TypeOfForce force;
         std::string logLevel;
         std::string selectedForce;
@@ -27,6 +50,16 @@ int main(int argc, char *argsv[]) {
         bool saveState = false;
         bool loadState = false;
         int outputFrequency;
+        int threads;
+        int outputQueue;
+        std::string vtuPrecisionString;
+        int vtuPieces;
+        std::string phaseTimesFile;
+        std::string traceFile;
+        int traceCapacity;
+        int pairStatisticsInterval;
+        std::string pairStatisticsFile;
+        outputWriter::VTUWriter::Precision vtuPrecision;
 
         //Parsing of the command line arguments
 
@@ -46,16 +79,39 @@ int main(int argc, char *argsv[]) {
                 ("inputFileFormatString,i", po::value<std::string>(&inputFileFormatString),
                  "Format of the input file. Supported formats are txt and xml.")
                 ("outputFileFormatString,o", po::value<std::string>(&outputFileFormatString)->default_value("vtk"),
-                 "Format of the output file. Supported formats are vtk and xyz. Default is vtk.")
+                 "Format of the output file. Supported formats are vtk, vtu (binary), pvtu (binary, written in parallel pieces with a .pvd time series), traj (all frames appended to one binary file) and xyz. Default is vtk.")
                 ("time,t", "Perform time measurement. Logging will be disabled.")
+                ("counters", "Count hardware events (cycles, instructions, cache and branch misses, floating point operations) during the time measurement. Only available on Linux.")
                 ("force,c", po::value<std::string>(&selectedForce)->default_value("ljf"),
                  "Force to use: Possible options are (gravity, ljf)")
                 ("freq", po::value<int>(&outputFrequency)->default_value(50), "Output frequency.")
                 ("baseName,b", po::value<std::string>(&outputFileName)->default_value("MD_vtk_"),
                  "Base name of the output files.")
                 ("loadState", po::value<std::string>(&pathToMolecules),
-                 "Load molecules from a checkpoint into your program")
-                ("saveState", "Save state of molecules to a txt file after the simulation is done");;
+                 "Load molecules from a checkpoint into your program. Binary checkpoints replace the molecules of the input file and resume the simulation, bit-exactly unless Verlet lists are used. Txt files add their molecules.")
+                ("saveState", "Save state of molecules to a checkpoint after the simulation is done")
+                ("stateFormat", po::value<std::string>(&stateFormatString)->default_value("binary"),
+                 "Format of the checkpoint written by saveState. Supported formats are binary (Checkpoint.bin) and txt (Checkpoint.txt).")
+                ("threads", po::value<int>(&threads)->default_value(0),
+                 "Number of threads used for the force calculation. Overrides the value of the xml file if greater than 0.")
+                ("outputQueue", po::value<int>(&outputQueue)->default_value(2),
+                 "Number of frames buffered for writing the output on a background thread. Use 0 to write the output synchronously.")
+                ("vtuPrecision", po::value<std::string>(&vtuPrecisionString)->default_value("float32"),
+                 "Precision of the floating point arrays in vtu files. Possible options are (float32, float64)")
+                ("vtuCompression", "Compress vtu files with zlib. Only available, if MolSim was built with zlib.")
+                ("vtuPieces", po::value<int>(&vtuPieces)->default_value(0),
+                 "Number of pieces written in parallel per frame of the pvtu output. Use 0 to write one piece per thread, or 2 pieces if the output is written on a background thread.")
+                ("phaseTimes", po::value<std::string>(&phaseTimesFile),
+                 "Write the time of each phase of every step to this csv file. Only available, if MolSim was built with MOLSIM_WITH_PHASE_TIMERS.")
+                ("trace", po::value<std::string>(&traceFile),
+                 "Write a trace of the phases, the output and the worker threads of the run to this json file, which can be opened in Perfetto. Only available, if MolSim was built with MOLSIM_WITH_TRACING.")
+                ("traceCapacity", po::value<int>(&traceCapacity)->default_value(1000000),
+                 "Maximal number of spans kept in the trace. If more spans are recorded, only the most recent ones are written.")
+                ("pairStatistics", po::value<int>(&pairStatisticsInterval)->default_value(0),
+                 "Sample the candidate pairs, the pairs within the cut-off radius, the particles per cell and the migrated particles of the linked cells model every given number of steps and print a summary at the end of the run. Use 0 to disable the sampling.")
+                ("pairStatisticsFile", po::value<std::string>(&pairStatisticsFile),
+                 "Write every sample of the pair statistics to this csv file.")
+                ("memory", "Report the memory held by the particles, the cells, the precomputed indices and the output buffers at the start of the run and at peak, together with the peak resident set size. Use it to choose the --mem value of Slurm jobs.");
 
         po::variables_map vm;
 
@@ -116,10 +172,51 @@ int main(int argc, char *argsv[]) {
             return -1;
         }
 
+        if (stateFormat = setStateFormat(stateFormatString); stateFormat == FileHandler::stateFormat::invalid) {
+            std::cout << "Please specify a valid checkpoint format!\n";
+            std::cout << desc << "\n";
+            return -1;
+        }
+
+        if (!setVTUPrecision(vtuPrecisionString, vtuPrecision)) {
+            std::cout << "Please specify a valid vtu precision!\n";
+            std::cout << desc << "\n";
+            return -1;
+        }
+
+        if (vm.count("vtuCompression") && !outputWriter::VTUWriter::isCompressionAvailable()) {
+            std::cout << "Compression of vtu files is not available, MolSim was built without zlib!\n";
+            return -1;
+        }
+
+        if (vtuPieces < 0) {
+            std::cout << "Please specify a valid number of vtu pieces!\n";
+            std::cout << desc << "\n";
+            return -1;
+        }
+
+        if (threads < 0) {
+            std::cout << "Please specify a valid number of threads!\n";
+            std::cout << desc << "\n";
+            return -1;
+        }
+
+        if (outputQueue < 0) {
+            std::cout << "Please specify a valid size of the output queue!\n";
+            std::cout << desc << "\n";
+            return -1;
+        }
+
         if (vm.count("time")) {
             benchmark = true;
         }
 
+        if (vm.count("counters") && !benchmark) {
+            std::cout << "Hardware counters can only be collected during the time measurement (-t)!\n";
+            std::cout << desc << "\n";
+            return -1;
+        }
+
         if (vm.count("saveState")) {
             saveState = true;
         }
@@ -139,6 +236,10 @@ int main(int argc, char *argsv[]) {
             if (returnedErrorHandlingInt != 0) {
                 throw std::invalid_argument("Error while reading the XML file. Please check the file and try again. Exiting...");
             }
+            if (threads > 0) {
+                simulationSettings.parametersDirectSum.threads = threads;
+                simulationSettings.parametersLinkedCells.threads = threads;
+            }
             simulator = std::make_unique<Simulator>(simulationSettings, outputFormat);
         }
             //Legacy input over the command line
@@ -152,11 +253,18 @@ int main(int argc, char *argsv[]) {
                 std::cout << desc << "\n";
                 return -1;
             }
-            DirectSumSimulationParameters parameters = {deltaT, endT, force};
+            DirectSumSimulationParameters parameters = {deltaT, endT, force, threads > 0 ? threads : 1};
             simulator = std::make_unique<Simulator>(parameters, inputFilePath, outputFormat, outputFrequency,
                                                     outputFileName);
         }
 
+        simulator->setAsyncOutput(static_cast<size_t>(outputQueue));
+        simulator->setVTUOptions(vtuPrecision, vm.count("vtuCompression") > 0, static_cast<size_t>(vtuPieces));
+        simulator->setPhaseTimesFile(phaseTimesFile);
+        simulator->setTraceFile(traceFile, static_cast<size_t>(traceCapacity > 0 ? traceCapacity : 0));
+        simulator->setPairStatistics(pairStatisticsInterval, pairStatisticsFile);
+        simulator->setMemoryReport(vm.count("memory") > 0);
+
         //Load state of molecules of a previous simulation if specified
         if (loadState) {
             spdlog::info("Loading state of molecules...");
@@ -167,7 +275,7 @@ int main(int argc, char *argsv[]) {
 
         if (benchmark) {
             spdlog::info("Starting time measurement...");
-            performBenchmark(*simulator);
+            performBenchmark(*simulator, vm.count("counters") > 0);
             spdlog::info("No output written.");
         } else {
             spdlog::info("Running without time measurement...");
@@ -176,13 +284,19 @@ int main(int argc, char *argsv[]) {
 
         //Writing state of the molecules to a file if specified
         if (saveState) {
-            simulator->saveState();
+            simulator->saveState(stateFormat);
             spdlog::info("Saving state of molecules...");
         }
         return 0;
     }
     catch (const std::exception &e) {
         spdlog::error(e.what());
+#ifdef MOLSIM_WITH_MPI
+        //The other processes would wait for this one forever
+        if (DomainDecomposition::getNumberOfWorldProcesses() > 1) {
+            MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+        }
+#endif
         return EXIT_FAILURE;
     }
 }
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "utils/enumsStructs.h"
+
+/**
+ * @brief Binary checkpoint format.
+ *
+ * A checkpoint consists of a header followed by one fixed size record per particle. All values are stored
+ * in little endian byte order, so the files are portable between machines. Floating point values are stored as raw
+ * IEEE 754 doubles, so a simulation can be resumed bit-exactly.
+ *
+ * Layout of the header (version 1):
+ * - magic "MOLSIMCP" (8 bytes)
+ * - version (uint32)
+ * - particle count (uint64)
+ * - domain size (3 x double)
+ * - boundary conditions front, right, back, left, top, bottom (6 x int32)
+ * - simulation time (double)
+ * - iteration (int64)
+ * - length of the random engine state (uint32), followed by the state in its textual representation
+ *
+ * Layout of one particle record: x, v, f, old_f (12 x double), m, epsilon, sigma (3 x double), type (int32).
+ */
+namespace Checkpoint {
+    /**
+     * Magic bytes at the beginning of each checkpoint.
+     */
+    constexpr char magic[8] = {'M', 'O', 'L', 'S', 'I', 'M', 'C', 'P'};
+
+    /**
+     * Current version of the format. Increase it if the layout changes.
+     */
+    constexpr uint32_t version = 1;
+
+    /**
+     * Size of one particle record in bytes.
+     */
+    constexpr size_t recordSize = 15 * sizeof(double) + sizeof(int32_t);
+
+    /**
+     * @brief Simulation state stored in the header of a checkpoint.
+     */
+    struct Header {
+        uint64_t particleCount = 0;
+        std::array<double, 3> domainSize = {0, 0, 0};
+        enumsStructs::BoundarySet boundaries;
+        double time = 0;
+        int64_t iteration = 0;
+        std::string randomEngineState;
+    };
+
+    /**
+     * @brief Store a value in little endian byte order.
+     *
+     * @param buffer Destination, at least sizeof(T) bytes.
+     * @param value Value to store.
+     */
+    template<typename T>
+    inline void storeLittleEndian(char *buffer, T value) {
+        std::memcpy(buffer, &value, sizeof(T));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        for (size_t i = 0; i < sizeof(T) / 2; i++) {
+            std::swap(buffer[i], buffer[sizeof(T) - 1 - i]);
+        }
+#endif
+    }
+
+    /**
+     * @brief Load a value stored in little endian byte order.
+     *
+     * @param buffer Source, at least sizeof(T) bytes.
+     *
+     * @return Loaded value.
+     */
+    template<typename T>
+    inline T loadLittleEndian(const char *buffer) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, buffer, sizeof(T));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        for (size_t i = 0; i < sizeof(T) / 2; i++) {
+            std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+        }
+#endif
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+}
@@ -5,6 +5,7 @@
 #include "FileHandler.h"
 
 #include "outputWriter/TXTWriter/TxtWriter.h"
+#include "profiling/Tracer.h"
 
 void FileHandler::readFile(ParticleContainer &particles, std::string &filePath, inputFormat format) {
 
@@ -21,7 +22,10 @@ void FileHandler::readFile(ParticleContainer &particles, std::string &filePath,
     }
 }
 
-void FileHandler::writeToFile(ParticleContainer &particles, int iteration, outputFormat format, std::string &baseName) {
+void FileHandler::writeToFile(ParticleContainer &particles, int iteration, outputFormat format, std::string &baseName,
+                              double time) {
+    //Runs on the thread of the AsyncOutputWriter, if the output is written asynchronously
+    TRACE_SPAN("plot");
     switch (format) {
         case outputFormat::xyz: {
             xyzWriter.plotParticles(particles, baseName, iteration);
@@ -35,6 +39,18 @@ void FileHandler::writeToFile(ParticleContainer &particles, int iteration, outpu
             vtkWriter.writeFile(baseName, iteration);
         }
         break;
+        case outputFormat::vtu: {
+            vtuWriter.plotParticles(particles, baseName, iteration);
+        }
+        break;
+        case outputFormat::pvtu: {
+            pvtuWriter.plotParticles(particles, baseName, iteration, time);
+        }
+        break;
+        case outputFormat::traj: {
+            trajectoryWriter.plotParticles(particles, baseName, iteration, time);
+        }
+        break;
         case outputFormat::txt: {
             TxtWriter::writeToFile(particles,baseName);
             break;
@@ -43,3 +59,19 @@ void FileHandler::writeToFile(ParticleContainer &particles, int iteration, outpu
         }
     }
 }
+
+void FileHandler::setVTUOptions(outputWriter::VTUWriter::Precision precision, bool compress, size_t pieces) {
+    vtuWriter.setPrecision(precision);
+    vtuWriter.setCompression(compress);
+    pvtuWriter.setOptions(precision, compress, pieces);
+}
+
+void FileHandler::startNewTrajectory() {
+    trajectoryWriter.startNewTrajectory();
+}
+
+void FileHandler::accountMemory(MemoryFootprint &footprint) const {
+    footprint.add(MemoryCategory::outputBuffers, vtuWriter.getBufferBytes() + pvtuWriter.getBufferBytes() +
+                                                 trajectoryWriter.getBufferBytes());
+    footprint.add(MemoryCategory::vtkTree, vtkWriter.getTreeBytes());
+}
@@ -3,7 +3,10 @@
 //
 
 #pragma once
+#include "fileHandling/outputWriter/PVTUWriter/PVTUWriter.h"
+#include "fileHandling/outputWriter/TrajectoryWriter/TrajectoryWriter.h"
 #include "fileHandling/outputWriter/VTKWriter/VTKWriter.h"
+#include "fileHandling/outputWriter/VTUWriter/VTUWriter.h"
 #include "fileHandling/outputWriter/XYZWriter/XYZWriter.h"
 #include "particleRepresentation/container/ParticleContainer.h"
 #include "fileHandling/reader/TxtReader/TxtReader.h"
@@ -20,6 +23,9 @@ class FileHandler {
 private:
 
     outputWriter::VTKWriter vtkWriter;
+    outputWriter::VTUWriter vtuWriter;
+    outputWriter::PVTUWriter pvtuWriter;
+    outputWriter::TrajectoryWriter trajectoryWriter;
     outputWriter::XYZWriter xyzWriter;
 
 public:
@@ -28,7 +34,7 @@ public:
      *
      * This enum class enables the user to select the desired output format in the writeToFile method.
      */
-    enum class outputFormat { vtk, xyz, xml, txt, invalid };
+    enum class outputFormat { vtk, vtu, pvtu, traj, xyz, xml, txt, invalid };
 
     /**
      * @brief Supported input formats.
@@ -37,6 +43,13 @@ public:
      */
     enum class inputFormat { txt, xml, invalid };
 
+    /**
+     * @brief Supported formats of checkpoints.
+     *
+     * The binary format stores the complete simulation state bit-exactly, the txt format only the particles.
+     */
+    enum class stateFormat { binary, txt, invalid };
+
     /**
      * @brief Read particles from a txt-file.
      *
@@ -55,9 +68,35 @@ public:
      * @param iteration Current iteration step of the simulation.
      * @param format Type of the output file.
      * @param baseName Base name of the output file.
+     * @param time Current simulation time. Only used by formats storing the time (pvtu, traj).
      *
      * Write particles to a file. You can choose between different output formats. The file will be created in the directory,
      * in which this program was executed.
      */
-    void writeToFile(ParticleContainer &particles, int iteration, outputFormat format, std::string& baseName);
+    void writeToFile(ParticleContainer &particles, int iteration, outputFormat format, std::string& baseName,
+                     double time = 0);
+
+    /**
+     * @brief Configure the binary vtu and pvtu output.
+     *
+     * @param precision Precision of the floating point arrays.
+     * @param compress Compress the arrays with zlib.
+     * @param pieces Number of pieces per frame of the pvtu output. If 0, one piece per OpenMP thread is written.
+     *
+     * @throws std::invalid_argument If compression is requested, but MolSim is built without zlib.
+     */
+    void setVTUOptions(outputWriter::VTUWriter::Precision precision, bool compress, size_t pieces = 0);
+
+    /**
+     * @brief Start a new trajectory with the next frame of the traj output, replacing an existing one.
+     */
+    void startNewTrajectory();
+
+    /**
+     * @brief Add the bytes held by the buffers of the output writers and by the object tree of the last vtk file to a
+     *        memory footprint.
+     *
+     * @param footprint Footprint to add to.
+     */
+    void accountMemory(MemoryFootprint &footprint) const;
 };
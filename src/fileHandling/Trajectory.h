@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Binary trajectory format, storing all frames of a simulation in one file.
+ *
+ * Frames are appended to the file one after another. When the writer is closed, an index with the offset of each frame
+ * is appended behind the last frame, followed by a fixed size footer, so a reader can seek to any frame in O(1). If
+ * the footer is missing (e.g. the simulation is still running or was aborted), the index is rebuilt by skipping from
+ * frame header to frame header. All values are stored in little endian byte order (see Checkpoint.h).
+ *
+ * Layout of the file header (version 1):
+ * - magic "MOLSIMTJ" (8 bytes)
+ * - version (uint32)
+ * - reserved (uint32)
+ *
+ * Layout of one frame:
+ * - iteration (int64)
+ * - simulation time (double)
+ * - particle count (uint64)
+ * - one record per particle: x, v, f (9 x double), m (double), type (int32)
+ *
+ * Layout of the index behind the last frame:
+ * - offset of each frame (uint64)
+ * - footer: offset of the index (uint64), number of frames (uint64), magic "MOLSIMIX" (8 bytes)
+ */
+namespace Trajectory {
+    /**
+     * Magic bytes at the beginning of each trajectory.
+     */
+    constexpr char magic[8] = {'M', 'O', 'L', 'S', 'I', 'M', 'T', 'J'};
+
+    /**
+     * Magic bytes at the end of the footer.
+     */
+    constexpr char indexMagic[8] = {'M', 'O', 'L', 'S', 'I', 'M', 'I', 'X'};
+
+    /**
+     * Current version of the format. Increase it if the layout changes.
+     */
+    constexpr uint32_t version = 1;
+
+    /**
+     * Size of the file header in bytes.
+     */
+    constexpr size_t headerSize = sizeof(magic) + 2 * sizeof(uint32_t);
+
+    /**
+     * Size of the header of each frame in bytes.
+     */
+    constexpr size_t frameHeaderSize = sizeof(int64_t) + sizeof(double) + sizeof(uint64_t);
+
+    /**
+     * Size of one particle record in bytes.
+     */
+    constexpr size_t recordSize = 10 * sizeof(double) + sizeof(int32_t);
+
+    /**
+     * Size of the footer in bytes.
+     */
+    constexpr size_t footerSize = 2 * sizeof(uint64_t) + sizeof(indexMagic);
+}
@@ -0,0 +1,117 @@
+#include "AsyncOutputWriter.h"
+
+#include <spdlog/spdlog.h>
+
+namespace outputWriter {
+
+AsyncOutputWriter::AsyncOutputWriter(FileHandler::outputFormat format, size_t capacity)
+    : format{format}, buffers(std::max<size_t>(capacity, 1)), stop{false}, pending{0} {
+  for (auto &buffer : buffers) {
+    freeBuffers.push_back(&buffer);
+  }
+  fileHandler.setVTUOptions(VTUWriter::Precision::float32, false, backgroundPieces);
+  worker = std::thread(&AsyncOutputWriter::writeFrames, this);
+}
+
+AsyncOutputWriter::~AsyncOutputWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  frameQueued.notify_one();
+  worker.join();
+  if (error) {
+    spdlog::error("Writing the output failed");
+  }
+}
+
+void AsyncOutputWriter::submit(ParticleContainer &particles, int iteration, const std::string &baseName,
+                               double time) {
+  DefaultParticleContainer *snapshot;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    //Back-pressure: wait until the writer has finished a frame
+    bufferFreed.wait(lock, [this] { return !freeBuffers.empty() || error; });
+    rethrowError();
+    snapshot = freeBuffers.back();
+    freeBuffers.pop_back();
+  }
+  //The buffer is owned by this thread until it is queued, so the copy does not need the lock
+  snapshot->copyFrom(particles);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back({snapshot, iteration, baseName, time});
+    pending++;
+  }
+  frameQueued.notify_one();
+}
+
+void AsyncOutputWriter::flush() {
+  std::unique_lock<std::mutex> lock(mutex);
+  bufferFreed.wait(lock, [this] { return pending == 0; });
+  rethrowError();
+}
+
+void AsyncOutputWriter::setVTUOptions(VTUWriter::Precision precision, bool compress, size_t pieces) {
+  //The writer thread only touches the file handler while a frame is pending
+  flush();
+  fileHandler.setVTUOptions(precision, compress, pieces == 0 ? backgroundPieces : pieces);
+}
+
+void AsyncOutputWriter::startNewTrajectory() {
+  flush();
+  fileHandler.startNewTrajectory();
+}
+
+void AsyncOutputWriter::accountMemory(MemoryFootprint &footprint) {
+  //Snapshots are only resized by the submitting thread, so their size can be queried without the lock
+  for (auto &buffer : buffers) {
+    MemoryFootprint snapshot;
+    buffer.accountMemory(snapshot);
+    footprint.add(MemoryCategory::outputBuffers, snapshot.total());
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  for (size_t category = 0; category < MemoryFootprint::numberOfCategories; category++) {
+    auto c = static_cast<MemoryCategory>(category);
+    footprint.add(c, fileHandlerFootprint.get(c));
+  }
+}
+
+void AsyncOutputWriter::rethrowError() {
+  if (error) {
+    std::exception_ptr e = error;
+    error = nullptr;
+    std::rethrow_exception(e);
+  }
+}
+
+void AsyncOutputWriter::writeFrames() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    frameQueued.wait(lock, [this] { return stop || !queue.empty(); });
+    if (queue.empty()) {
+      //Only stop after all queued frames have been written
+      return;
+    }
+    Frame frame = queue.front();
+    queue.pop_front();
+    lock.unlock();
+
+    try {
+      fileHandler.writeToFile(*frame.snapshot, frame.iteration, format, frame.baseName, frame.time);
+    } catch (...) {
+      lock.lock();
+      error = std::current_exception();
+      lock.unlock();
+    }
+
+    lock.lock();
+    fileHandlerFootprint = {};
+    fileHandler.accountMemory(fileHandlerFootprint);
+    freeBuffers.push_back(frame.snapshot);
+    pending--;
+    bufferFreed.notify_all();
+  }
+}
+
+} // namespace outputWriter
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fileHandling/FileHandler.h"
+#include "particleRepresentation/container/defaultParticleContainer/DefaultParticleContainer.h"
+
+namespace outputWriter {
+
+/**
+ * @brief Writes output files on a background thread, so the simulation does not wait for the file system.
+ *
+ * Submitting a frame copies the particles into one of a fixed number of reusable snapshot buffers and returns
+ * immediately. A background thread writes the buffered frames in the order they were submitted. If all buffers are
+ * waiting to be written, submitting blocks until the writer has finished one of them (back-pressure), so the memory
+ * used for output is bounded by the number of buffers.
+ *
+ * Errors of the writer thread are rethrown by the next call of submit() or flush().
+ */
+class AsyncOutputWriter {
+public:
+  /**
+   * @brief Start the writer thread.
+   *
+   * @param format Format of the output files.
+   * @param capacity Number of snapshot buffers (at least 1). Two buffers allow writing one frame while the next one
+   *                 is taken.
+   */
+  AsyncOutputWriter(FileHandler::outputFormat format, size_t capacity = 2);
+
+  /**
+   * @brief Write all remaining frames and stop the writer thread.
+   */
+  ~AsyncOutputWriter();
+
+  AsyncOutputWriter(const AsyncOutputWriter &) = delete;
+
+  AsyncOutputWriter &operator=(const AsyncOutputWriter &) = delete;
+
+  /**
+   * @brief Take a snapshot of all particles and queue it for writing.
+   *
+   * @param particles Particles to write.
+   * @param iteration Current iteration, used to generate a unique file name.
+   * @param baseName Base name of the output file.
+   * @param time Current simulation time.
+   *
+   * Blocks, if all snapshot buffers are in use.
+   */
+  void submit(ParticleContainer &particles, int iteration, const std::string &baseName, double time = 0);
+
+  /**
+   * @brief Wait until all submitted frames have been written.
+   */
+  void flush();
+
+  /**
+   * @brief Configure the binary vtu and pvtu output. Waits until all submitted frames have been written.
+   *
+   * @param precision Precision of the floating point arrays.
+   * @param compress Compress the arrays with zlib.
+   * @param pieces Number of pieces per frame of the pvtu output. If 0, backgroundPieces pieces are written.
+   */
+  void setVTUOptions(VTUWriter::Precision precision, bool compress, size_t pieces = 0);
+
+  /**
+   * @brief Start a new trajectory with the next frame of the traj output, replacing an existing one. Waits until all
+   *        submitted frames have been written.
+   */
+  void startNewTrajectory();
+
+  /**
+   * Default number of pieces per frame of the pvtu output. The pieces are written by a team of their own, so a small
+   * number keeps the writer from competing with the force calculation for all cores.
+   */
+  static constexpr size_t backgroundPieces = 2;
+
+  /**
+   * @brief Add the bytes of the snapshot buffers and of the file handler, as of the last frame written, to a memory
+   *        footprint. Must be called from the thread submitting the frames.
+   *
+   * @param footprint Footprint to add to.
+   */
+  void accountMemory(MemoryFootprint &footprint);
+
+private:
+  /**
+   * @brief Frame waiting to be written.
+   */
+  struct Frame {
+    DefaultParticleContainer *snapshot;
+    int iteration;
+    std::string baseName;
+    double time;
+  };
+
+  /**
+   * @brief Main loop of the writer thread.
+   */
+  void writeFrames();
+
+  /**
+   * @brief Rethrow an error of the writer thread, if one occurred. The mutex has to be held.
+   */
+  void rethrowError();
+
+  FileHandler fileHandler;
+  FileHandler::outputFormat format;
+
+  /**
+   * Snapshot buffers. Each buffer is either free or part of a queued or currently written frame.
+   */
+  std::vector<DefaultParticleContainer> buffers;
+  std::vector<DefaultParticleContainer *> freeBuffers;
+  std::deque<Frame> queue;
+
+  std::mutex mutex;
+  //Signalled when a frame is queued or the writer has to stop
+  std::condition_variable frameQueued;
+  //Signalled when a buffer becomes free
+  std::condition_variable bufferFreed;
+  bool stop;
+  //Number of frames queued or currently written
+  size_t pending;
+  std::exception_ptr error;
+  //Footprint of the file handler after the last frame, the writer thread must not be interrupted to measure it
+  MemoryFootprint fileHandlerFootprint;
+
+  std::thread worker;
+};
+
+} // namespace outputWriter
@@ -0,0 +1,65 @@
+#include "CheckpointWriter.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+void CheckpointWriter::writeToFile(ParticleContainer &particles, const Checkpoint::Header &header,
+                                   const std::string &filename) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open checkpoint file " + filename);
+    }
+
+    //Header
+    auto write = [&file](auto value) {
+        char bytes[sizeof(value)];
+        Checkpoint::storeLittleEndian(bytes, value);
+        file.write(bytes, sizeof(value));
+    };
+    file.write(Checkpoint::magic, sizeof(Checkpoint::magic));
+    write(Checkpoint::version);
+    write(static_cast<uint64_t>(particles.size()));
+    for (double d: header.domainSize) {
+        write(d);
+    }
+    for (auto condition: {header.boundaries.front, header.boundaries.right, header.boundaries.back,
+                          header.boundaries.left, header.boundaries.top, header.boundaries.bottom}) {
+        write(static_cast<int32_t>(condition));
+    }
+    write(header.time);
+    write(header.iteration);
+    write(static_cast<uint32_t>(header.randomEngineState.size()));
+    file.write(header.randomEngineState.data(), static_cast<std::streamsize>(header.randomEngineState.size()));
+
+    //Particle records, written in chunks to keep the number of write calls low
+    constexpr size_t recordsPerChunk = 4096;
+    std::vector<char> buffer(recordsPerChunk * Checkpoint::recordSize);
+    size_t records = 0;
+    particles.applyToEachParticle([&](Particle &p) {
+        char *record = buffer.data() + records * Checkpoint::recordSize;
+        for (const auto *vector: {&p.getX(), &p.getV(), &p.getF(), &p.getOldF()}) {
+            for (double value: *vector) {
+                Checkpoint::storeLittleEndian(record, value);
+                record += sizeof(double);
+            }
+        }
+        for (double value: {p.getM(), p.getEpsilon(), p.getSigma()}) {
+            Checkpoint::storeLittleEndian(record, value);
+            record += sizeof(double);
+        }
+        Checkpoint::storeLittleEndian(record, static_cast<int32_t>(p.getType()));
+        if (++records == recordsPerChunk) {
+            file.write(buffer.data(), static_cast<std::streamsize>(records * Checkpoint::recordSize));
+            records = 0;
+        }
+    });
+    file.write(buffer.data(), static_cast<std::streamsize>(records * Checkpoint::recordSize));
+
+    if (!file) {
+        throw std::runtime_error("Error while writing checkpoint file " + filename);
+    }
+    spdlog::info("Wrote checkpoint with {} particles to {}", particles.size(), filename);
+}
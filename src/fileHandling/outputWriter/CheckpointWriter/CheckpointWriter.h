@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+
+#include "fileHandling/Checkpoint.h"
+#include "particleRepresentation/container/ParticleContainer.h"
+
+/**
+ * @brief Writes the state of a simulation to a binary checkpoint (see Checkpoint.h).
+ */
+class CheckpointWriter {
+public:
+    /**
+     * @brief Write all particles of a container together with the given header to a binary checkpoint.
+     *
+     * @param particles Particles to store.
+     * @param header Simulation state to store. The particle count is taken from the container.
+     * @param filename Name of the checkpoint file.
+     *
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    static void writeToFile(ParticleContainer &particles, const Checkpoint::Header &header, const std::string &filename);
+};
@@ -0,0 +1,178 @@
+#include "PVTUWriter.h"
+
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <omp.h>
+#include <sstream>
+#include <stdexcept>
+
+#include "profiling/Tracer.h"
+
+namespace outputWriter {
+
+namespace {
+  const char *byteOrder() {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return "BigEndian";
+#else
+    return "LittleEndian";
+#endif
+  }
+
+  //File names inside the .pvtu and .pvd files are relative to the directory of these files
+  std::string relativeName(const std::string &path) { return std::filesystem::path(path).filename().string(); }
+} // namespace
+
+PVTUWriter::PVTUWriter(size_t pieces) {
+  setOptions(VTUWriter::Precision::float32, false, pieces);
+}
+
+void PVTUWriter::setOptions(VTUWriter::Precision precision, bool compress, size_t pieces) {
+  if (pieces == 0) {
+    pieces = static_cast<size_t>(omp_get_max_threads());
+  }
+  writers.resize(pieces);
+  for (auto &writer : writers) {
+    writer.setPrecision(precision);
+    writer.setCompression(compress);
+  }
+}
+
+size_t PVTUWriter::getBufferBytes() const {
+  size_t bytes = writers.capacity() * sizeof(VTUWriter) + order.capacity() * sizeof(Particle *);
+  for (auto &writer : writers) {
+    bytes += writer.getBufferBytes();
+  }
+  return bytes;
+}
+
+void PVTUWriter::plotParticles(ParticleContainer &particles, const std::string &filename, int iteration,
+                               double time) {
+  std::stringstream strstr;
+  strstr << filename << "_" << std::setfill('0') << std::setw(4) << iteration;
+  const std::string frameName = strstr.str();
+
+  order.clear();
+  particles.applyToEachParticle([this](Particle &p) { order.push_back(&p); });
+
+  //Split the particles into contiguous ranges of (almost) equal size
+  const size_t pieces = writers.size();
+  std::vector<std::string> pieceNames(pieces);
+  std::vector<std::exception_ptr> errors(pieces);
+  //The team is bounded by the number of pieces, so writing on the background thread does not take every core
+#pragma omp parallel for num_threads(static_cast<int>(pieces)) schedule(static, 1)
+  for (size_t piece = 0; piece < pieces; piece++) {
+    TRACE_SPAN("pvtu piece");
+    const size_t begin = order.size() * piece / pieces;
+    const size_t end = order.size() * (piece + 1) / pieces;
+    const std::string path = frameName + "_" + std::to_string(piece) + ".vtu";
+    pieceNames[piece] = relativeName(path);
+    try {
+      writers[piece].writeFile(order.data() + begin, end - begin, path);
+    } catch (...) {
+      //Exceptions must not leave the parallel region
+      errors[piece] = std::current_exception();
+    }
+  }
+  for (auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  const std::string masterPath = frameName + ".pvtu";
+  writeMasterFile(masterPath, pieceNames);
+
+  //A new base name starts a new time series
+  if (filename != seriesName) {
+    startCollection(filename + ".pvd", time);
+    seriesName = filename;
+  }
+  appendToCollection(filename + ".pvd", time, relativeName(masterPath));
+}
+
+void PVTUWriter::resetSeries() { seriesName.clear(); }
+
+void PVTUWriter::writeMasterFile(const std::string &path, const std::vector<std::string> &pieceNames) const {
+  const char *floatName = VTUWriter::floatType(writers.front().getPrecision());
+  auto dataArray = [floatName](std::ostream &out, const char *type, const char *name, int components) {
+    out << "      <PDataArray type=\"" << (type ? type : floatName) << "\" Name=\"" << name
+        << "\" NumberOfComponents=\"" << components << "\"/>\n";
+  };
+
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open pvtu file " + path);
+  }
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"" << byteOrder()
+       << "\" header_type=\"UInt64\">\n"
+       << "  <PUnstructuredGrid GhostLevel=\"0\">\n"
+       << "    <PPointData>\n";
+  dataArray(file, nullptr, "mass", 1);
+  dataArray(file, nullptr, "velocity", 3);
+  dataArray(file, nullptr, "force", 3);
+  dataArray(file, "Int32", "type", 1);
+  file << "    </PPointData>\n"
+       << "    <PPoints>\n";
+  dataArray(file, nullptr, "points", 3);
+  file << "    </PPoints>\n";
+  for (const auto &name : pieceNames) {
+    file << "    <Piece Source=\"" << name << "\"/>\n";
+  }
+  file << "  </PUnstructuredGrid>\n"
+       << "</VTKFile>\n";
+}
+
+void PVTUWriter::startCollection(const std::string &path, double time) {
+  //Keep the frames of an earlier run up to the first frame of this one
+  std::vector<std::string> kept;
+  std::ifstream existing(path);
+  const std::string entry = "<DataSet timestep=\"";
+  for (std::string line; std::getline(existing, line);) {
+    const size_t position = line.find(entry);
+    if (position != std::string::npos && std::stod(line.substr(position + entry.size())) < time) {
+      kept.push_back(line);
+    }
+  }
+  existing.close();
+
+  std::ofstream file(path, std::ios::trunc | std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open pvd file " + path);
+  }
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"" << byteOrder() << "\">\n"
+       << "  <Collection>\n";
+  for (const auto &line : kept) {
+    file << line << "\n";
+  }
+  collectionEnd = file.tellp();
+  file << "  </Collection>\n"
+       << "</VTKFile>\n";
+  if (!file) {
+    throw std::runtime_error("Could not write pvd file " + path);
+  }
+}
+
+void PVTUWriter::appendToCollection(const std::string &path, double time, const std::string &name) {
+  //Overwrite the closing tags with the new entry and write them again behind it
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open pvd file " + path);
+  }
+  file.seekp(collectionEnd);
+  file << std::setprecision(std::numeric_limits<double>::max_digits10) << "    <DataSet timestep=\"" << time
+       << "\" group=\"\" part=\"0\" file=\"" << name << "\"/>\n";
+  collectionEnd = file.tellp();
+  file << "  </Collection>\n"
+       << "</VTKFile>\n";
+  if (!file) {
+    throw std::runtime_error("Could not write pvd file " + path);
+  }
+}
+
+} // namespace outputWriter
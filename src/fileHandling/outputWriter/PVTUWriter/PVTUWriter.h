@@ -0,0 +1,116 @@
+#pragma once
+
+#include <ios>
+#include <string>
+#include <vector>
+
+#include "fileHandling/outputWriter/VTUWriter/VTUWriter.h"
+#include "particleRepresentation/container/ParticleContainer.h"
+
+namespace outputWriter {
+
+/**
+ * @brief Writes each frame as several binary .vtu pieces in parallel, together with a .pvtu file per frame and a
+ * .pvd file indexing all frames of the run.
+ *
+ * The particles are split into contiguous ranges in the order the container visits them. For the linked cells
+ * container this order follows the cells, so each piece covers a slab of the domain. The pieces are written
+ * concurrently by OpenMP threads, each with its own VTUWriter, so the buffers of every piece are reused between frames.
+ *
+ * Files written for a base name b:
+ * - b_<iteration>_<piece>.vtu: the particles of one piece
+ * - b_<iteration>.pvtu: the frame, referencing its pieces
+ * - b.pvd: the time series, mapping the simulation time to the frames. Each frame appends its entry in place and
+ *   the closing tags are rewritten behind it, so the file is valid even if the simulation is aborted. If the file
+ *   already exists when a series is started, e.g. because a run is resumed from a checkpoint, the entries before the
+ *   time of the first new frame are kept and the later ones are replaced.
+ *
+ * The pieces are written by a team of as many threads as there are pieces.
+ */
+class PVTUWriter {
+public:
+  /**
+   * @brief Create a new writer.
+   *
+   * @param pieces Number of pieces per frame. If 0, one piece per OpenMP thread is written.
+   */
+  explicit PVTUWriter(size_t pieces = 0);
+
+  /**
+   * @brief Configure the pieces.
+   *
+   * @param precision Precision of the floating point arrays.
+   * @param compress Compress the arrays with zlib.
+   * @param pieces Number of pieces per frame. If 0, one piece per OpenMP thread is written.
+   *
+   * @throws std::invalid_argument If compression is requested, but MolSim is built without zlib.
+   */
+  void setOptions(VTUWriter::Precision precision, bool compress, size_t pieces);
+
+  /**
+   * @brief Write all particles of a container as one frame.
+   *
+   * @param particles Particles to write.
+   * @param filename Base name of the files.
+   * @param iteration Current iteration, used to generate unique file names.
+   * @param time Simulation time of the frame, stored in the .pvd file.
+   */
+  void plotParticles(ParticleContainer &particles, const std::string &filename, int iteration, double time);
+
+  /**
+   * @brief Get the number of pieces written per frame.
+   *
+   * @return Number of pieces.
+   */
+  [[nodiscard]] size_t getNumberOfPieces() const { return writers.size(); }
+
+  /**
+   * @brief Forget the current time series, so that the next frame starts the series from the .pvd file on disk.
+   */
+  void resetSeries();
+
+  /**
+   * @brief Get the number of bytes allocated by the buffers of all pieces.
+   *
+   * @return Allocated bytes.
+   */
+  [[nodiscard]] size_t getBufferBytes() const;
+
+private:
+  //One writer per piece
+  std::vector<VTUWriter> writers;
+
+  //Pointers to all particles of the current frame, in the order of the container
+  std::vector<Particle *> order;
+
+  //Base name of the current time series and the position of the closing tags in its .pvd file
+  std::string seriesName;
+  std::streamoff collectionEnd = 0;
+
+  /**
+   * @brief Write the .pvtu file of a frame.
+   *
+   * @param path Name of the .pvtu file.
+   * @param pieceNames Names of the pieces, relative to the .pvtu file.
+   */
+  void writeMasterFile(const std::string &path, const std::vector<std::string> &pieceNames) const;
+
+  /**
+   * @brief Start the .pvd file of a time series. Entries of an existing file before the given time are kept.
+   *
+   * @param path Name of the .pvd file.
+   * @param time Simulation time of the first frame of the series.
+   */
+  void startCollection(const std::string &path, double time);
+
+  /**
+   * @brief Append the entry of a frame to the .pvd file of the current time series.
+   *
+   * @param path Name of the .pvd file.
+   * @param time Simulation time of the frame.
+   * @param name Name of the .pvtu file of the frame, relative to the .pvd file.
+   */
+  void appendToCollection(const std::string &path, double time, const std::string &name);
+};
+
+} // namespace outputWriter
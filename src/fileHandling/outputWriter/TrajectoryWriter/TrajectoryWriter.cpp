@@ -0,0 +1,140 @@
+#include "TrajectoryWriter.h"
+
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+#include "fileHandling/Checkpoint.h"
+#include "fileHandling/reader/TrajectoryReader/TrajectoryReader.h"
+
+using Checkpoint::storeLittleEndian;
+
+namespace outputWriter {
+
+TrajectoryWriter::~TrajectoryWriter() {
+  try {
+    close();
+  } catch (const std::exception &e) {
+    spdlog::error("Could not write the index of trajectory {}: {}", path, e.what());
+  }
+}
+
+void TrajectoryWriter::open(const std::string &filename, int iteration) {
+  path = filename;
+  offsets.clear();
+  endOfFrames = Trajectory::headerSize;
+
+  //Continue an existing trajectory with the frames before the first new one
+  const bool continueTrajectory = !replace && std::filesystem::exists(path);
+  replace = false;
+  if (continueTrajectory) {
+    if (!TrajectoryReader::isTrajectory(path)) {
+      throw std::runtime_error("Could not continue " + path + ", the file is no trajectory");
+    }
+    size_t frames;
+    {
+      TrajectoryReader reader(path);
+      frames = reader.getNumberOfFrames();
+      offsets = reader.getFrameOffsets();
+      endOfFrames = reader.getEndOfFrames();
+      size_t kept = 0;
+      while (kept < frames && reader.getIteration(kept) < iteration) {
+        kept++;
+      }
+      if (kept < frames) {
+        endOfFrames = offsets[kept];
+        offsets.resize(kept);
+      }
+    }
+    if (offsets.size() < frames) {
+      spdlog::warn("Dropping {} frames of trajectory {} from iteration {} on", frames - offsets.size(), path,
+                   iteration);
+    }
+    //Drop the old index and the dropped frames, the index is rewritten when the file is closed
+    std::filesystem::resize_file(path, endOfFrames);
+    spdlog::info("Appending to trajectory {} with {} frames", path, offsets.size());
+  } else {
+    std::ofstream create(path, std::ios::binary | std::ios::trunc);
+    char header[Trajectory::headerSize];
+    std::memcpy(header, Trajectory::magic, sizeof(Trajectory::magic));
+    storeLittleEndian(header + sizeof(Trajectory::magic), Trajectory::version);
+    storeLittleEndian(header + sizeof(Trajectory::magic) + sizeof(uint32_t), static_cast<uint32_t>(0));
+    create.write(header, sizeof(header));
+    if (!create) {
+      throw std::runtime_error("Could not create trajectory " + path);
+    }
+  }
+
+  file.open(path, std::ios::binary | std::ios::in | std::ios::out);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open trajectory " + path);
+  }
+}
+
+void TrajectoryWriter::plotParticles(ParticleContainer &particles, const std::string &filename, int iteration,
+                                     double time) {
+  const std::string name = filename + ".traj";
+  if (name != path || !file.is_open()) {
+    close();
+    open(name, iteration);
+  }
+
+  //Encode the whole frame, so it is written with a single call
+  buffer.resize(Trajectory::frameHeaderSize + particles.size() * Trajectory::recordSize);
+  char *position = buffer.data();
+  storeLittleEndian(position, static_cast<int64_t>(iteration));
+  storeLittleEndian(position + sizeof(int64_t), time);
+  storeLittleEndian(position + sizeof(int64_t) + sizeof(double), static_cast<uint64_t>(particles.size()));
+  position += Trajectory::frameHeaderSize;
+  particles.applyToEachParticle([&position](Particle &p) {
+    for (const auto *vector : {&p.getX(), &p.getV(), &p.getF()}) {
+      for (double value : *vector) {
+        storeLittleEndian(position, value);
+        position += sizeof(double);
+      }
+    }
+    storeLittleEndian(position, p.getM());
+    position += sizeof(double);
+    storeLittleEndian(position, static_cast<int32_t>(p.getType()));
+    position += sizeof(int32_t);
+  });
+
+  file.seekp(static_cast<std::streamoff>(endOfFrames));
+  file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  if (!file) {
+    throw std::runtime_error("Error while writing trajectory " + path);
+  }
+  offsets.push_back(endOfFrames);
+  endOfFrames += buffer.size();
+}
+
+void TrajectoryWriter::startNewTrajectory() {
+  close();
+  replace = true;
+}
+
+void TrajectoryWriter::close() {
+  if (!file.is_open()) {
+    return;
+  }
+  buffer.resize(offsets.size() * sizeof(uint64_t) + Trajectory::footerSize);
+  char *position = buffer.data();
+  for (uint64_t offset : offsets) {
+    storeLittleEndian(position, offset);
+    position += sizeof(uint64_t);
+  }
+  storeLittleEndian(position, endOfFrames);
+  storeLittleEndian(position + sizeof(uint64_t), static_cast<uint64_t>(offsets.size()));
+  std::memcpy(position + 2 * sizeof(uint64_t), Trajectory::indexMagic, sizeof(Trajectory::indexMagic));
+
+  file.seekp(static_cast<std::streamoff>(endOfFrames));
+  file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  file.close();
+  if (!file) {
+    throw std::runtime_error("Error while writing the index of trajectory " + path);
+  }
+}
+
+} // namespace outputWriter
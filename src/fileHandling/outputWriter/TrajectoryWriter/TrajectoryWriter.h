@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "fileHandling/Trajectory.h"
+#include "particleRepresentation/container/ParticleContainer.h"
+
+namespace outputWriter {
+
+/**
+ * @brief Appends all frames of a simulation to a single trajectory file (see Trajectory.h) instead of writing one file
+ * per frame.
+ *
+ * The file stays open between frames. The frame index is written when the writer is closed or destroyed. If the
+ * trajectory already exists, the frames before the iteration of the first new frame are kept and the new frames are
+ * written in place of all later ones, e.g. when a simulation is resumed from a checkpoint and plots its start iteration
+ * again. An existing trajectory is only replaced as a whole after startNewTrajectory().
+ */
+class TrajectoryWriter {
+public:
+  TrajectoryWriter() = default;
+
+  /**
+   * @brief Write the frame index and close the file.
+   */
+  ~TrajectoryWriter();
+
+  TrajectoryWriter(const TrajectoryWriter &) = delete;
+
+  TrajectoryWriter &operator=(const TrajectoryWriter &) = delete;
+
+  /**
+   * @brief Append all particles of a container as one frame.
+   *
+   * @param particles Particles to write.
+   * @param filename Base name of the trajectory (<filename>.traj).
+   * @param iteration Current iteration.
+   * @param time Current simulation time.
+   *
+   * @throws std::runtime_error If the trajectory cannot be written.
+   */
+  void plotParticles(ParticleContainer &particles, const std::string &filename, int iteration, double time);
+
+  /**
+   * @brief Write the frame index and close the file. Further frames reopen the file and are appended.
+   */
+  void close();
+
+  /**
+   * @brief Close the trajectory. The next frame starts a new trajectory, replacing an existing file of the same name.
+   */
+  void startNewTrajectory();
+
+  /**
+   * @brief Get the number of bytes allocated by the frame buffer and the frame index.
+   *
+   * @return Allocated bytes.
+   */
+  [[nodiscard]] size_t getBufferBytes() const { return buffer.capacity() + offsets.capacity() * sizeof(uint64_t); }
+
+private:
+  std::fstream file;
+  //Name of the open trajectory
+  std::string path;
+  //Offsets of all frames of the open trajectory
+  std::vector<uint64_t> offsets;
+  //Position behind the last frame
+  uint64_t endOfFrames = 0;
+
+  //Replace an existing trajectory on the next open
+  bool replace = false;
+
+  //Encoded frame, kept between frames to avoid allocations
+  std::vector<char> buffer;
+
+  /**
+   * @brief Open a trajectory for appending or create a new one.
+   *
+   * @param filename Name of the trajectory.
+   * @param iteration Iteration of the first frame to write. Existing frames of this or a later iteration are dropped.
+   *
+   * @throws std::runtime_error If the file exists, but is no trajectory, or cannot be opened.
+   */
+  void open(const std::string &filename, int iteration);
+};
+
+} // namespace outputWriter
@@ -50,6 +50,15 @@ void VTKWriter::writeFile(const std::string &filename, int iteration) {
   std::stringstream strstr;
   strstr << filename << "_" << std::setfill('0') << std::setw(4) << iteration << ".vtu";
 
+  treeBytes = sizeof(VTKFile_t);
+  auto &piece = vtkFile->UnstructuredGrid()->Piece();
+  for (auto &dataArray : piece.PointData().DataArray()) {
+    treeBytes += sizeof(DataArray_t) + dataArray.capacity() * sizeof(::xml_schema::decimal);
+  }
+  for (auto &dataArray : piece.Points().DataArray()) {
+    treeBytes += sizeof(DataArray_t) + dataArray.capacity() * sizeof(::xml_schema::decimal);
+  }
+
   std::ofstream file(strstr.str().c_str());
   VTKFile(file, *vtkFile);
   delete vtkFile;
@@ -48,8 +48,16 @@ public:
    */
   void writeFile(const std::string &filename, int iteration);
 
+  /**
+   * Get the number of bytes held by the data arrays of the object tree of the last file. The tree is released after
+   * writing, but has to be built again for the next file.
+   */
+  [[nodiscard]] size_t getTreeBytes() const { return treeBytes; }
+
 private:
   VTKFile_t *vtkFile;
+
+  size_t treeBytes = 0;
 };
 
 } // namespace outputWriter
@@ -0,0 +1,212 @@
+#include "VTUWriter.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef MOLSIM_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace outputWriter {
+
+namespace {
+  //Uncompressed size of one compressed block
+  constexpr size_t blockSize = 1 << 16;
+
+  template <typename T> void append(std::vector<char> &buffer, T value) {
+    size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+  }
+
+  template <typename Float> void appendVector(std::vector<char> &buffer, const std::array<double, 3> &vector) {
+    for (double value : vector) {
+      append(buffer, static_cast<Float>(value));
+    }
+  }
+
+  template <typename Float>
+  void gather(const Particle &p, std::vector<char> &mass, std::vector<char> &velocity, std::vector<char> &force,
+              std::vector<char> &type, std::vector<char> &points) {
+    append(mass, static_cast<Float>(p.getM()));
+    appendVector<Float>(velocity, p.getV());
+    appendVector<Float>(force, p.getOldF());
+    append(type, static_cast<int32_t>(p.getType()));
+    appendVector<Float>(points, p.getX());
+  }
+
+  void writeDataArray(std::ostream &out, const char *type, const char *name, int components, size_t offset) {
+    out << "        <DataArray type=\"" << type << "\" Name=\"" << name << "\" NumberOfComponents=\"" << components
+        << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+  }
+} // namespace
+
+VTUWriter::VTUWriter(Precision precision, bool compress) : precision{precision}, compress{false} {
+  setCompression(compress);
+}
+
+void VTUWriter::setPrecision(Precision precision) { this->precision = precision; }
+
+void VTUWriter::setCompression(bool compress) {
+  if (compress && !isCompressionAvailable()) {
+    throw std::invalid_argument("Compression of vtu files is not available, MolSim was built without zlib");
+  }
+  this->compress = compress;
+}
+
+bool VTUWriter::isCompressionAvailable() {
+#ifdef MOLSIM_WITH_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+size_t VTUWriter::getBufferBytes() const {
+  return mass.capacity() + velocity.capacity() + force.capacity() + type.capacity() + points.capacity() +
+         appendedData.capacity();
+}
+
+size_t VTUWriter::encode(const std::vector<char> &raw) {
+  size_t offset = appendedData.size();
+  if (!compress) {
+    append(appendedData, static_cast<uint64_t>(raw.size()));
+    appendedData.insert(appendedData.end(), raw.begin(), raw.end());
+    return offset;
+  }
+#ifdef MOLSIM_WITH_ZLIB
+  //Header of the vtkZLibDataCompressor: number of blocks, block size, size of the last partial block and the
+  //compressed size of each block
+  const size_t blocks = (raw.size() + blockSize - 1) / blockSize;
+  append(appendedData, static_cast<uint64_t>(blocks));
+  append(appendedData, static_cast<uint64_t>(blockSize));
+  append(appendedData, static_cast<uint64_t>(raw.size() % blockSize));
+  const size_t sizes = appendedData.size();
+  appendedData.resize(sizes + blocks * sizeof(uint64_t));
+  for (size_t b = 0; b < blocks; b++) {
+    const size_t begin = b * blockSize;
+    const size_t length = std::min(blockSize, raw.size() - begin);
+    uLongf compressedLength = compressBound(static_cast<uLong>(length));
+    const size_t position = appendedData.size();
+    appendedData.resize(position + compressedLength);
+    if (compress2(reinterpret_cast<Bytef *>(appendedData.data() + position), &compressedLength,
+                  reinterpret_cast<const Bytef *>(raw.data() + begin), static_cast<uLong>(length),
+                  Z_DEFAULT_COMPRESSION) != Z_OK) {
+      throw std::runtime_error("Compression of vtu data failed");
+    }
+    appendedData.resize(position + compressedLength);
+    auto size = static_cast<uint64_t>(compressedLength);
+    std::memcpy(appendedData.data() + sizes + b * sizeof(uint64_t), &size, sizeof(uint64_t));
+  }
+#endif
+  return offset;
+}
+
+void VTUWriter::plotParticles(ParticleContainer &particles, const std::string &filename, int iteration) {
+  std::stringstream strstr;
+  strstr << filename << "_" << std::setfill('0') << std::setw(4) << iteration << ".vtu";
+  writeFile(particles, strstr.str());
+}
+
+const char *VTUWriter::floatType(Precision precision) {
+  return precision == Precision::float64 ? "Float64" : "Float32";
+}
+
+void VTUWriter::clearBuffers() {
+  for (auto *buffer : {&mass, &velocity, &force, &type, &points}) {
+    buffer->clear();
+  }
+}
+
+void VTUWriter::writeFile(ParticleContainer &particles, const std::string &path) {
+  //Gather all arrays in a single pass over the particles
+  clearBuffers();
+  if (precision == Precision::float64) {
+    particles.applyToEachParticle([this](Particle &p) { gather<double>(p, mass, velocity, force, type, points); });
+  } else {
+    particles.applyToEachParticle([this](Particle &p) { gather<float>(p, mass, velocity, force, type, points); });
+  }
+  writeBuffers(particles.size(), path);
+}
+
+void VTUWriter::writeFile(Particle *const *particles, size_t count, const std::string &path) {
+  clearBuffers();
+  if (precision == Precision::float64) {
+    for (size_t i = 0; i < count; i++) {
+      gather<double>(*particles[i], mass, velocity, force, type, points);
+    }
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      gather<float>(*particles[i], mass, velocity, force, type, points);
+    }
+  }
+  writeBuffers(count, path);
+}
+
+void VTUWriter::writeBuffers(size_t numberOfParticles, const std::string &path) {
+  appendedData.clear();
+  const size_t massOffset = encode(mass);
+  const size_t velocityOffset = encode(velocity);
+  const size_t forceOffset = encode(force);
+  const size_t typeOffset = encode(type);
+  const size_t pointsOffset = encode(points);
+  //We don't have cells, but ParaView expects the arrays to be present
+  const std::vector<char> empty;
+  const size_t connectivityOffset = encode(empty);
+  const size_t offsetsOffset = encode(empty);
+  const size_t typesOffset = encode(empty);
+
+  const char *floatName = floatType(precision);
+  std::ostringstream header;
+  header << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+         << "BigEndian"
+#else
+         << "LittleEndian"
+#endif
+         << "\" header_type=\"UInt64\"";
+  if (compress) {
+    header << " compressor=\"vtkZLibDataCompressor\"";
+  }
+  header << ">\n"
+         << "  <UnstructuredGrid>\n"
+         << "    <Piece NumberOfPoints=\"" << numberOfParticles << "\" NumberOfCells=\"0\">\n"
+         << "      <PointData>\n";
+  writeDataArray(header, floatName, "mass", 1, massOffset);
+  writeDataArray(header, floatName, "velocity", 3, velocityOffset);
+  writeDataArray(header, floatName, "force", 3, forceOffset);
+  writeDataArray(header, "Int32", "type", 1, typeOffset);
+  header << "      </PointData>\n"
+         << "      <CellData/>\n"
+         << "      <Points>\n";
+  writeDataArray(header, floatName, "points", 3, pointsOffset);
+  header << "      </Points>\n"
+         << "      <Cells>\n";
+  writeDataArray(header, "Int64", "connectivity", 1, connectivityOffset);
+  writeDataArray(header, "Int64", "offsets", 1, offsetsOffset);
+  writeDataArray(header, "UInt8", "types", 1, typesOffset);
+  header << "      </Cells>\n"
+         << "    </Piece>\n"
+         << "  </UnstructuredGrid>\n"
+         << "  <AppendedData encoding=\"raw\">\n"
+         << "   _";
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("Could not open vtu file " + path);
+  }
+  const std::string headerString = header.str();
+  file.write(headerString.data(), static_cast<std::streamsize>(headerString.size()));
+  file.write(appendedData.data(), static_cast<std::streamsize>(appendedData.size()));
+  file << "\n  </AppendedData>\n</VTKFile>\n";
+  if (!file) {
+    throw std::runtime_error("Error while writing vtu file " + path);
+  }
+}
+
+} // namespace outputWriter
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "particleRepresentation/container/ParticleContainer.h"
+
+namespace outputWriter {
+
+/**
+ * @brief Writes particles to VTK unstructured grid files (.vtu) with raw binary appended data.
+ *
+ * In contrast to the VTKWriter no XML object tree is built. The particle attributes are gathered into flat buffers in
+ * a single pass over the particles and written to the file as one binary block, optionally compressed with zlib. The
+ * file contains the same arrays as the files of the VTKWriter (mass, velocity, force, type and points) and can be
+ * read by ParaView directly.
+ *
+ * All buffers are kept between calls, so writing frames of constant size does not allocate.
+ */
+class VTUWriter {
+public:
+  /**
+   * @brief Precision of the floating point arrays in the file.
+   */
+  enum class Precision { float32, float64 };
+
+  /**
+   * @brief Create a new writer.
+   *
+   * @param precision Precision of the floating point arrays.
+   * @param compress Compress the arrays with zlib. Only available, if MolSim is built with zlib.
+   */
+  explicit VTUWriter(Precision precision = Precision::float32, bool compress = false);
+
+  /**
+   * @brief Set the precision of the floating point arrays.
+   *
+   * @param precision Precision of the floating point arrays.
+   */
+  void setPrecision(Precision precision);
+
+  /**
+   * @brief Enable or disable the compression of the arrays.
+   *
+   * @param compress Compress the arrays with zlib.
+   *
+   * @throws std::invalid_argument If compression is requested, but MolSim is built without zlib.
+   */
+  void setCompression(bool compress);
+
+  /**
+   * @brief Write all particles of a container to a file.
+   *
+   * @param particles Particles to write.
+   * @param filename Base name of the file.
+   * @param iteration Current iteration, used to generate a unique file name (<filename>_<iteration>.vtu).
+   */
+  void plotParticles(ParticleContainer &particles, const std::string &filename, int iteration);
+
+  /**
+   * @brief Write all particles of a container to a file with the given name.
+   *
+   * @param particles Particles to write.
+   * @param path Name of the file.
+   */
+  void writeFile(ParticleContainer &particles, const std::string &path);
+
+  /**
+   * @brief Write a range of particles to a file with the given name.
+   *
+   * @param particles Pointers to the particles to write.
+   * @param count Number of particles.
+   * @param path Name of the file.
+   */
+  void writeFile(Particle *const *particles, size_t count, const std::string &path);
+
+  /**
+   * @brief Get the precision of the floating point arrays.
+   *
+   * @return Precision of the floating point arrays.
+   */
+  [[nodiscard]] Precision getPrecision() const { return precision; }
+
+  /**
+   * @brief Check, if the arrays are compressed.
+   *
+   * @return True, if the arrays are compressed with zlib.
+   */
+  [[nodiscard]] bool isCompressed() const { return compress; }
+
+  /**
+   * @brief Get the name of the VTK data type of the floating point arrays.
+   *
+   * @param precision Precision of the floating point arrays.
+   *
+   * @return "Float32" or "Float64".
+   */
+  static const char *floatType(Precision precision);
+
+  /**
+   * @brief Check, if this build of MolSim supports zlib compression.
+   *
+   * @return True, if zlib is available.
+   */
+  static bool isCompressionAvailable();
+
+  /**
+   * @brief Get the number of bytes allocated by the buffers kept between files.
+   *
+   * @return Allocated bytes.
+   */
+  [[nodiscard]] size_t getBufferBytes() const;
+
+private:
+  Precision precision;
+  bool compress;
+
+  //Raw (uncompressed) content of each array, in the order mass, velocity, force, type, points
+  std::vector<char> mass;
+  std::vector<char> velocity;
+  std::vector<char> force;
+  std::vector<char> type;
+  std::vector<char> points;
+
+  //Encoded arrays (size header followed by the raw or compressed data), concatenated in the order above
+  std::vector<char> appendedData;
+
+  /**
+   * @brief Append one array to appendedData.
+   *
+   * @param raw Uncompressed content of the array.
+   *
+   * @return Offset of the encoded array in appendedData.
+   */
+  size_t encode(const std::vector<char> &raw);
+
+  /**
+   * @brief Clear the array buffers before gathering the particles of a new file.
+   */
+  void clearBuffers();
+
+  /**
+   * @brief Encode the gathered arrays and write them to a file.
+   *
+   * @param numberOfParticles Number of gathered particles.
+   * @param path Name of the file.
+   */
+  void writeBuffers(size_t numberOfParticles, const std::string &path);
+};
+
+} // namespace outputWriter
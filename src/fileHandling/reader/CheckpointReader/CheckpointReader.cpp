@@ -0,0 +1,92 @@
+#include "CheckpointReader.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace {
+    template<typename T>
+    T readValue(std::ifstream &file) {
+        char bytes[sizeof(T)];
+        if (!file.read(bytes, sizeof(T))) {
+            throw std::runtime_error("Checkpoint file is truncated");
+        }
+        return Checkpoint::loadLittleEndian<T>(bytes);
+    }
+}
+
+bool CheckpointReader::isCheckpoint(const std::string &filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(Checkpoint::magic)];
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, Checkpoint::magic, sizeof(magic)) == 0;
+}
+
+Checkpoint::Header CheckpointReader::readFile(ParticleContainer &particles, const std::string &filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open checkpoint file " + filename);
+    }
+
+    //Header
+    char magic[sizeof(Checkpoint::magic)];
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, Checkpoint::magic, sizeof(magic)) != 0) {
+        throw std::runtime_error(filename + " is no checkpoint file");
+    }
+    auto version = readValue<uint32_t>(file);
+    if (version != Checkpoint::version) {
+        throw std::runtime_error("Unsupported checkpoint version " + std::to_string(version));
+    }
+    Checkpoint::Header header;
+    header.particleCount = readValue<uint64_t>(file);
+    for (double &d: header.domainSize) {
+        d = readValue<double>(file);
+    }
+    for (auto *condition: {&header.boundaries.front, &header.boundaries.right, &header.boundaries.back,
+                           &header.boundaries.left, &header.boundaries.top, &header.boundaries.bottom}) {
+        *condition = static_cast<enumsStructs::BoundaryCondition>(readValue<int32_t>(file));
+    }
+    header.time = readValue<double>(file);
+    header.iteration = readValue<int64_t>(file);
+    header.randomEngineState.resize(readValue<uint32_t>(file));
+    if (!file.read(&header.randomEngineState[0], static_cast<std::streamsize>(header.randomEngineState.size()))) {
+        throw std::runtime_error("Checkpoint file is truncated");
+    }
+
+    //Particle records, read in chunks
+    constexpr size_t recordsPerChunk = 4096;
+    std::vector<char> buffer(recordsPerChunk * Checkpoint::recordSize);
+    uint64_t remaining = header.particleCount;
+    while (remaining > 0) {
+        size_t records = static_cast<size_t>(std::min<uint64_t>(remaining, recordsPerChunk));
+        if (!file.read(buffer.data(), static_cast<std::streamsize>(records * Checkpoint::recordSize))) {
+            throw std::runtime_error("Checkpoint file is truncated");
+        }
+        for (size_t r = 0; r < records; r++) {
+            const char *record = buffer.data() + r * Checkpoint::recordSize;
+            auto next = [&record]() {
+                double value = Checkpoint::loadLittleEndian<double>(record);
+                record += sizeof(double);
+                return value;
+            };
+            std::array<std::array<double, 3>, 4> vectors{};
+            for (auto &vector: vectors) {
+                for (double &value: vector) {
+                    value = next();
+                }
+            }
+            double m = next();
+            double epsilon = next();
+            double sigma = next();
+            int type = Checkpoint::loadLittleEndian<int32_t>(record);
+            Particle p{vectors[0], vectors[1], m, type, epsilon, sigma};
+            p.setF(vectors[2]);
+            p.setOldF(vectors[3]);
+            particles.add(p);
+        }
+        remaining -= records;
+    }
+    spdlog::info("Read checkpoint with {} particles from {}", header.particleCount, filename);
+    return header;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+#include "fileHandling/Checkpoint.h"
+#include "particleRepresentation/container/ParticleContainer.h"
+
+/**
+ * @brief Reads binary checkpoints (see Checkpoint.h).
+ */
+class CheckpointReader {
+public:
+    /**
+     * @brief Check, if a file is a binary checkpoint.
+     *
+     * @param filename Name of the file.
+     *
+     * @return True, if the file starts with the magic bytes of a checkpoint.
+     */
+    static bool isCheckpoint(const std::string &filename);
+
+    /**
+     * @brief Read a binary checkpoint and add all stored particles to the container.
+     *
+     * @param particles Container the particles are added to. The particles keep their position, velocity, forces and type.
+     * @param filename Name of the checkpoint file.
+     *
+     * @return Simulation state stored in the header of the checkpoint.
+     *
+     * @throws std::runtime_error If the file cannot be read, is no checkpoint, has an unsupported version or is truncated.
+     */
+    static Checkpoint::Header readFile(ParticleContainer &particles, const std::string &filename);
+};
@@ -0,0 +1,142 @@
+#include "TrajectoryReader.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "fileHandling/Checkpoint.h"
+
+using Checkpoint::loadLittleEndian;
+
+TrajectoryReader::TrajectoryReader(const std::string &filename) : data{nullptr}, size{0}, endOfFrames{0} {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open trajectory " + filename);
+    }
+    struct stat status{};
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        throw std::runtime_error("Could not open trajectory " + filename);
+    }
+    size = static_cast<size_t>(status.st_size);
+    if (size < Trajectory::headerSize) {
+        close(fd);
+        throw std::runtime_error(filename + " is no trajectory");
+    }
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    //The mapping stays valid after closing the file descriptor
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Could not map trajectory " + filename);
+    }
+    data = static_cast<const char *>(mapping);
+
+    if (std::memcmp(data, Trajectory::magic, sizeof(Trajectory::magic)) != 0) {
+        munmap(const_cast<char *>(data), size);
+        throw std::runtime_error(filename + " is no trajectory");
+    }
+    auto version = loadLittleEndian<uint32_t>(data + sizeof(Trajectory::magic));
+    if (version != Trajectory::version) {
+        munmap(const_cast<char *>(data), size);
+        throw std::runtime_error("Unsupported trajectory version " + std::to_string(version));
+    }
+
+    if (!loadIndex()) {
+        spdlog::debug("Trajectory {} has no index, scanning the frames", filename);
+        scanFrames();
+    }
+}
+
+TrajectoryReader::~TrajectoryReader() {
+    munmap(const_cast<char *>(data), size);
+}
+
+bool TrajectoryReader::isTrajectory(const std::string &filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(Trajectory::magic)];
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, Trajectory::magic, sizeof(magic)) == 0;
+}
+
+bool TrajectoryReader::loadIndex() {
+    if (size < Trajectory::headerSize + Trajectory::footerSize) {
+        return false;
+    }
+    const char *footer = data + size - Trajectory::footerSize;
+    if (std::memcmp(footer + 2 * sizeof(uint64_t), Trajectory::indexMagic, sizeof(Trajectory::indexMagic)) != 0) {
+        return false;
+    }
+    auto indexOffset = loadLittleEndian<uint64_t>(footer);
+    auto frames = loadLittleEndian<uint64_t>(footer + sizeof(uint64_t));
+    if (indexOffset < Trajectory::headerSize ||
+        indexOffset + frames * sizeof(uint64_t) + Trajectory::footerSize != size) {
+        return false;
+    }
+    offsets.resize(frames);
+    for (uint64_t frame = 0; frame < frames; frame++) {
+        offsets[frame] = loadLittleEndian<uint64_t>(data + indexOffset + frame * sizeof(uint64_t));
+    }
+    endOfFrames = indexOffset;
+    return true;
+}
+
+void TrajectoryReader::scanFrames() {
+    offsets.clear();
+    uint64_t position = Trajectory::headerSize;
+    while (position + Trajectory::frameHeaderSize <= size) {
+        auto particles = loadLittleEndian<uint64_t>(data + position + sizeof(int64_t) + sizeof(double));
+        uint64_t frameSize = Trajectory::frameHeaderSize + particles * Trajectory::recordSize;
+        if (particles > size / Trajectory::recordSize || position + frameSize > size) {
+            break;
+        }
+        offsets.push_back(position);
+        position += frameSize;
+    }
+    endOfFrames = position;
+}
+
+const char *TrajectoryReader::frameHeader(size_t frame) const {
+    if (frame >= offsets.size()) {
+        throw std::out_of_range("Trajectory has no frame " + std::to_string(frame));
+    }
+    return data + offsets[frame];
+}
+
+int64_t TrajectoryReader::getIteration(size_t frame) const {
+    return loadLittleEndian<int64_t>(frameHeader(frame));
+}
+
+double TrajectoryReader::getTime(size_t frame) const {
+    return loadLittleEndian<double>(frameHeader(frame) + sizeof(int64_t));
+}
+
+uint64_t TrajectoryReader::getNumberOfParticles(size_t frame) const {
+    return loadLittleEndian<uint64_t>(frameHeader(frame) + sizeof(int64_t) + sizeof(double));
+}
+
+void TrajectoryReader::readFrame(size_t frame, ParticleContainer &particles) const {
+    const uint64_t count = getNumberOfParticles(frame);
+    const char *record = frameHeader(frame) + Trajectory::frameHeaderSize;
+    for (uint64_t i = 0; i < count; i++) {
+        std::array<std::array<double, 3>, 3> vectors{};
+        for (auto &vector: vectors) {
+            for (double &value: vector) {
+                value = loadLittleEndian<double>(record);
+                record += sizeof(double);
+            }
+        }
+        auto m = loadLittleEndian<double>(record);
+        record += sizeof(double);
+        auto type = loadLittleEndian<int32_t>(record);
+        record += sizeof(int32_t);
+
+        Particle p{vectors[0], vectors[1], m, type};
+        p.setF(vectors[2]);
+        particles.add(p);
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fileHandling/Trajectory.h"
+#include "particleRepresentation/container/ParticleContainer.h"
+
+/**
+ * @brief Reads trajectories (see Trajectory.h) via a read-only memory mapping of the file.
+ *
+ * Opening a trajectory only maps the file and reads the frame index, the frames themselves are decoded on demand.
+ * Thus, any frame can be accessed in O(1) without reading the frames before it.
+ */
+class TrajectoryReader {
+public:
+    /**
+     * @brief Map a trajectory and load its frame index.
+     *
+     * @param filename Name of the trajectory.
+     *
+     * @throws std::runtime_error If the file cannot be mapped, is no trajectory or has an unsupported version.
+     */
+    explicit TrajectoryReader(const std::string &filename);
+
+    /**
+     * @brief Unmap the trajectory.
+     */
+    ~TrajectoryReader();
+
+    TrajectoryReader(const TrajectoryReader &) = delete;
+
+    TrajectoryReader &operator=(const TrajectoryReader &) = delete;
+
+    /**
+     * @brief Check, if a file is a trajectory.
+     *
+     * @param filename Name of the file.
+     *
+     * @return True, if the file starts with the magic bytes of a trajectory.
+     */
+    static bool isTrajectory(const std::string &filename);
+
+    /**
+     * @brief Get the number of complete frames in the trajectory.
+     *
+     * @return Number of frames.
+     */
+    [[nodiscard]] size_t getNumberOfFrames() const {
+        return offsets.size();
+    }
+
+    /**
+     * @brief Get the iteration of a frame.
+     *
+     * @param frame Index of the frame.
+     *
+     * @return Iteration at which the frame was written.
+     */
+    [[nodiscard]] int64_t getIteration(size_t frame) const;
+
+    /**
+     * @brief Get the simulation time of a frame.
+     *
+     * @param frame Index of the frame.
+     *
+     * @return Simulation time at which the frame was written.
+     */
+    [[nodiscard]] double getTime(size_t frame) const;
+
+    /**
+     * @brief Get the number of particles of a frame.
+     *
+     * @param frame Index of the frame.
+     *
+     * @return Number of particles.
+     */
+    [[nodiscard]] uint64_t getNumberOfParticles(size_t frame) const;
+
+    /**
+     * @brief Add all particles of a frame to a container.
+     *
+     * @param frame Index of the frame.
+     * @param particles Container the particles are added to. The particles keep their position, velocity, force, mass
+     *                  and type.
+     *
+     * @throws std::out_of_range If the frame does not exist.
+     */
+    void readFrame(size_t frame, ParticleContainer &particles) const;
+
+    /**
+     * @brief Get the offsets of all frames.
+     *
+     * @return Offset of each frame in the file.
+     */
+    [[nodiscard]] const std::vector<uint64_t> &getFrameOffsets() const {
+        return offsets;
+    }
+
+    /**
+     * @brief Get the end of the last complete frame, i.e. the position at which the next frame has to be appended.
+     *
+     * @return Offset behind the last frame.
+     */
+    [[nodiscard]] uint64_t getEndOfFrames() const {
+        return endOfFrames;
+    }
+
+private:
+    //Mapped file
+    const char *data;
+    size_t size;
+
+    std::vector<uint64_t> offsets;
+    uint64_t endOfFrames;
+
+    /**
+     * @brief Get the header of a frame.
+     *
+     * @param frame Index of the frame.
+     *
+     * @return Pointer to the frame header.
+     *
+     * @throws std::out_of_range If the frame does not exist.
+     */
+    [[nodiscard]] const char *frameHeader(size_t frame) const;
+
+    /**
+     * @brief Load the index from the footer.
+     *
+     * @return True, if the file has a valid footer.
+     */
+    bool loadIndex();
+
+    /**
+     * @brief Rebuild the index by skipping from frame to frame. Stops at the first incomplete frame.
+     */
+    void scanFrames();
+};
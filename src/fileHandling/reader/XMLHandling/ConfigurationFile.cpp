@@ -675,6 +675,192 @@ BoundaryCondition (::std::unique_ptr< BoundaryCondition_type > x)
   this->BoundaryCondition_.set (std::move (x));
 }
 
+const model::ParticleLayout_optional& model::
+ParticleLayout () const
+{
+  return this->ParticleLayout_;
+}
+
+model::ParticleLayout_optional& model::
+ParticleLayout ()
+{
+  return this->ParticleLayout_;
+}
+
+void model::
+ParticleLayout (const ParticleLayout_type& x)
+{
+  this->ParticleLayout_.set (x);
+}
+
+void model::
+ParticleLayout (const ParticleLayout_optional& x)
+{
+  this->ParticleLayout_ = x;
+}
+
+void model::
+ParticleLayout (::std::unique_ptr< ParticleLayout_type > x)
+{
+  this->ParticleLayout_.set (std::move (x));
+}
+
+const model::VerletSkin_optional& model::
+VerletSkin () const
+{
+  return this->VerletSkin_;
+}
+
+model::VerletSkin_optional& model::
+VerletSkin ()
+{
+  return this->VerletSkin_;
+}
+
+void model::
+VerletSkin (const VerletSkin_type& x)
+{
+  this->VerletSkin_.set (x);
+}
+
+void model::
+VerletSkin (const VerletSkin_optional& x)
+{
+  this->VerletSkin_ = x;
+}
+
+const model::Threads_optional& model::
+Threads () const
+{
+  return this->Threads_;
+}
+
+model::Threads_optional& model::
+Threads ()
+{
+  return this->Threads_;
+}
+
+void model::
+Threads (const Threads_type& x)
+{
+  this->Threads_.set (x);
+}
+
+void model::
+Threads (const Threads_optional& x)
+{
+  this->Threads_ = x;
+}
+
+const model::ParallelStrategy_optional& model::
+ParallelStrategy () const
+{
+  return this->ParallelStrategy_;
+}
+
+model::ParallelStrategy_optional& model::
+ParallelStrategy ()
+{
+  return this->ParallelStrategy_;
+}
+
+void model::
+ParallelStrategy (const ParallelStrategy_type& x)
+{
+  this->ParallelStrategy_.set (x);
+}
+
+void model::
+ParallelStrategy (const ParallelStrategy_optional& x)
+{
+  this->ParallelStrategy_ = x;
+}
+
+void model::
+ParallelStrategy (::std::unique_ptr< ParallelStrategy_type > x)
+{
+  this->ParallelStrategy_.set (std::move (x));
+}
+
+const model::Theta_optional& model::
+Theta () const
+{
+  return this->Theta_;
+}
+
+model::Theta_optional& model::
+Theta ()
+{
+  return this->Theta_;
+}
+
+void model::
+Theta (const Theta_type& x)
+{
+  this->Theta_.set (x);
+}
+
+void model::
+Theta (const Theta_optional& x)
+{
+  this->Theta_ = x;
+}
+
+const model::CellOrdering_optional& model::
+CellOrdering () const
+{
+  return this->CellOrdering_;
+}
+
+model::CellOrdering_optional& model::
+CellOrdering ()
+{
+  return this->CellOrdering_;
+}
+
+void model::
+CellOrdering (const CellOrdering_type& x)
+{
+  this->CellOrdering_.set (x);
+}
+
+void model::
+CellOrdering (const CellOrdering_optional& x)
+{
+  this->CellOrdering_ = x;
+}
+
+void model::
+CellOrdering (::std::unique_ptr< CellOrdering_type > x)
+{
+  this->CellOrdering_.set (std::move (x));
+}
+
+const model::SortInterval_optional& model::
+SortInterval () const
+{
+  return this->SortInterval_;
+}
+
+model::SortInterval_optional& model::
+SortInterval ()
+{
+  return this->SortInterval_;
+}
+
+void model::
+SortInterval (const SortInterval_type& x)
+{
+  this->SortInterval_.set (x);
+}
+
+void model::
+SortInterval (const SortInterval_optional& x)
+{
+  this->SortInterval_ = x;
+}
+
 
 // SingleParticles
 // 
@@ -3321,7 +3507,14 @@ model (const Name_type& Name,
   force_ (force, this),
   DomainSize_ (this),
   rCutOff_ (this),
-  BoundaryCondition_ (this)
+  BoundaryCondition_ (this),
+  ParticleLayout_ (this),
+  VerletSkin_ (this),
+  Threads_ (this),
+  ParallelStrategy_ (this),
+  Theta_ (this),
+  CellOrdering_ (this),
+  SortInterval_ (this)
 {
 }
 
@@ -3336,7 +3529,14 @@ model (const model& x,
   force_ (x.force_, f, this),
   DomainSize_ (x.DomainSize_, f, this),
   rCutOff_ (x.rCutOff_, f, this),
-  BoundaryCondition_ (x.BoundaryCondition_, f, this)
+  BoundaryCondition_ (x.BoundaryCondition_, f, this),
+  ParticleLayout_ (x.ParticleLayout_, f, this),
+  VerletSkin_ (x.VerletSkin_, f, this),
+  Threads_ (x.Threads_, f, this),
+  ParallelStrategy_ (x.ParallelStrategy_, f, this),
+  Theta_ (x.Theta_, f, this),
+  CellOrdering_ (x.CellOrdering_, f, this),
+  SortInterval_ (x.SortInterval_, f, this)
 {
 }
 
@@ -3351,7 +3551,14 @@ model (const ::xercesc::DOMElement& e,
   force_ (this),
   DomainSize_ (this),
   rCutOff_ (this),
-  BoundaryCondition_ (this)
+  BoundaryCondition_ (this),
+  ParticleLayout_ (this),
+  VerletSkin_ (this),
+  Threads_ (this),
+  ParallelStrategy_ (this),
+  Theta_ (this),
+  CellOrdering_ (this),
+  SortInterval_ (this)
 {
   if ((f & ::xml_schema::flags::base) == 0)
   {
@@ -3468,6 +3675,92 @@ parse (::xsd::cxx::xml::dom::parser< char >& p,
       }
     }
 
+    // ParticleLayout
+    //
+    if (n.name () == "ParticleLayout" && n.namespace_ ().empty ())
+    {
+      ::std::unique_ptr< ParticleLayout_type > r (
+        ParticleLayout_traits::create (i, f, this));
+
+      if (!this->ParticleLayout_)
+      {
+        this->ParticleLayout_.set (::std::move (r));
+        continue;
+      }
+    }
+
+    // VerletSkin
+    //
+    if (n.name () == "VerletSkin" && n.namespace_ ().empty ())
+    {
+      if (!this->VerletSkin_)
+      {
+        this->VerletSkin_.set (VerletSkin_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // Threads
+    //
+    if (n.name () == "Threads" && n.namespace_ ().empty ())
+    {
+      if (!this->Threads_)
+      {
+        this->Threads_.set (Threads_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // ParallelStrategy
+    //
+    if (n.name () == "ParallelStrategy" && n.namespace_ ().empty ())
+    {
+      ::std::unique_ptr< ParallelStrategy_type > r (
+        ParallelStrategy_traits::create (i, f, this));
+
+      if (!this->ParallelStrategy_)
+      {
+        this->ParallelStrategy_.set (::std::move (r));
+        continue;
+      }
+    }
+
+    // Theta
+    //
+    if (n.name () == "Theta" && n.namespace_ ().empty ())
+    {
+      if (!this->Theta_)
+      {
+        this->Theta_.set (Theta_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // CellOrdering
+    //
+    if (n.name () == "CellOrdering" && n.namespace_ ().empty ())
+    {
+      ::std::unique_ptr< CellOrdering_type > r (
+        CellOrdering_traits::create (i, f, this));
+
+      if (!this->CellOrdering_)
+      {
+        this->CellOrdering_.set (::std::move (r));
+        continue;
+      }
+    }
+
+    // SortInterval
+    //
+    if (n.name () == "SortInterval" && n.namespace_ ().empty ())
+    {
+      if (!this->SortInterval_)
+      {
+        this->SortInterval_.set (SortInterval_traits::create (i, f, this));
+        continue;
+      }
+    }
+
     break;
   }
 
@@ -3520,6 +3813,13 @@ operator= (const model& x)
     this->DomainSize_ = x.DomainSize_;
     this->rCutOff_ = x.rCutOff_;
     this->BoundaryCondition_ = x.BoundaryCondition_;
+    this->ParticleLayout_ = x.ParticleLayout_;
+    this->VerletSkin_ = x.VerletSkin_;
+    this->Threads_ = x.Threads_;
+    this->ParallelStrategy_ = x.ParallelStrategy_;
+    this->Theta_ = x.Theta_;
+    this->CellOrdering_ = x.CellOrdering_;
+    this->SortInterval_ = x.SortInterval_;
   }
 
   return *this;
@@ -4272,11 +4572,11 @@ _xsd_Name_convert () const
   ::xsd::cxx::tree::enum_comparator< char > c (_xsd_Name_literals_);
   const value* i (::std::lower_bound (
                     _xsd_Name_indexes_,
-                    _xsd_Name_indexes_ + 2,
+                    _xsd_Name_indexes_ + 3,
                     *this,
                     c));
 
-  if (i == _xsd_Name_indexes_ + 2 || _xsd_Name_literals_[*i] != *this)
+  if (i == _xsd_Name_indexes_ + 3 || _xsd_Name_literals_[*i] != *this)
   {
     throw ::xsd::cxx::tree::unexpected_enumerator < char > (*this);
   }
@@ -4285,15 +4585,17 @@ _xsd_Name_convert () const
 }
 
 const char* const Name::
-_xsd_Name_literals_[2] =
+_xsd_Name_literals_[3] =
 {
   "DirectSum",
-  "LinkedCells"
+  "LinkedCells",
+  "BarnesHut"
 };
 
 const Name::value Name::
-_xsd_Name_indexes_[2] =
+_xsd_Name_indexes_[3] =
 {
+  ::Name::BarnesHut,
   ::Name::DirectSum,
   ::Name::LinkedCells
 };
@@ -8489,6 +8791,90 @@ operator<< (::xercesc::DOMElement& e, const model& i)
 
     s << *i.BoundaryCondition ();
   }
+
+  // ParticleLayout
+  //
+  if (i.ParticleLayout ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "ParticleLayout",
+        e));
+
+    s << *i.ParticleLayout ();
+  }
+
+  // VerletSkin
+  //
+  if (i.VerletSkin ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "VerletSkin",
+        e));
+
+    s << ::xml_schema::as_double(*i.VerletSkin ());
+  }
+
+  // Threads
+  //
+  if (i.Threads ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "Threads",
+        e));
+
+    s << *i.Threads ();
+  }
+
+  // ParallelStrategy
+  //
+  if (i.ParallelStrategy ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "ParallelStrategy",
+        e));
+
+    s << *i.ParallelStrategy ();
+  }
+
+  // Theta
+  //
+  if (i.Theta ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "Theta",
+        e));
+
+    s << ::xml_schema::as_double(*i.Theta ());
+  }
+
+  // CellOrdering
+  //
+  if (i.CellOrdering ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "CellOrdering",
+        e));
+
+    s << *i.CellOrdering ();
+  }
+
+  // SortInterval
+  //
+  if (i.SortInterval ())
+  {
+    ::xercesc::DOMElement& s (
+      ::xsd::cxx::xml::dom::create_element (
+        "SortInterval",
+        e));
+
+    s << *i.SortInterval ();
+  }
 }
 
 void
@@ -2732,6 +2732,494 @@ class model: public ::xml_schema::type
 
   //@}
 
+  /**
+   * @name ParticleLayout
+   *
+   * @brief Accessor and modifier functions for the %ParticleLayout
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::string ParticleLayout_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< ParticleLayout_type > ParticleLayout_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< ParticleLayout_type, char > ParticleLayout_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const ParticleLayout_optional&
+  ParticleLayout () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  ParticleLayout_optional&
+  ParticleLayout ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  ParticleLayout (const ParticleLayout_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  ParticleLayout (const ParticleLayout_optional& x);
+
+  /**
+   * @brief Set the element value without copying.
+   *
+   * @param p A new value to use.
+   *
+   * This function will try to use the passed value directly instead
+   * of making a copy.
+   */
+  void
+  ParticleLayout (::std::unique_ptr< ParticleLayout_type > p);
+
+  //@}
+
+  /**
+   * @name VerletSkin
+   *
+   * @brief Accessor and modifier functions for the %VerletSkin
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ VerletSkin_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< VerletSkin_type > VerletSkin_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< VerletSkin_type, char, ::xsd::cxx::tree::schema_type::double_ > VerletSkin_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const VerletSkin_optional&
+  VerletSkin () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  VerletSkin_optional&
+  VerletSkin ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  VerletSkin (const VerletSkin_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  VerletSkin (const VerletSkin_optional& x);
+
+  //@}
+
+  /**
+   * @name Threads
+   *
+   * @brief Accessor and modifier functions for the %Threads
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::int_ Threads_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< Threads_type > Threads_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< Threads_type, char > Threads_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const Threads_optional&
+  Threads () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  Threads_optional&
+  Threads ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  Threads (const Threads_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  Threads (const Threads_optional& x);
+
+  //@}
+
+  /**
+   * @name ParallelStrategy
+   *
+   * @brief Accessor and modifier functions for the %ParallelStrategy
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::string ParallelStrategy_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< ParallelStrategy_type > ParallelStrategy_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< ParallelStrategy_type, char > ParallelStrategy_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const ParallelStrategy_optional&
+  ParallelStrategy () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  ParallelStrategy_optional&
+  ParallelStrategy ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  ParallelStrategy (const ParallelStrategy_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  ParallelStrategy (const ParallelStrategy_optional& x);
+
+  /**
+   * @brief Set the element value without copying.
+   *
+   * @param p A new value to use.
+   *
+   * This function will try to use the passed value directly instead
+   * of making a copy.
+   */
+  void
+  ParallelStrategy (::std::unique_ptr< ParallelStrategy_type > p);
+
+  //@}
+
+  /**
+   * @name Theta
+   *
+   * @brief Accessor and modifier functions for the %Theta
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ Theta_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< Theta_type > Theta_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< Theta_type, char, ::xsd::cxx::tree::schema_type::double_ > Theta_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const Theta_optional&
+  Theta () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  Theta_optional&
+  Theta ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  Theta (const Theta_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  Theta (const Theta_optional& x);
+
+  //@}
+
+  /**
+   * @name CellOrdering
+   *
+   * @brief Accessor and modifier functions for the %CellOrdering
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::string CellOrdering_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< CellOrdering_type > CellOrdering_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< CellOrdering_type, char > CellOrdering_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const CellOrdering_optional&
+  CellOrdering () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  CellOrdering_optional&
+  CellOrdering ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  CellOrdering (const CellOrdering_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  CellOrdering (const CellOrdering_optional& x);
+
+  /**
+   * @brief Set the element value without copying.
+   *
+   * @param p A new value to use.
+   *
+   * This function will try to use the passed value directly instead
+   * of making a copy.
+   */
+  void
+  CellOrdering (::std::unique_ptr< CellOrdering_type > p);
+
+  //@}
+
+  /**
+   * @name SortInterval
+   *
+   * @brief Accessor and modifier functions for the %SortInterval
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::int_ SortInterval_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< SortInterval_type > SortInterval_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< SortInterval_type, char > SortInterval_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const SortInterval_optional&
+  SortInterval () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  SortInterval_optional&
+  SortInterval ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  SortInterval (const SortInterval_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  SortInterval (const SortInterval_optional& x);
+
+  //@}
+
   /**
    * @name Constructors
    */
@@ -2823,6 +3311,13 @@ class model: public ::xml_schema::type
   DomainSize_optional DomainSize_;
   rCutOff_optional rCutOff_;
   BoundaryCondition_optional BoundaryCondition_;
+  ParticleLayout_optional ParticleLayout_;
+  VerletSkin_optional VerletSkin_;
+  Threads_optional Threads_;
+  ParallelStrategy_optional ParallelStrategy_;
+  Theta_optional Theta_;
+  CellOrdering_optional CellOrdering_;
+  SortInterval_optional SortInterval_;
 
   //@endcond
 };
@@ -4179,7 +4674,8 @@ class Name: public ::xml_schema::string
   enum value
   {
     DirectSum,
-    LinkedCells
+    LinkedCells,
+    BarnesHut
   };
 
   /**
@@ -4304,8 +4800,8 @@ class Name: public ::xml_schema::string
   _xsd_Name_convert () const;
 
   public:
-  static const char* const _xsd_Name_literals_[2];
-  static const value _xsd_Name_indexes_[2];
+  static const char* const _xsd_Name_literals_[3];
+  static const value _xsd_Name_indexes_[3];
 
   //@endcond
 };
@@ -138,6 +138,7 @@ int XMLReader::readFile(std::string &filename, enumsStructs::SimulationSettings
                 } else {
                     simulationSettings.parametersDirectSum.endT = static_cast<double>(molecules.model().t_end());
                     simulationSettings.parametersLinkedCells.endT = static_cast<double>(molecules.model().t_end());
+                    simulationSettings.parametersBarnesHut.endT = static_cast<double>(molecules.model().t_end());
                     spdlog::debug("t_end: {}", static_cast<double>(molecules.model().t_end()));
                 }
 
@@ -146,6 +147,7 @@ int XMLReader::readFile(std::string &filename, enumsStructs::SimulationSettings
                 } else {
                     simulationSettings.parametersDirectSum.deltaT = static_cast<double>(molecules.model().delta_t());
                     simulationSettings.parametersLinkedCells.deltaT = static_cast<double>(molecules.model().delta_t());
+                    simulationSettings.parametersBarnesHut.deltaT = static_cast<double>(molecules.model().delta_t());
                     spdlog::debug("delta_t: {}", static_cast<double>(molecules.model().delta_t()));
                 }
 
@@ -155,9 +157,28 @@ int XMLReader::readFile(std::string &filename, enumsStructs::SimulationSettings
                 } else {
                     simulationSettings.parametersDirectSum.force = force;
                     simulationSettings.parametersLinkedCells.force = force;
+                    simulationSettings.parametersBarnesHut.force = force;
                     spdlog::debug("Force: {}", molecules.model().force());
                 }
 
+                if (molecules.model().Name() == "BarnesHut") {
+                    if (molecules.model().Theta().present()) {
+                        if (static_cast<double>(molecules.model().Theta().get()) < 0) {
+                            throw std::runtime_error("Theta is negative");
+                        }
+                        simulationSettings.parametersBarnesHut.theta = static_cast<double>(molecules.model().Theta().get());
+                    }
+                    spdlog::debug("Theta: {}", simulationSettings.parametersBarnesHut.theta);
+                }
+
+                if (molecules.model().Name() == "DirectSum" && molecules.model().Threads().present()) {
+                    if (static_cast<int>(molecules.model().Threads().get()) < 1) {
+                        throw std::runtime_error("Threads is less than 1");
+                    }
+                    simulationSettings.parametersDirectSum.threads = static_cast<int>(molecules.model().Threads().get());
+                    spdlog::debug("Threads: {}", simulationSettings.parametersDirectSum.threads);
+                }
+
                 if (molecules.model().Name() == "LinkedCells") {
                     if (molecules.model().DomainSize().present()) {
                         if (static_cast<double>(molecules.model().DomainSize().get().First()) < 0) {
@@ -218,6 +239,72 @@ int XMLReader::readFile(std::string &filename, enumsStructs::SimulationSettings
                     } else {
                         throw std::runtime_error("BoundaryCondition is not present");
                     }
+
+                    if (molecules.model().ParticleLayout().present()) {
+                        enumsStructs::ParticleLayout layout = enumsStructs::setParticleLayout(
+                                molecules.model().ParticleLayout().get());
+                        if (layout == enumsStructs::ParticleLayout::invalid) {
+                            throw std::runtime_error("ParticleLayout is invalid");
+                        }
+                        simulationSettings.parametersLinkedCells.particleLayout = layout;
+                        spdlog::debug("ParticleLayout: {}", molecules.model().ParticleLayout().get());
+                    } else {
+                        simulationSettings.parametersLinkedCells.particleLayout = enumsStructs::ParticleLayout::aos;
+                    }
+
+                    if (molecules.model().VerletSkin().present()) {
+                        if (static_cast<double>(molecules.model().VerletSkin().get()) < 0) {
+                            throw std::runtime_error("VerletSkin is less than 0");
+                        }
+                        simulationSettings.parametersLinkedCells.verletSkin = static_cast<double>(molecules.model().VerletSkin().get());
+                        spdlog::debug("VerletSkin: {}", static_cast<double>(molecules.model().VerletSkin().get()));
+                    } else {
+                        simulationSettings.parametersLinkedCells.verletSkin = 0;
+                    }
+
+                    if (molecules.model().Threads().present()) {
+                        if (static_cast<int>(molecules.model().Threads().get()) < 1) {
+                            throw std::runtime_error("Threads is less than 1");
+                        }
+                        simulationSettings.parametersLinkedCells.threads = static_cast<int>(molecules.model().Threads().get());
+                        spdlog::debug("Threads: {}", static_cast<int>(molecules.model().Threads().get()));
+                    } else {
+                        simulationSettings.parametersLinkedCells.threads = 1;
+                    }
+
+                    if (molecules.model().ParallelStrategy().present()) {
+                        enumsStructs::ParallelStrategy strategy = enumsStructs::setParallelStrategy(
+                                molecules.model().ParallelStrategy().get());
+                        if (strategy == enumsStructs::ParallelStrategy::invalid) {
+                            throw std::runtime_error("ParallelStrategy is invalid");
+                        }
+                        simulationSettings.parametersLinkedCells.parallelStrategy = strategy;
+                        spdlog::debug("ParallelStrategy: {}", molecules.model().ParallelStrategy().get());
+                    } else {
+                        simulationSettings.parametersLinkedCells.parallelStrategy = enumsStructs::ParallelStrategy::coloring;
+                    }
+
+                    if (molecules.model().CellOrdering().present()) {
+                        enumsStructs::CellOrdering ordering = enumsStructs::setCellOrdering(
+                                molecules.model().CellOrdering().get());
+                        if (ordering == enumsStructs::CellOrdering::invalid) {
+                            throw std::runtime_error("CellOrdering is invalid");
+                        }
+                        simulationSettings.parametersLinkedCells.cellOrdering = ordering;
+                        spdlog::debug("CellOrdering: {}", molecules.model().CellOrdering().get());
+                    } else {
+                        simulationSettings.parametersLinkedCells.cellOrdering = enumsStructs::CellOrdering::rowMajor;
+                    }
+
+                    if (molecules.model().SortInterval().present()) {
+                        if (static_cast<int>(molecules.model().SortInterval().get()) < 0) {
+                            throw std::runtime_error("SortInterval is less than 0");
+                        }
+                        simulationSettings.parametersLinkedCells.sortInterval = static_cast<int>(molecules.model().SortInterval().get());
+                        spdlog::debug("SortInterval: {}", static_cast<int>(molecules.model().SortInterval().get()));
+                    } else {
+                        simulationSettings.parametersLinkedCells.sortInterval = 0;
+                    }
                 }
 
                 if (molecules.SingleParticles().present()) {
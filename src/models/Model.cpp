@@ -10,19 +10,6 @@ Model::Model(ParticleContainer &particles, Force &force, double deltaT,
              force{force}, deltaT{deltaT}, gravityOn{gravityOn}, g{g} {
 }
 
-void Model::updateForces() const {
-    //Before calculating the new forces, the current forces have to be reset.
-    particles.applyToEachParticleInDomain([](Particle &p) {
-        p.resetForce();
-    });
-    //Calculate new forces using Newtons third law of motion
-    particles.applyToAllUniquePairsInDomain([this](Particle &p_i, Particle &p_j) {
-        auto f_ij{force.compute(p_i, p_j)};
-        p_i.setF(p_i.getF() + f_ij);
-        p_j.setF( p_j.getF() - f_ij);
-    });
-}
-
 void Model::updatePositions() const {
     particles.applyToEachParticleInDomain([this](Particle &p) {
         p.setX(p.getX() + deltaT * p.getV() + ((deltaT * deltaT) / (2.0 * p.getM())) * p.getOldF());
@@ -43,30 +30,70 @@ void Model::applyGravity() {
     });
 }
 
-void Model::plot(int iteration, std::string &baseName) {
-    fileHandler.writeToFile(particles, iteration, outputFormat, baseName);
+void Model::plot(int iteration, std::string &baseName, double time) {
+    fileHandler.writeToFile(particles, iteration, outputFormat, baseName, time);
+}
+
+void Model::accountMemory(MemoryFootprint &footprint) const {
+    particles.accountMemory(footprint);
+    fileHandler.accountMemory(footprint);
+}
+
+void Model::setVTUOptions(outputWriter::VTUWriter::Precision precision, bool compress, size_t pieces) {
+    fileHandler.setVTUOptions(precision, compress, pieces);
+}
+
+void Model::startNewTrajectory() {
+    fileHandler.startNewTrajectory();
 }
 
 void Model::addCuboid(const std::array<double, 3> &position, unsigned N1, unsigned N2,
                       unsigned N3, double h, double mass, const std::array<double, 3> &initVelocity, int dimensions,
                       double brownianMotionAverageVelocity, double epsilon, double sigma) {
+    force.registerParameterType(sigma, epsilon);
     ParticleGenerator::generateCuboid(particles, position, N1, N2, N3, h, mass, initVelocity, dimensions,
                                       brownianMotionAverageVelocity, epsilon, sigma);
+    registerParameterTypes();
 }
 
 void Model::addDisc(const std::array<double, 3> &center,
                     const std::array<double, 3> &initVelocity, int N, double h, double mass, int dimensions,
                     double brownianMotionAverageVelocity, double epsilon, double sigma) {
+    force.registerParameterType(sigma, epsilon);
     ParticleGenerator::generateDisc(particles, center, initVelocity, N, h, mass, dimensions,
                                     brownianMotionAverageVelocity, epsilon, sigma);
+    registerParameterTypes();
 }
 
 void Model::addParticle(Particle &p) {
+    p.setParameterType(force.registerParameterType(p.getSigma(), p.getEpsilon()));
     particles.add(p);
 }
 
 void Model::addViaFile(std::string &filepath, FileHandler::inputFormat inputFormat) {
     FileHandler::readFile(particles, filepath, inputFormat);
+    registerParameterTypes();
+}
+
+void Model::registerParameterTypes() {
+    //Distinct pairs of sigma and epsilon of this process
+    std::vector<double> parameters;
+    particles.applyToEachParticle([&parameters](Particle &p) {
+        for (size_t i = 0; i < parameters.size(); i += 2) {
+            if (parameters[i] == p.getSigma() && parameters[i + 1] == p.getEpsilon()) {
+                return;
+            }
+        }
+        parameters.push_back(p.getSigma());
+        parameters.push_back(p.getEpsilon());
+    });
+    gatherOverSubdomains(parameters);
+    for (size_t i = 0; i < parameters.size(); i += 2) {
+        force.registerParameterType(parameters[i], parameters[i + 1]);
+    }
+    particles.applyToEachParticle([this](Particle &p) {
+        p.setParameterType(force.registerParameterType(p.getSigma(), p.getEpsilon()));
+    });
 }
 
 void Model::saveState() {
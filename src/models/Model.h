@@ -3,9 +3,13 @@
 //
 
 #pragma once
+#include <optional>
+
 #include "fileHandling/FileHandler.h"
 #include "moleculeSimulator/forceCalculation/Force.h"
+#include "moleculeSimulator/forceCalculation/ForceDispatch.h"
 #include "particleRepresentation/container/ParticleContainer.h"
+#include "profiling/PairStatistics.h"
 
 /**
  * @brief Abstract base class for any model for molecule simulation.
@@ -64,6 +68,53 @@ protected:
      */
     void applyGravity();
 
+    //Templated versions of the helper methods above. They are called by the derived models with their concrete
+    //container (and force), so that the traversals and the force calculation can be inlined by the compiler.
+
+    /**
+     * @brief Calculate the forces between all particles of the container using Newtons third law of motion.
+     *
+     * @param container Concrete container of the derived model.
+     * @param concreteForce Force cast to its concrete type (see dispatchForce()).
+     */
+    template<typename Container, typename ForceType>
+    void calculateForces(Container &container, ForceType &concreteForce) {
+        //Before calculating the new forces, the current forces have to be reset.
+        container.forEachParticleInDomain([](Particle &p) {
+            p.resetForce();
+        });
+        //Calculate new forces using Newtons third law of motion
+        container.forEachUniquePairInDomain([&concreteForce](Particle &p_i, Particle &p_j) {
+            auto f_ij{concreteForce.compute(p_i, p_j)};
+            p_i.setF(p_i.getF() + f_ij);
+            p_j.setF(p_j.getF() - f_ij);
+        });
+    }
+
+    /**
+     * @brief Calculate the positions of all particles of the container.
+     *
+     * @param container Concrete container of the derived model.
+     */
+    template<typename Container>
+    void calculatePositions(Container &container) const {
+        container.forEachParticleInDomain([this](Particle &p) {
+            p.setX(p.getX() + deltaT * p.getV() + ((deltaT * deltaT) / (2.0 * p.getM())) * p.getOldF());
+        });
+    }
+
+    /**
+     * @brief Calculate the velocities of all particles of the container.
+     *
+     * @param container Concrete container of the derived model.
+     */
+    template<typename Container>
+    void calculateVelocities(Container &container) const {
+        container.forEachParticleInDomain([this](Particle &p) {
+            p.setV(p.getV() + (deltaT / (2 * p.getM())) * (p.getOldF() + p.getF()));
+        });
+    }
+
 public:
     /**
      *@brief Virtual default constructor to guarantee appropriate memory clean up
@@ -75,8 +126,23 @@ public:
      *
      * @param iteration Current iteration.
      * @param baseName Base name of the output file.
+     * @param time Current simulation time.
+     */
+    void plot(int iteration, std::string &baseName, double time = 0);
+
+    /**
+     * @brief Configure the binary vtu and pvtu output of this model.
+     *
+     * @param precision Precision of the floating point arrays.
+     * @param compress Compress the arrays with zlib.
+     * @param pieces Number of pieces per frame of the pvtu output. If 0, one piece per OpenMP thread is written.
      */
-    void plot(int iteration, std::string &baseName);
+    void setVTUOptions(outputWriter::VTUWriter::Precision precision, bool compress, size_t pieces = 0);
+
+    /**
+     * @brief Start a new trajectory with the next frame of the traj output, replacing an existing one.
+     */
+    void startNewTrajectory();
 
     /**
      * @brief Add a cuboid structure to this model.
@@ -130,6 +196,17 @@ public:
      */
     void addViaFile(std::string &filepath, FileHandler::inputFormat inputFormat);
 
+    /**
+     * @brief Register the Leonard-Jones parameters of all particles with the force and assign their parameter types.
+     *
+     * All methods adding particles to this model do this on their own. Particles added directly to the container,
+     * e.g. from a checkpoint, have to be registered afterwards, before the forces are calculated.
+     *
+     * The parameters of all subdomains are registered in the same order on all processes, so a parameter type means
+     * the same on every process. All processes have to call this method together.
+     */
+    void registerParameterTypes();
+
    /**
     * @brief Export the current state of all molecules to a txt file for using them in a new simulation.
     */
@@ -140,11 +217,11 @@ public:
     * @brief Helper method to calculate the force between all particles.
     *
     * After each time step the forces acting between the particles have changed due to their new positions, so
-    * they have to be recalculated. This method uses Newtons third law of motion to simplify calculations and make
-    * them more efficient.
+    * they have to be recalculated. Each model traverses its own container, e.g. with calculateForces(), which uses
+    * Newtons third law of motion to simplify calculations and make them more efficient.
     */
 
-    void updateForces() const;
+    virtual void updateForces() = 0;
 
     /**
      * @brief Perform one single step in the simulation.
@@ -155,6 +232,50 @@ public:
 
     virtual void step() = 0;
 
+    /**
+     * @brief Sum values over all parts of a simulation that is distributed over several processes, e.g. to calculate
+     *        global quantities like the temperature. A model that simulates the whole domain leaves the values unchanged.
+     *
+     * @param values Values of this process, replaced by the sums.
+     */
+    virtual void sumOverSubdomains(std::vector<double> &values) const {
+    }
+
+    /**
+     * @brief Concatenate values over all parts of a simulation that is distributed over several processes, in the same
+     *        order on every process. A model that simulates the whole domain leaves the values unchanged.
+     *
+     * @param values Values of this process, replaced by the values of all processes.
+     */
+    virtual void gatherOverSubdomains(std::vector<double> &values) const {
+    }
+
+    /**
+     * @brief Count the pairs of particles interacting with each other in the current state, e.g. to relate hardware
+     *        events to the work of the force calculation.
+     *
+     * @return Number of interacting pairs, or 0 if the model cannot tell.
+     */
+    [[nodiscard]] virtual unsigned long long countPairInteractions() {
+        return 0;
+    }
+
+    /**
+     * @brief Collect statistics about the efficiency of the pair traversal in the current state (see PairStatistics).
+     *
+     * @return Statistics, or nothing if the model does not traverse cells.
+     */
+    [[nodiscard]] virtual std::optional<PairStatistics> collectPairStatistics() {
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Add the bytes held by the particle container and the output writers of this model to a memory footprint.
+     *
+     * @param footprint Footprint to add to.
+     */
+    virtual void accountMemory(MemoryFootprint &footprint) const;
+
     /**
      * @brief Get the Particles of this model.
      *
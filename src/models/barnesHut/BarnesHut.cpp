@@ -0,0 +1,50 @@
+#include "BarnesHut.h"
+
+#include "profiling/PhaseTimers.h"
+
+namespace {
+    Gravity &asGravity(Force &force) {
+        auto *gravity = dynamic_cast<Gravity *>(&force);
+        if (gravity == nullptr) {
+            throw std::invalid_argument("The Barnes-Hut model only supports the gravitational force.");
+        }
+        return *gravity;
+    }
+}
+
+BarnesHut::BarnesHut(Force &force, double deltaT, FileHandler::outputFormat outputFormat, bool gravityOn, double g,
+                     double theta) : Model(particles, force, deltaT, outputFormat, gravityOn, g),
+                                     gravity{asGravity(force)}, theta{theta} {
+    if (theta < 0) {
+        throw std::invalid_argument("The opening angle theta must not be negative.");
+    }
+}
+
+void BarnesHut::step() {
+    {
+        PHASE_TIMER(Phase::forces);
+        updateForces();
+    }
+    if (gravityOn) {
+        PHASE_TIMER(Phase::gravity);
+        applyGravity();
+    }
+    {
+        PHASE_TIMER(Phase::velocities);
+        calculateVelocities(particles);
+    }
+    {
+        PHASE_TIMER(Phase::positions);
+        calculatePositions(particles);
+    }
+}
+
+void BarnesHut::updateForces() {
+    particles.forEachParticle([](Particle &p) {
+        p.resetForce();
+    });
+    octree.build(particles.begin(), particles.end());
+    particles.forEachParticle([this](Particle &p) {
+        p.setF(p.getF() + octree.computeForce(p, gravity, theta));
+    });
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../Model.h"
+#include "Octree.h"
+#include "moleculeSimulator/forceCalculation/gravity/Gravity.h"
+#include "particleRepresentation/container/defaultParticleContainer/DefaultParticleContainer.h"
+
+/**
+ * @brief Model that implements the Barnes-Hut algorithm for gravitational simulations.
+ *
+ * In each time step an octree is built over all particles. The force on each particle is computed by traversing the
+ * tree and approximating distant groups of particles by a single body at their center of mass. This reduces the
+ * complexity of the force calculation from O(N²) to O(N log N). The accuracy is controlled by the opening angle theta.
+ */
+class BarnesHut final : public Model {
+private:
+    /**
+    * This model uses the DefaultParticleContainer to store its particles.
+    */
+    DefaultParticleContainer particles;
+
+    /**
+     * Gravitational force of this model. The Barnes-Hut approximation is only valid for gravity.
+     */
+    Gravity &gravity;
+
+    /**
+     * Octree over all particles, rebuilt in each time step.
+     */
+    Octree octree;
+
+    /**
+     * Opening angle of the Barnes-Hut approximation.
+     */
+    double theta;
+
+public:
+    /**
+     * @brief Construct a new Barnes-Hut model.
+     *
+     * @param force Force to use. Has to be gravity.
+     * @param deltaT Discretisation step.
+     * @param outputFormat Output format.
+     * @param gravityOn Toggle gravity on or off.
+     * @param g Gravitational factor g.
+     * @param theta Opening angle. Smaller values are more accurate, theta = 0 results in the exact direct sum.
+     */
+    BarnesHut(Force &force, double deltaT, FileHandler::outputFormat outputFormat, bool gravityOn, double g = 1,
+              double theta = 0.5);
+
+    /**
+     * @brief Perform one time step in the Barnes-Hut model.
+     */
+    void step() override;
+
+    /**
+     * @brief Calculate the forces acting on all particles using the octree.
+     */
+    void updateForces() override;
+};
@@ -0,0 +1,173 @@
+#include "Octree.h"
+
+#include <algorithm>
+#include <cmath>
+
+Octree::Octree(size_t leafSize) : leafSize{std::max<size_t>(leafSize, 1)} {
+}
+
+void Octree::build(std::vector<Particle>::iterator begin, std::vector<Particle>::iterator end) {
+    nodes.clear();
+    order.clear();
+    if (begin == end) {
+        return;
+    }
+
+    //The root is the smallest cube containing all particles
+    std::array<double, 3> min = begin->getX();
+    std::array<double, 3> max = begin->getX();
+    for (auto p = begin; p != end; ++p) {
+        order.push_back(&*p);
+        for (int d = 0; d < 3; d++) {
+            min[d] = std::min(min[d], p->getX()[d]);
+            max[d] = std::max(max[d], p->getX()[d]);
+        }
+    }
+    double size = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2]});
+    //Enlarge the cube slightly, so that no particle lies exactly on its boundary
+    size = size > 0 ? size * (1 + 1e-9) : 1;
+    scratch.resize(order.size());
+
+    Node root{};
+    root.center = {(min[0] + max[0]) / 2, (min[1] + max[1]) / 2, (min[2] + max[2]) / 2};
+    root.size = size;
+    root.begin = 0;
+    root.end = order.size();
+    nodes.push_back(root);
+    buildNode(0, 0);
+}
+
+void Octree::buildNode(int nodeIndex, int depth) {
+    const size_t begin = nodes[nodeIndex].begin;
+    const size_t end = nodes[nodeIndex].end;
+
+    if (end - begin <= leafSize || depth == maxDepth) {
+        //Leaf: accumulate the particles directly
+        Node &node = nodes[nodeIndex];
+        node.firstChild = -1;
+        node.childCount = 0;
+        node.mass = 0;
+        node.centerOfMass = {0, 0, 0};
+        for (size_t i = begin; i < end; i++) {
+            node.mass += order[i]->getM();
+            for (int d = 0; d < 3; d++) {
+                node.centerOfMass[d] += order[i]->getM() * order[i]->getX()[d];
+            }
+        }
+        if (node.mass > 0) {
+            for (int d = 0; d < 3; d++) {
+                node.centerOfMass[d] /= node.mass;
+            }
+        } else {
+            node.centerOfMass = order[begin]->getX();
+        }
+        return;
+    }
+
+    //Partition the particles of this node into its octants (counting sort)
+    const std::array<double, 3> center = nodes[nodeIndex].center;
+    const double size = nodes[nodeIndex].size;
+    auto octantOf = [&center](const Particle *p) {
+        return (p->getX()[0] >= center[0] ? 1 : 0) | (p->getX()[1] >= center[1] ? 2 : 0) |
+               (p->getX()[2] >= center[2] ? 4 : 0);
+    };
+    std::array<size_t, 9> offsets{};
+    for (size_t i = begin; i < end; i++) {
+        offsets[octantOf(order[i]) + 1]++;
+    }
+    for (int o = 0; o < 8; o++) {
+        offsets[o + 1] += offsets[o];
+    }
+    std::array<size_t, 8> insert{};
+    std::copy(offsets.begin(), offsets.begin() + 8, insert.begin());
+    for (size_t i = begin; i < end; i++) {
+        scratch[begin + insert[octantOf(order[i])]++] = order[i];
+    }
+    std::copy(scratch.begin() + static_cast<long>(begin), scratch.begin() + static_cast<long>(end),
+              order.begin() + static_cast<long>(begin));
+
+    //Create all non-empty children contiguously, before descending into them
+    const int firstChild = static_cast<int>(nodes.size());
+    for (int o = 0; o < 8; o++) {
+        if (offsets[o] == offsets[o + 1]) {
+            continue;
+        }
+        Node child{};
+        for (int d = 0; d < 3; d++) {
+            child.center[d] = center[d] + ((o >> d) & 1 ? size / 4 : -size / 4);
+        }
+        child.size = size / 2;
+        child.begin = begin + offsets[o];
+        child.end = begin + offsets[o + 1];
+        nodes.push_back(child);
+    }
+    const int childCount = static_cast<int>(nodes.size()) - firstChild;
+    for (int c = firstChild; c < firstChild + childCount; c++) {
+        buildNode(c, depth + 1);
+    }
+
+    //Combine the children (nodes may have been reallocated by the recursion)
+    Node &node = nodes[nodeIndex];
+    node.firstChild = firstChild;
+    node.childCount = childCount;
+    node.mass = 0;
+    node.centerOfMass = {0, 0, 0};
+    for (int c = firstChild; c < firstChild + childCount; c++) {
+        node.mass += nodes[c].mass;
+        for (int d = 0; d < 3; d++) {
+            node.centerOfMass[d] += nodes[c].mass * nodes[c].centerOfMass[d];
+        }
+    }
+    if (node.mass > 0) {
+        for (int d = 0; d < 3; d++) {
+            node.centerOfMass[d] /= node.mass;
+        }
+    } else {
+        node.centerOfMass = node.center;
+    }
+}
+
+std::array<double, 3> Octree::computeForce(Particle &target, Gravity &gravity, double theta) {
+    std::array<double, 3> force = {0, 0, 0};
+    if (nodes.empty()) {
+        return force;
+    }
+    const double thetaSquared = theta * theta;
+
+    //Depth first traversal with an explicit stack. At most 7 siblings per level wait on the stack.
+    std::array<int, 8 * (maxDepth + 1)> stack{};
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node &node = nodes[stack[--top]];
+        if (node.firstChild == -1) {
+            //Leaf: interact with each particle individually
+            for (size_t i = node.begin; i < node.end; i++) {
+                Particle *source = order[i];
+                if (source == &target) {
+                    continue;
+                }
+                auto difference = source->getX() - target.getX();
+                double distance = ArrayUtils::L2Norm(difference);
+                if (distance == 0) {
+                    continue;
+                }
+                force = force + gravity.computeOptimized(target, *source, difference, distance);
+            }
+            continue;
+        }
+        auto difference = node.centerOfMass - target.getX();
+        double squaredDistance = difference[0] * difference[0] + difference[1] * difference[1] +
+                                 difference[2] * difference[2];
+        if (node.size * node.size < thetaSquared * squaredDistance) {
+            //Far away: approximate the whole node by a single body at its center of mass
+            double distance = std::sqrt(squaredDistance);
+            force = force + (target.getM() * node.mass) / (squaredDistance * distance) * difference;
+        } else {
+            for (int c = node.firstChild; c < node.firstChild + node.childCount; c++) {
+                stack[top++] = c;
+            }
+        }
+    }
+    return force;
+}
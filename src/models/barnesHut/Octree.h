@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "moleculeSimulator/forceCalculation/gravity/Gravity.h"
+#include "particleRepresentation/particle/Particle.h"
+
+/**
+ * @brief Octree over a set of particles used by the Barnes-Hut algorithm.
+ *
+ * Each node covers a cube of space and stores the total mass and the center of mass of all particles inside it.
+ * Leaf nodes additionally reference their particles. The nodes are stored in one flat vector and the children of
+ * each node are contiguous, so the tree can be rebuilt every time step without any per-node allocations.
+ *
+ * The tree stores pointers to the particles it was built from. It has to be rebuilt, if particles are added or
+ * removed from the underlying storage.
+ */
+class Octree {
+private:
+    /**
+     * @brief Node of the octree.
+     */
+    struct Node {
+        //Geometric center of the cube covered by this node
+        std::array<double, 3> center;
+        //Edge length of the cube covered by this node
+        double size;
+        //Total mass of all particles in this node
+        double mass;
+        //Center of mass of all particles in this node
+        std::array<double, 3> centerOfMass;
+        //Index of the first child in nodes, -1 for leaves
+        int firstChild;
+        //Number of (non-empty) children
+        int childCount;
+        //Range of the particles of this node in the particle order
+        size_t begin;
+        size_t end;
+    };
+
+    /**
+     * Nodes of the tree. The root is stored at index 0.
+     */
+    std::vector<Node> nodes;
+
+    /**
+     * Pointers to all particles, ordered such that the particles of each node form a contiguous range.
+     */
+    std::vector<Particle *> order;
+
+    /**
+     * Scratch buffer used while partitioning the particles of a node into its octants.
+     */
+    std::vector<Particle *> scratch;
+
+    /**
+     * Maximal number of particles stored in one leaf.
+     */
+    size_t leafSize;
+
+    /**
+     * Maximal depth of the tree. Stops the subdivision if many particles share (almost) the same position.
+     */
+    static constexpr int maxDepth = 32;
+
+    /**
+     * @brief Subdivide a node recursively and compute the total mass and center of mass of it and its children.
+     *
+     * @param nodeIndex Index of the node in nodes.
+     * @param depth Depth of the node.
+     */
+    void buildNode(int nodeIndex, int depth);
+
+public:
+    /**
+     * @brief Create an empty octree.
+     *
+     * @param leafSize Maximal number of particles stored in one leaf.
+     */
+    explicit Octree(size_t leafSize = 1);
+
+    /**
+     * @brief Build the tree from scratch for the given particles.
+     *
+     * @param begin Iterator to the first particle.
+     * @param end Iterator behind the last particle.
+     */
+    void build(std::vector<Particle>::iterator begin, std::vector<Particle>::iterator end);
+
+    /**
+     * @brief Compute the gravitational force all other particles exert on a particle.
+     *
+     * @param target Particle on which the force acts. Has to be part of the tree.
+     * @param gravity Gravitational force used for the interaction with single particles.
+     * @param theta Opening angle. A node is approximated by its center of mass, if its edge length divided by the
+     *              distance to its center of mass is smaller than theta. For theta = 0 the exact force is computed.
+     *
+     * @return Force acting on the target.
+     */
+    std::array<double, 3> computeForce(Particle &target, Gravity &gravity, double theta);
+
+    /**
+     * @brief Get the number of nodes of the tree.
+     *
+     * @return Number of nodes.
+     */
+    [[nodiscard]] size_t getNumberOfNodes() const {
+        return nodes.size();
+    }
+};
@@ -4,15 +4,50 @@
 
 #include "DirectSum.h"
 
-DirectSum::DirectSum(Force &force, double deltaT, FileHandler::outputFormat outputFormat, bool gravityOn, double g) : Model(
-    particles, force, deltaT, outputFormat, gravityOn, g) {
+#include <limits>
+
+#include "profiling/PhaseTimers.h"
+
+DirectSum::DirectSum(Force &force, double deltaT, FileHandler::outputFormat outputFormat, bool gravityOn, double g,
+                     int threads) : Model(particles, force, deltaT, outputFormat, gravityOn, g) {
+    particles.setThreads(threads);
 }
 
 void DirectSum::step() {
-    updateForces();
-    if(gravityOn) {
+    {
+        PHASE_TIMER(Phase::forces);
+        updateForces();
+    }
+    if (gravityOn) {
+        PHASE_TIMER(Phase::gravity);
         applyGravity();
     }
-    updateVelocities();
-    updatePositions();
+    {
+        PHASE_TIMER(Phase::velocities);
+        calculateVelocities(particles);
+    }
+    {
+        PHASE_TIMER(Phase::positions);
+        calculatePositions(particles);
+    }
+}
+
+void DirectSum::updateForces() {
+    //Before calculating the new forces, the current forces have to be reset.
+    particles.forEachParticle([](Particle &p) {
+        p.resetForce();
+    });
+    //There is no cut-off radius in the direct sum, all pairs of particles interact
+    constexpr double rCutOff = std::numeric_limits<double>::infinity();
+    //The forces are called once per pair of tiles, so the virtual calls do not matter
+    particles.applyForcesToAllUniqueTilePairs([this](ParticleSoA &tile) {
+        force.computeWithinCellSoA(tile, rCutOff);
+    }, [this](ParticleSoA &tileI, ParticleSoA &tileJ) {
+        force.computeBetweenCellsSoA(tileI, tileJ, rCutOff);
+    });
+}
+
+unsigned long long DirectSum::countPairInteractions() {
+    const unsigned long long n = particles.size();
+    return n * (n - (n > 0 ? 1 : 0)) / 2;
 }
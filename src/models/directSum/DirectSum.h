@@ -26,11 +26,25 @@ public:
      * @param outputFormat Output format.
      * @param gravityOn Toggle gravity on or off.
      * @param g Gravitational factor g.
+     * @param threads Number of threads used for the force calculation. If set to 1, the force calculation runs serially.
      */
-    DirectSum(Force &force, double deltaT, FileHandler::outputFormat outputFormat, bool gravityOn, double g = 1);
+    DirectSum(Force &force, double deltaT, FileHandler::outputFormat outputFormat, bool gravityOn, double g = 1,
+              int threads = 1);
 
     /**
      * @brief Perform one time step in the direct sum model.
      */
     void step() override;
+
+    /**
+     * @brief Calculate the forces between all particles with the structure of arrays kernels of the force, tile by tile.
+     */
+    void updateForces() override;
+
+    /**
+     * @brief Count the pairs of particles, which all interact with each other.
+     *
+     * @return Number of unique pairs.
+     */
+    [[nodiscard]] unsigned long long countPairInteractions() override;
 };
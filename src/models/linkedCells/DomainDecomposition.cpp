@@ -0,0 +1,363 @@
+#ifdef MOLSIM_WITH_MPI
+
+#include "DomainDecomposition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+namespace {
+    //Number of doubles per particle in the messages. Copies for the ghost layer only need their position and the
+    //properties used by the force calculation (x, m, type, epsilon, sigma, parameter type), migrating particles their
+    //whole state (x, v, f, old_f, m, type, epsilon, sigma, parameter type). The parameter types are registered in the
+    //same order on all processes (see Model::registerParameterTypes()), so they can be assigned without a lookup.
+    constexpr size_t ghostRecordSize = 8;
+    constexpr size_t migrationRecordSize = 17;
+
+    void appendProperties(std::vector<double> &buffer, const Particle &p) {
+        buffer.push_back(p.getM());
+        buffer.push_back(p.getType());
+        buffer.push_back(p.getEpsilon());
+        buffer.push_back(p.getSigma());
+        buffer.push_back(p.getParameterType());
+    }
+}
+
+DomainDecomposition::DomainDecomposition(MPI_Comm communicator, std::array<double, 3> domainSize, double rCutOff,
+                                         BoundarySet boundaries) : grid{MPI_COMM_NULL}, processGrid{0, 0, 0},
+                                                                   coordinates{0, 0, 0}, domainSize{domainSize},
+                                                                   origin{0, 0, 0},
+                                                                   subdomainSize{domainSize}, remoteSides{} {
+    twoD = std::fpclassify(domainSize[2]) == FP_ZERO;
+    const int dimensions = twoD ? 2 : 3;
+
+    //Along dimensions with periodic boundaries, the process grid wraps around
+    std::array<std::pair<BoundaryCondition, BoundaryCondition>, 3> sides{
+        std::pair{boundaries.left, boundaries.right}, std::pair{boundaries.front, boundaries.back},
+        std::pair{boundaries.bottom, boundaries.top}
+    };
+    std::array<int, 3> periodic{0, 0, 0};
+    for (int dim = 0; dim < dimensions; dim++) {
+        bool lowPeriodic = sides[dim].first == BoundaryCondition::periodic;
+        bool highPeriodic = sides[dim].second == BoundaryCondition::periodic;
+        if (lowPeriodic != highPeriodic) {
+            throw std::invalid_argument("Periodic boundaries have to be set on both opposite sides of the domain");
+        }
+        periodic[dim] = lowPeriodic;
+    }
+
+    MPI_Comm_size(communicator, &processes);
+    if (twoD) {
+        processGrid[2] = 1;
+    }
+    MPI_Dims_create(processes, 3, processGrid.data());
+    //The ranks are kept, so the output files of each process can be related to the processes of the communicator
+    MPI_Cart_create(communicator, 3, processGrid.data(), periodic.data(), 0, &grid);
+    MPI_Comm_rank(grid, &rank);
+    MPI_Cart_coords(grid, rank, 3, coordinates.data());
+
+    //All subdomains have the same size, so they are divided into the same number of cells
+    for (int dim = 0; dim < dimensions; dim++) {
+        subdomainSize[dim] = domainSize[dim] / processGrid[dim];
+        origin[dim] = lowerCorner(dim, coordinates[dim]);
+        if (subdomainSize[dim] < rCutOff) {
+            MPI_Comm_free(&grid);
+            throw std::invalid_argument("The subdomains of " + std::to_string(processes) +
+                                        " processes are smaller than the cut-off radius");
+        }
+    }
+
+    //A side is remote, if there is another process behind it
+    const std::array<std::pair<Side, Side>, 3> sidesOfDimension{
+        std::pair{Side::left, Side::right}, std::pair{Side::front, Side::back}, std::pair{Side::bottom, Side::top}
+    };
+    for (int dim = 0; dim < dimensions; dim++) {
+        int low, high;
+        MPI_Cart_shift(grid, dim, 1, &low, &high);
+        remoteSides[static_cast<int>(sidesOfDimension[dim].first)] = low != MPI_PROC_NULL && low != rank;
+        remoteSides[static_cast<int>(sidesOfDimension[dim].second)] = high != MPI_PROC_NULL && high != rank;
+    }
+
+    //One channel for each direct neighbour in the process grid
+    auto rankAt = [this, &periodic](std::array<int, 3> position) {
+        for (int dim = 0; dim < 3; dim++) {
+            if (position[dim] < 0 || position[dim] >= processGrid[dim]) {
+                if (!periodic[dim]) {
+                    return MPI_PROC_NULL;
+                }
+                position[dim] = (position[dim] + processGrid[dim]) % processGrid[dim];
+            }
+        }
+        int neighbourRank;
+        MPI_Cart_rank(grid, position.data(), &neighbourRank);
+        return neighbourRank;
+    };
+    for (int z = twoD ? 0 : -1; z <= (twoD ? 0 : 1); z++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int x = -1; x <= 1; x++) {
+                if (x == 0 && y == 0 && z == 0) {
+                    continue;
+                }
+                Channel channel;
+                channel.offset = {x, y, z};
+                channel.neighbour = rankAt({coordinates[0] + x, coordinates[1] + y, coordinates[2] + z});
+                channel.opposite = rankAt({coordinates[0] - x, coordinates[1] - y, coordinates[2] - z});
+                //Along dimensions with only one process, the neighbour is this process itself. Its cells are part of
+                //the periodic ghost layer of the container.
+                if (channel.neighbour == rank) {
+                    channel.neighbour = MPI_PROC_NULL;
+                    channel.opposite = MPI_PROC_NULL;
+                }
+                channel.shift = {0, 0, 0};
+                for (int dim = 0; dim < 3; dim++) {
+                    if (channel.offset[dim] == 1 && coordinates[dim] == processGrid[dim] - 1) {
+                        channel.shift[dim] = domainSize[dim];
+                    } else if (channel.offset[dim] == -1 && coordinates[dim] == 0) {
+                        channel.shift[dim] = -domainSize[dim];
+                    }
+                }
+                channelIndices[channelKey(channel.offset)] = static_cast<int>(channels.size());
+                channels.push_back(std::move(channel));
+            }
+        }
+    }
+
+    spdlog::info("Process {} of {} simulates the subdomain [{}] + [{}] of a {} x {} x {} process grid", rank,
+                 processes, ArrayUtils::to_string(origin), ArrayUtils::to_string(subdomainSize), processGrid[0],
+                 processGrid[1], processGrid[2]);
+}
+
+DomainDecomposition::~DomainDecomposition() {
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (!finalized && grid != MPI_COMM_NULL) {
+        MPI_Comm_free(&grid);
+    }
+}
+
+int DomainDecomposition::channelKey(const std::array<int, 3> &offset) {
+    return (offset[0] + 1) + 3 * (offset[1] + 1) + 9 * (offset[2] + 1);
+}
+
+double DomainDecomposition::lowerCorner(int dim, int coordinate) const {
+    return coordinate * subdomainSize[dim];
+}
+
+void DomainDecomposition::connect(LinkedCellsContainer &container) {
+    const std::array<int, 3> n{container.getNX(), container.getNY(), container.getNZ()};
+
+    //Each remote halo cell is a copy of the boundary cell of the neighbour it lies in. Its index is the same in all
+    //subdomains, because all of them are divided into the same cells.
+    for (auto &channel: channels) {
+        channel.requestedCells.clear();
+        channel.sendBuffer.clear();
+    }
+    for (int haloCell: container.getRemoteGhostCells()) {
+        auto cell = container.oneDToThreeD(haloCell);
+        std::array<int, 3> offset{0, 0, 0};
+        auto source = cell;
+        for (int dim = 0; dim < (twoD ? 2 : 3); dim++) {
+            if (cell[dim] == 0) {
+                offset[dim] = -1;
+                source[dim] = n[dim] - 2;
+            } else if (cell[dim] == n[dim] - 1) {
+                offset[dim] = 1;
+                source[dim] = 1;
+            }
+        }
+        auto &channel = channels[channelIndices[channelKey(offset)]];
+        channel.requestedCells.push_back(haloCell);
+        channel.sendBuffer.push_back(container.threeDToOneD(source[0], source[1], source[2]));
+    }
+    communicate(requestTag, true);
+    for (auto &channel: channels) {
+        channel.requestedCounts.assign(channel.requestedCells.size(), 0);
+        channel.providedCells.assign(channel.receiveBuffer.begin(), channel.receiveBuffer.end());
+    }
+}
+
+void DomainDecomposition::exchangeGhostParticles(LinkedCellsContainer &container) {
+    auto &cells = container.getCells();
+    for (auto &channel: channels) {
+        channel.sendBuffer.clear();
+        channel.providedParticles.clear();
+        for (int cell: channel.providedCells) {
+            channel.sendBuffer.push_back(static_cast<double>(cells[cell].size()));
+            for (auto &p: cells[cell]) {
+                channel.sendBuffer.insert(channel.sendBuffer.end(), p.getX().begin(), p.getX().end());
+                appendProperties(channel.sendBuffer, p);
+                channel.providedParticles.push_back(&p);
+            }
+        }
+    }
+    communicate(ghostTag, false);
+    for (auto &channel: channels) {
+        const double *record = channel.receiveBuffer.data();
+        for (size_t i = 0; i < channel.requestedCells.size(); i++) {
+            auto count = static_cast<size_t>(*record++);
+            channel.requestedCounts[i] = count;
+            for (size_t j = 0; j < count; j++, record += ghostRecordSize) {
+                Particle &ghost = container.appendGhostParticle(channel.requestedCells[i]);
+                ghost.setX(std::array<double, 3>{record[0], record[1], record[2]} + channel.shift);
+                ghost.setProperties(record[3], static_cast<int>(record[4]), record[5], record[6]);
+                ghost.setParameterType(static_cast<int>(record[7]));
+            }
+        }
+    }
+}
+
+void DomainDecomposition::returnGhostForces(LinkedCellsContainer &container) {
+    auto &cells = container.getCells();
+    for (auto &channel: channels) {
+        channel.sendBuffer.clear();
+        //The copies are the last particles of their halo cells
+        for (size_t i = 0; i < channel.requestedCells.size(); i++) {
+            auto &halo = cells[channel.requestedCells[i]];
+            for (size_t j = halo.size() - channel.requestedCounts[i]; j < halo.size(); j++) {
+                channel.sendBuffer.insert(channel.sendBuffer.end(), halo[j].getF().begin(), halo[j].getF().end());
+            }
+        }
+    }
+    communicate(forceTag, true);
+    for (auto &channel: channels) {
+        const double *force = channel.receiveBuffer.data();
+        for (Particle *p: channel.providedParticles) {
+            p->setF(p->getF() + std::array<double, 3>{force[0], force[1], force[2]});
+            force += 3;
+        }
+    }
+}
+
+void DomainDecomposition::migrateParticles(LinkedCellsContainer &container) {
+    leaving.clear();
+    container.extractHaloParticles(leaving);
+    for (auto &channel: channels) {
+        channel.sendBuffer.clear();
+    }
+
+    const std::array<std::pair<Side, Side>, 3> sidesOfDimension{
+        std::pair{Side::left, Side::right}, std::pair{Side::front, Side::back}, std::pair{Side::bottom, Side::top}
+    };
+    for (auto &p: leaving) {
+        //Direction of the neighbour, only along sides shared with other subdomains. All other halo cells have
+        //already been processed according to their boundary conditions.
+        std::array<int, 3> offset{0, 0, 0};
+        std::array<double, 3> x = p.getX();
+        for (int dim = 0; dim < (twoD ? 2 : 3); dim++) {
+            if (x[dim] < origin[dim] && remoteSides[static_cast<int>(sidesOfDimension[dim].first)]) {
+                offset[dim] = -1;
+            } else if (x[dim] >= origin[dim] + subdomainSize[dim]
+                       && remoteSides[static_cast<int>(sidesOfDimension[dim].second)]) {
+                offset[dim] = 1;
+            }
+        }
+        if (offset == std::array<int, 3>{0, 0, 0}) {
+            container.add(p);
+            continue;
+        }
+
+        for (int dim = 0; dim < 3; dim++) {
+            if (offset[dim] == 0) {
+                continue;
+            }
+            //Across periodic boundaries, the position is moved to the opposite side of the domain
+            int target = coordinates[dim] + offset[dim];
+            if (target < 0) {
+                target += processGrid[dim];
+                x[dim] += domainSize[dim];
+            } else if (target >= processGrid[dim]) {
+                target -= processGrid[dim];
+                x[dim] -= domainSize[dim];
+            }
+            //Keep the particle inside the subdomain of the neighbour, even if the bounds of both subdomains differ
+            //by rounding errors or the particle was faster than one subdomain per step
+            const double lower = lowerCorner(dim, target);
+            const double upper = lower + subdomainSize[dim];
+            x[dim] = std::clamp(x[dim], lower, std::nextafter(upper, lower));
+        }
+
+        auto &buffer = channels[channelIndices[channelKey(offset)]].sendBuffer;
+        buffer.insert(buffer.end(), x.begin(), x.end());
+        for (const auto *vector: {&p.getV(), &p.getF(), &p.getOldF()}) {
+            buffer.insert(buffer.end(), vector->begin(), vector->end());
+        }
+        appendProperties(buffer, p);
+    }
+
+    communicate(migrationTag, true);
+    for (auto &channel: channels) {
+        for (size_t i = 0; i < channel.receiveBuffer.size(); i += migrationRecordSize) {
+            const double *record = channel.receiveBuffer.data() + i;
+            Particle p{{record[0], record[1], record[2]}, {record[3], record[4], record[5]}, record[12],
+                       static_cast<int>(record[13]), record[14], record[15]};
+            p.setF({record[6], record[7], record[8]});
+            p.setOldF({record[9], record[10], record[11]});
+            p.setParameterType(static_cast<int>(record[16]));
+            container.add(p);
+        }
+    }
+}
+
+void DomainDecomposition::sum(std::vector<double> &values) const {
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), static_cast<int>(values.size()), MPI_DOUBLE, MPI_SUM, grid);
+}
+
+void DomainDecomposition::gather(std::vector<double> &values) const {
+    int count = static_cast<int>(values.size());
+    std::vector<int> counts(processes);
+    MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, grid);
+    std::vector<int> displacements(processes, 0);
+    for (int i = 1; i < processes; i++) {
+        displacements[i] = displacements[i - 1] + counts[i - 1];
+    }
+    std::vector<double> all(displacements.back() + counts.back());
+    MPI_Allgatherv(values.data(), count, MPI_DOUBLE, all.data(), counts.data(), displacements.data(), MPI_DOUBLE,
+                   grid);
+    values = std::move(all);
+}
+
+int DomainDecomposition::getNumberOfWorldProcesses() {
+    int initialized;
+    MPI_Initialized(&initialized);
+    if (!initialized) {
+        return 1;
+    }
+    int worldProcesses;
+    MPI_Comm_size(MPI_COMM_WORLD, &worldProcesses);
+    return worldProcesses;
+}
+
+void DomainDecomposition::communicate(int tag, bool forward) {
+    std::vector<MPI_Request> requests;
+    requests.reserve(channels.size());
+    for (size_t k = 0; k < channels.size(); k++) {
+        auto &channel = channels[k];
+        int target = forward ? channel.neighbour : channel.opposite;
+        if (target != MPI_PROC_NULL) {
+            requests.emplace_back();
+            MPI_Isend(channel.sendBuffer.data(), static_cast<int>(channel.sendBuffer.size()), MPI_DOUBLE, target,
+                      tag + static_cast<int>(k), grid, &requests.back());
+        }
+    }
+    for (size_t k = 0; k < channels.size(); k++) {
+        auto &channel = channels[k];
+        int source = forward ? channel.opposite : channel.neighbour;
+        channel.receiveBuffer.clear();
+        if (source == MPI_PROC_NULL) {
+            continue;
+        }
+        //The size of the message is only known to the sender
+        MPI_Status status;
+        MPI_Probe(source, tag + static_cast<int>(k), grid, &status);
+        int count;
+        MPI_Get_count(&status, MPI_DOUBLE, &count);
+        channel.receiveBuffer.resize(count);
+        MPI_Recv(channel.receiveBuffer.data(), count, MPI_DOUBLE, source, tag + static_cast<int>(k), grid,
+                 MPI_STATUS_IGNORE);
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+#endif
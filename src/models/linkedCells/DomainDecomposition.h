@@ -0,0 +1,216 @@
+#pragma once
+
+#ifdef MOLSIM_WITH_MPI
+
+#include <array>
+#include <mpi.h>
+#include <vector>
+
+#include "particleRepresentation/container/linkedCellsContainer/LinkedCellsContainer.h"
+#include "utils/enumsStructs.h"
+
+/**
+ * @brief Splits the domain of the linked cells model into equally sized subdomains, one per MPI process.
+ *
+ * The processes are arranged in a cartesian grid, which is periodic along dimensions with periodic boundaries. Each
+ * process stores the particles of its subdomain in its own LinkedCellsContainer, whose sides shared with another
+ * subdomain are marked as remote. Each step, the processes
+ * - fill the remote halo cells of the ghost layer with copies of the particles of their neighbours,
+ * - send the forces acting on these copies back to the processes owning the particles and
+ * - hand the particles that have left their subdomain over to the neighbour they have moved to.
+ *
+ * Only the 26 (3D) or 8 (2D) direct neighbours are contacted, so a subdomain has to be at least as large as the
+ * cut-off radius in each dimension. Periodic boundaries across the edge of the simulation domain are handled like
+ * any other side between two subdomains, except that the positions are shifted by the size of the domain.
+ */
+class DomainDecomposition {
+public:
+    /**
+     * @brief Create the process grid and determine the subdomain of this process. Collective over the communicator.
+     *
+     * @param communicator Communicator of all processes sharing the simulation.
+     * @param domainSize Size of the simulation domain.
+     * @param rCutOff Cut-off radius.
+     * @param boundaries Boundary conditions of the simulation domain.
+     *
+     * @throws std::invalid_argument If a subdomain would be smaller than the cut-off radius.
+     */
+    DomainDecomposition(MPI_Comm communicator, std::array<double, 3> domainSize, double rCutOff,
+                        BoundarySet boundaries);
+
+    /**
+     * @brief Free the communicator of the process grid.
+     */
+    ~DomainDecomposition();
+
+    DomainDecomposition(const DomainDecomposition &) = delete;
+
+    DomainDecomposition &operator=(const DomainDecomposition &) = delete;
+
+    /**
+     * @brief Determine, which cells have to be exchanged with the neighbours each step. Collective over all processes.
+     *
+     * @param container Container holding the subdomain of this process (see getOrigin(), getSubdomainSize() and
+     *                  getRemoteSides()).
+     */
+    void connect(LinkedCellsContainer &container);
+
+    /**
+     * @brief Fill the remote halo cells of the ghost layer with copies of the particles of the neighbours.
+     *
+     * Has to be called after LinkedCellsContainer::createGhostParticles().
+     *
+     * @param container Container holding the subdomain of this process.
+     */
+    void exchangeGhostParticles(LinkedCellsContainer &container);
+
+    /**
+     * @brief Send the forces acting on the copies of the remote halo cells back and add the forces received from the
+     *        neighbours to the particles of this subdomain.
+     *
+     * Has to be called after the force calculation and before LinkedCellsContainer::removeGhostParticles().
+     *
+     * @param container Container holding the subdomain of this process.
+     */
+    void returnGhostForces(LinkedCellsContainer &container);
+
+    /**
+     * @brief Hand all particles which are still in the halo cells over to the neighbour they have moved to and add the
+     *        particles received from the neighbours.
+     *
+     * Has to be called after the halo cells at the boundaries of the simulation domain have been processed.
+     *
+     * @param container Container holding the subdomain of this process.
+     */
+    void migrateParticles(LinkedCellsContainer &container);
+
+    /**
+     * @brief Sum values over all processes.
+     *
+     * @param values Values of this process, replaced by the sums.
+     */
+    void sum(std::vector<double> &values) const;
+
+    /**
+     * @brief Concatenate values over all processes in the order of their ranks.
+     *
+     * @param values Values of this process, replaced by the values of all processes.
+     */
+    void gather(std::vector<double> &values) const;
+
+    /**
+     * @brief Get the number of processes on which MPI_COMM_WORLD runs.
+     *
+     * @return Number of processes, or 1 if MPI is not initialised.
+     */
+    static int getNumberOfWorldProcesses();
+
+    [[nodiscard]] int getRank() const {
+        return rank;
+    }
+
+    [[nodiscard]] int getNumberOfProcesses() const {
+        return processes;
+    }
+
+    [[nodiscard]] std::array<int, 3> getProcessGrid() const {
+        return processGrid;
+    }
+
+    [[nodiscard]] std::array<double, 3> getOrigin() const {
+        return origin;
+    }
+
+    [[nodiscard]] std::array<double, 3> getSubdomainSize() const {
+        return subdomainSize;
+    }
+
+    [[nodiscard]] std::array<bool, 6> getRemoteSides() const {
+        return remoteSides;
+    }
+
+private:
+    /**
+     * @brief Connection to the neighbour in one direction of the process grid.
+     *
+     * Every message of a channel uses the index of the channel as tag, so that a process that is the neighbour in
+     * several directions (e.g. with two processes along a periodic dimension) can tell the messages apart.
+     */
+    struct Channel {
+        //Direction of the neighbour in the process grid
+        std::array<int, 3> offset;
+        //Rank of the neighbour at offset and -offset. Both are MPI_PROC_NULL, if there is nothing to exchange.
+        int neighbour;
+        int opposite;
+        //Remote halo cells of this process filled by the neighbour at offset, in the order of the messages
+        std::vector<int> requestedCells;
+        //Number of copies appended to each requested cell
+        std::vector<size_t> requestedCounts;
+        //Offset added to the positions of the copies, if they are taken from across a periodic boundary
+        std::array<double, 3> shift;
+        //Cells of this process whose particles are sent to the neighbour at -offset, in the order of the messages
+        std::vector<int> providedCells;
+        //Particles sent to the neighbour at -offset, in the order of the messages
+        std::vector<Particle *> providedParticles;
+        //Buffers of the messages, kept between steps to avoid allocations
+        std::vector<double> sendBuffer;
+        std::vector<double> receiveBuffer;
+    };
+
+    //Tags of the different kinds of messages. A tag is increased by the index of the channel.
+    static constexpr int requestTag = 0;
+    static constexpr int ghostTag = 32;
+    static constexpr int forceTag = 64;
+    static constexpr int migrationTag = 96;
+
+    //Cartesian communicator of the process grid
+    MPI_Comm grid;
+    int rank;
+    int processes;
+    std::array<int, 3> processGrid;
+    std::array<int, 3> coordinates;
+    bool twoD;
+
+    std::array<double, 3> domainSize;
+    std::array<double, 3> origin;
+    std::array<double, 3> subdomainSize;
+    std::array<bool, 6> remoteSides;
+
+    std::vector<Channel> channels;
+
+    //Index of the channel of each direction (see channelKey())
+    std::array<int, 27> channelIndices{};
+
+    //Particles leaving the subdomain, kept between steps to avoid allocations
+    std::vector<Particle> leaving;
+
+    /**
+     * @brief Map a direction in the process grid to an index into channelIndices.
+     *
+     * @param offset Direction with components -1, 0 or 1.
+     *
+     * @return Index into channelIndices.
+     */
+    static int channelKey(const std::array<int, 3> &offset);
+
+    /**
+     * @brief Calculate the lower corner of a subdomain along one dimension.
+     *
+     * @param dim Dimension.
+     * @param coordinate Coordinate of the subdomain in the process grid.
+     *
+     * @return Lower corner of the subdomain.
+     */
+    [[nodiscard]] double lowerCorner(int dim, int coordinate) const;
+
+    /**
+     * @brief Send the send buffers of all channels and receive the receive buffers.
+     *
+     * @param tag Tag of the messages.
+     * @param forward If true, the buffers are sent to the neighbour at offset and received from the neighbour at
+     *                -offset. Otherwise the other way around.
+     */
+    void communicate(int tag, bool forward);
+};
+
+#endif
@@ -4,25 +4,80 @@
 
 #include "LinkedCells.h"
 
+#include "profiling/PhaseTimers.h"
+
+#ifdef MOLSIM_WITH_MPI
+#include "DomainDecomposition.h"
+#endif
+
+namespace {
+    /**
+     * @brief Part of the domain stored by the container of this process.
+     */
+    struct Subdomain {
+        std::array<double, 3> size;
+        std::array<double, 3> origin;
+        std::array<bool, 6> remoteSides;
+    };
+
+    Subdomain subdomainOf([[maybe_unused]] const std::shared_ptr<DomainDecomposition> &decomposition,
+                          std::array<double, 3> domainSize) {
+#ifdef MOLSIM_WITH_MPI
+        if (decomposition) {
+            return {decomposition->getSubdomainSize(), decomposition->getOrigin(), decomposition->getRemoteSides()};
+        }
+#endif
+        return {domainSize, {0, 0, 0}, {}};
+    }
+}
+
 LinkedCells::LinkedCells(Force &force, double deltaT, std::array<double, 3> domainSize,
                          double rCutOff, FileHandler::outputFormat outputFormat,
-                         BoundarySet boundaryConditions, bool gravityOn, double g) : Model(particles, force, deltaT,
-        outputFormat, gravityOn, g),
-    particles(domainSize, rCutOff, boundaryConditions) {
-    std::pair<Side, BoundaryCondition> cFront{Side::front, boundaryConditions.front};
-    boundarySettings.push_back(cFront);
-    std::pair<Side, BoundaryCondition> cRight{Side::right, boundaryConditions.right};
-    boundarySettings.push_back(cRight);
-    std::pair<Side, BoundaryCondition> cBack{Side::back, boundaryConditions.back};
-    boundarySettings.push_back(cBack);
-    std::pair<Side, BoundaryCondition> cLeft{Side::left, boundaryConditions.left};
-    boundarySettings.push_back(cLeft);
+                         BoundarySet boundaryConditions, bool gravityOn, double g, ParticleLayout layout,
+                         double verletSkin, int threads, ParallelStrategy parallelStrategy,
+                         CellOrdering cellOrdering, int sortInterval,
+                         std::shared_ptr<DomainDecomposition> decomposition) : Model(particles, force,
+        deltaT, outputFormat, gravityOn, g),
+    particles(subdomainOf(decomposition, domainSize).size, rCutOff, boundaryConditions, layout, verletSkin, threads,
+              parallelStrategy, cellOrdering, subdomainOf(decomposition, domainSize).origin,
+              subdomainOf(decomposition, domainSize).remoteSides),
+    decomposition{std::move(decomposition)}, sortInterval{sortInterval}, stepsSinceSort{0} {
+    if (sortInterval < 0) {
+        throw std::invalid_argument("Sort interval is less than 0");
+    }
+    //Sides shared with other subdomains are no boundaries of the simulation domain
+    auto remoteSides = particles.getRemoteSides();
+    auto addSetting = [this, &remoteSides](Side side, BoundaryCondition condition) {
+        if (!remoteSides[static_cast<int>(side)]) {
+            boundarySettings.emplace_back(side, condition);
+        }
+    };
+    addSetting(Side::front, boundaryConditions.front);
+    addSetting(Side::right, boundaryConditions.right);
+    addSetting(Side::back, boundaryConditions.back);
+    addSetting(Side::left, boundaryConditions.left);
     if (!particles.isTwoD()) {
-        std::pair<Side, BoundaryCondition> cTop{Side::top, boundaryConditions.top};
-        boundarySettings.push_back(cTop);
-        std::pair<Side, BoundaryCondition> cBottom{Side::bottom, boundaryConditions.bottom};
-        boundarySettings.push_back(cBottom);
+        addSetting(Side::top, boundaryConditions.top);
+        addSetting(Side::bottom, boundaryConditions.bottom);
     }
+
+    if (particles.useVerletLists()) {
+        //The copies of the particles of other subdomains are received anew every step and are not part of the lists
+        if (this->decomposition) {
+            throw std::invalid_argument("Verlet lists cannot be used together with a domain decomposition.");
+        }
+        //The Verlet lists store particles, not cells, so the kernels of the structure of arrays layout cannot be used
+        if (layout == ParticleLayout::soa) {
+            throw std::invalid_argument("Verlet lists cannot be used together with the structure of arrays layout.");
+        }
+        spdlog::info("Using Verlet lists with skin radius {}", verletSkin);
+    }
+
+#ifdef MOLSIM_WITH_MPI
+    if (this->decomposition) {
+        this->decomposition->connect(particles);
+    }
+#endif
 }
 
 void LinkedCells::processBoundaryForces() {
@@ -32,20 +87,16 @@ void LinkedCells::processBoundaryForces() {
             case BoundaryCondition::outflow: //Outflow boundaries do not apply forces
                 break;
             case BoundaryCondition::reflective: {
-                particles.applyToAllBoundaryParticles([this](Particle &p, std::array<double, 3> &ghostPosition) {
-                    //Add force from an imaginary ghost particle to particle p
-                    Particle ghostParticle = p;
-                    ghostParticle.setX(ghostPosition);
-                    std::array<double, 3> ghostForce = force.compute(p, ghostParticle);
-                    p.setF(p.getF() + ghostForce);
-                }, setting.first);
-            }
-            break;
-            case BoundaryCondition::periodic: {
-                //Add forces from particles of adjacent boundary cells from the opposite side.
-                particles.applyForcesFromOppositeSide(setting.first);
+                //The wall acts like a ghost particle mirrored at the wall, but only along its normal
+                dispatchForce(force, [this, &setting](auto &concreteForce) {
+                    particles.applyWallForces([&concreteForce](Particle &p, double distance) {
+                        return concreteForce.computeWall(p, distance);
+                    }, setting.first);
+                });
             }
             break;
+            case BoundaryCondition::periodic: //Forces across periodic boundaries are part of updateForces
+                break;
             case BoundaryCondition::invalid: {
                 throw std::invalid_argument("Invalid Boundary Condition was selected.");
             };
@@ -75,27 +126,174 @@ void LinkedCells::processHaloCells() {
     }
 }
 
+void LinkedCells::updateForces() {
+    //Pairs across periodic boundaries and other subdomains are handled by the images in the ghost layer
+    particles.createGhostParticles();
+#ifdef MOLSIM_WITH_MPI
+    if (decomposition) {
+        decomposition->exchangeGhostParticles(particles);
+    }
+#endif
+    calculatePairForces();
+#ifdef MOLSIM_WITH_MPI
+    if (decomposition) {
+        decomposition->returnGhostForces(particles);
+    }
+#endif
+    particles.removeGhostParticles();
+}
+
+void LinkedCells::calculatePairForces() {
+    if (particles.useVerletLists()) {
+        //The displacements only have to be checked again, if the positions have changed since step() checked them
+        if (!(verletListsChecked && particles.areVerletListsBuilt()) && particles.areVerletListsOutdated()) {
+            particles.buildVerletLists();
+        }
+        verletListsChecked = false;
+        //Before calculating the new forces, the current forces have to be reset.
+        particles.forEachParticleInDomain([](Particle &p) {
+            p.resetForce();
+        });
+        dispatchForce(force, [this](auto &concreteForce) {
+            particles.applyForcesToAllVerletPairs([&concreteForce](Particle &p_i, Particle &p_j,
+                                                                   std::array<double, 3> &difference, double distance) {
+                return concreteForce.computeOptimized(p_i, p_j, difference, distance);
+            });
+        });
+        return;
+    }
+    if (particles.getLayout() == ParticleLayout::aos) {
+        if (particles.getThreads() == 1) {
+            dispatchForce(force, [this](auto &concreteForce) {
+                calculateForces(particles, concreteForce);
+            });
+            return;
+        }
+        //Before calculating the new forces, the current forces have to be reset.
+        particles.forEachParticleInDomain([](Particle &p) {
+            p.resetForce();
+        });
+        dispatchForce(force, [this](auto &concreteForce) {
+            particles.applyForcesToAllUniquePairsInDomainParallel([&concreteForce](Particle &p_i, Particle &p_j) {
+                return concreteForce.compute(p_i, p_j);
+            });
+        });
+        return;
+    }
+    //Before calculating the new forces, the current forces have to be reset.
+    particles.forEachParticleInDomain([](Particle &p) {
+        p.resetForce();
+    });
+    double rCutOff = particles.getRCutOff();
+    particles.loadSoA();
+    particles.applyToAllUniqueCellPairsInDomainSoA([this, rCutOff](ParticleSoA &cell) {
+        force.computeWithinCellSoA(cell, rCutOff);
+    }, [this, rCutOff](ParticleSoA &cell1, ParticleSoA &cell2) {
+        force.computeBetweenCellsSoA(cell1, cell2, rCutOff);
+    });
+    particles.extractSoA();
+}
+
 void LinkedCells::step() {
-    updateForces();
+    {
+        PHASE_TIMER(Phase::forces);
+        updateForces();
+    }
     if (gravityOn) {
+        PHASE_TIMER(Phase::gravity);
         applyGravity();
     }
-    processBoundaryForces();
-    updateVelocities();
-    updatePositions();
-    particles.updateCells();
-    processHaloCells();
+    {
+        PHASE_TIMER(Phase::boundaries);
+        processBoundaryForces();
+    }
+    {
+        PHASE_TIMER(Phase::velocities);
+        calculateVelocities(particles);
+    }
+    {
+        PHASE_TIMER(Phase::positions);
+        calculatePositions(particles);
+    }
+    //With Verlet lists, the particles are only reassigned to their cells when the lists have to be rebuilt anyway.
+    const bool outdated = !particles.useVerletLists() || particles.areVerletListsOutdated();
+    verletListsChecked = !outdated;
+    if (outdated) {
+        {
+            PHASE_TIMER(Phase::cells);
+            particles.updateCells();
+        }
+        {
+            PHASE_TIMER(Phase::halo);
+            processHaloCells();
+        }
+#ifdef MOLSIM_WITH_MPI
+        //Only particles that have left the subdomain towards another subdomain are left in the halo cells
+        if (decomposition) {
+            PHASE_TIMER(Phase::migration);
+            decomposition->migrateParticles(particles);
+        }
+#endif
+        //Restore the locality of the particle storage from time to time
+        if (sortInterval > 0 && ++stepsSinceSort >= sortInterval) {
+            PHASE_TIMER(Phase::sorting);
+            particles.sortParticles();
+            stepsSinceSort = 0;
+        }
+    }
+}
+
+void LinkedCells::sumOverSubdomains([[maybe_unused]] std::vector<double> &values) const {
+#ifdef MOLSIM_WITH_MPI
+    if (decomposition) {
+        decomposition->sum(values);
+    }
+#endif
+}
+
+void LinkedCells::gatherOverSubdomains([[maybe_unused]] std::vector<double> &values) const {
+#ifdef MOLSIM_WITH_MPI
+    if (decomposition) {
+        decomposition->gather(values);
+    }
+#endif
+}
+
+unsigned long long LinkedCells::countPairInteractions() {
+    unsigned long long pairs = 0;
+    particles.forEachUniquePairInDomainOptimized([&pairs](Particle &, Particle &, std::array<double, 3> &, double) {
+        pairs++;
+    });
+    return pairs;
+}
+
+std::optional<PairStatistics> LinkedCells::collectPairStatistics() {
+    //Fill the ghost layer like the force calculation does
+    particles.createGhostParticles();
+#ifdef MOLSIM_WITH_MPI
+    if (decomposition) {
+        decomposition->exchangeGhostParticles(particles);
+    }
+#endif
+    PairStatistics statistics = particles.collectPairStatistics();
+    particles.removeGhostParticles();
+    return statistics;
 }
 
 void LinkedCells::updateForcesOptimized() {
+    particles.createGhostParticles();
     //Before calculating the new forces, the current forces have to be reset.
-    particles.applyToEachParticleInDomain([](Particle &p) {
+    particles.forEachParticleInDomain([](Particle &p) {
         p.resetForce();
     });
     //Calculate new forces using Newtons third law of motion
-    particles.applyToAllUniquePairsInDomainOptimized([this](Particle &p_i, Particle &p_j, std::array<double, 3> difference, double distance) {
-        auto f_ij{force.computeOptimized(p_i, p_j, difference, distance)};
-        p_i.setF(p_i.getF() + f_ij);
-        p_j.setF( p_j.getF() - f_ij);
+    dispatchForce(force, [this](auto &concreteForce) {
+        particles.forEachUniquePairInDomainOptimized([&concreteForce](Particle &p_i, Particle &p_j,
+                                                                      std::array<double, 3> &difference, double distance) {
+            auto f_ij{concreteForce.computeOptimized(p_i, p_j, difference, distance)};
+            p_i.setF(p_i.getF() + f_ij);
+            p_j.setF(p_j.getF() - f_ij);
+        });
     });
+    particles.removeGhostParticles();
 }
@@ -3,9 +3,13 @@
 //
 #pragma once
 
+#include <memory>
+
 #include "../Model.h"
 #include "../../particleRepresentation/container/linkedCellsContainer/LinkedCellsContainer.h"
 
+class DomainDecomposition;
+
 /**
  * @brief Model that implements the linked cell algorithm
  *
@@ -25,6 +29,28 @@ private:
      */
     std::vector<std::pair<Side, enumsStructs::BoundaryCondition> > boundarySettings;
 
+    /**
+     * Distribution of the domain over several MPI processes. If set, the container only holds the subdomain of this
+     * process. Only available, if MolSim was built with MPI.
+     */
+    std::shared_ptr<DomainDecomposition> decomposition;
+
+    /**
+     * Number of cell updates between two re-sorts of the particle storage. If set to 0, it is never re-sorted.
+     */
+    int sortInterval;
+
+    /**
+     * Number of cell updates since the last re-sort of the particle storage.
+     */
+    int stepsSinceSort;
+
+    /**
+     * True, if step() has found the Verlet lists up to date after the last update of the positions, so the force
+     * calculation of the next step does not have to check the displacements of all particles again.
+     */
+    bool verletListsChecked = false;
+
     /**
      * @brief Apply forces to all particles in boundary cells according to the specified boundary conditions.
      */
@@ -36,6 +62,11 @@ private:
      */
     void processHaloCells();
 
+    /**
+     * @brief Calculate the forces between all pairs of particles in the domain and the ghost layer.
+     */
+    void calculatePairForces();
+
 public:
     /**
      * @brief Contruct a new Linked Cells model.
@@ -48,15 +79,74 @@ public:
      * @param boundaryConditions Boundary conditions.
      * @param gravityOn Toggle gravity on or off.
      * @param g Gravitational factor.
+     * @param layout Memory layout the particles are processed in during the force calculation.
+     * @param verletSkin Skin radius of the Verlet lists. A value of 0 disables the Verlet lists. Verlet lists cannot be
+     *                   combined with the structure of arrays layout or a domain decomposition.
+     * @param threads Number of threads used for the force calculation.
+     * @param parallelStrategy Strategy to avoid data races between threads when using Newton's third law of motion.
+     * @param cellOrdering Order in which the cells are numbered, stored and processed.
+     * @param sortInterval Number of cell updates between two re-sorts of the particle storage along the cell ordering.
+     *                     A value of 0 disables the re-sorting.
+     * @param decomposition Distribution of the domain over several MPI processes. If set, this model only simulates
+     *                      the subdomain of this process. All processes have to construct their model and call
+     *                      updateForces() and step() together. Particles added outside the subdomain are ignored, so
+     *                      every process can add all particles of the simulation. Cannot be combined with Verlet lists.
      */
     LinkedCells(Force &force, double deltaT, std::array<double, 3> domainSize, double rCutOff,
-                FileHandler::outputFormat outputFormat, BoundarySet boundaryConditions, bool gravityOn, double g = 1);
+                FileHandler::outputFormat outputFormat, BoundarySet boundaryConditions, bool gravityOn, double g = 1,
+                ParticleLayout layout = ParticleLayout::aos, double verletSkin = 0, int threads = 1,
+                ParallelStrategy parallelStrategy = ParallelStrategy::coloring,
+                CellOrdering cellOrdering = CellOrdering::rowMajor, int sortInterval = 0,
+                std::shared_ptr<DomainDecomposition> decomposition = nullptr);
+
+    /**
+     * @brief Calculate the forces between all particles inside the domain.
+     *
+     * For the array of structures layout the generic implementation of the base model is used. For the structure of
+     * arrays layout the particles are mirrored into contiguous per-cell buffers and processed cell pair by cell pair.
+     * If Verlet lists are enabled, they are used instead of both and rebuilt first if they are outdated.
+     * If more than one thread is used, the cells are processed in parallel (the Verlet lists are always processed serially).
+     * Before the calculation, the halo cells across periodic boundaries are filled with images of the particles on the
+     * opposite side. Their forces are added to the original particles afterwards. With a domain decomposition, the halo
+     * cells shared with other subdomains are filled with copies of their particles in the same way.
+     */
+    void updateForces() override;
 
     /**
      * @brief Perform one time step in the linked cells model.
      */
     void step() override;
 
+    /**
+     * @brief Sum values over all subdomains, if the domain is distributed over several MPI processes.
+     *
+     * @param values Values of this subdomain, replaced by the sums.
+     */
+    void sumOverSubdomains(std::vector<double> &values) const override;
+
+    /**
+     * @brief Concatenate values over all subdomains, if the domain is distributed over several MPI processes.
+     *
+     * @param values Values of this subdomain, replaced by the values of all subdomains.
+     */
+    void gatherOverSubdomains(std::vector<double> &values) const override;
+
+    /**
+     * @brief Count the pairs of particles within the cut-off radius. Pairs across periodic boundaries or with particles
+     *        of other subdomains are not counted.
+     *
+     * @return Number of pairs within the cut-off radius.
+     */
+    [[nodiscard]] unsigned long long countPairInteractions() override;
+
+    /**
+     * @brief Collect statistics about the cell traversal. Pairs across periodic boundaries and with particles of other
+     *        subdomains are included, so all processes of a distributed simulation have to call this method together.
+     *
+     * @return Statistics of the current state.
+     */
+    [[nodiscard]] std::optional<PairStatistics> collectPairStatistics() override;
+
     /**
      * @brief Implements the optimization we presented as our second idea.
      *        At the moment this is dead code, because we did not have time yet to make it compatible
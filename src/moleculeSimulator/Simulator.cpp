@@ -4,14 +4,37 @@
 
 #include "Simulator.h"
 
+#include <filesystem>
 #include <iostream>
+#include <sstream>
+
+#include "fileHandling/outputWriter/CheckpointWriter/CheckpointWriter.h"
+#include "fileHandling/reader/CheckpointReader/CheckpointReader.h"
+#include "profiling/MemoryFootprint.h"
+#include "profiling/PairStatistics.h"
+#include "profiling/PhaseTimers.h"
+#include "profiling/Tracer.h"
+#include "utils/MaxwellBoltzmannDistribution.h"
+
+#ifdef MOLSIM_WITH_MPI
+#include "models/linkedCells/DomainDecomposition.h"
+#endif
 
 using namespace enumsStructs;
 
-Simulator::Simulator(SimulationSettings &simulationSettings, FileHandler::outputFormat outputFormat) {
+Simulator::Simulator(SimulationSettings &simulationSettings, FileHandler::outputFormat outputFormat) : resumed{false},
+    startTime{0}, startIteration{0}, currentTime{0}, currentIteration{0}, domainSize{0, 0, 0} {
     //Set model independent parameters
     outputFrequency = simulationSettings.outputFrequency;
     outputFileBaseName = simulationSettings.outputFileName;
+    this->outputFormat = outputFormat;
+
+#ifdef MOLSIM_WITH_MPI
+    const int processes = DomainDecomposition::getNumberOfWorldProcesses();
+    if (processes > 1 && simulationSettings.model != TypeOfModel::linkedCells) {
+        throw std::invalid_argument("Only the linked cells model can be distributed over several MPI processes.");
+    }
+#endif
 
     //Set model dependent parameters
     switch (simulationSettings.model) {
@@ -32,7 +55,8 @@ Simulator::Simulator(SimulationSettings &simulationSettings, FileHandler::output
             deltaT = simulationSettings.parametersDirectSum.deltaT;
             endT = simulationSettings.parametersDirectSum.endT;
             model = std::make_unique<DirectSum>(*force, simulationSettings.parametersDirectSum.deltaT, outputFormat,
-                                                simulationSettings.gravityOn, simulationSettings.gravityFactor);
+                                                simulationSettings.gravityOn, simulationSettings.gravityFactor,
+                                                simulationSettings.parametersDirectSum.threads);
         }
         break;
         case TypeOfModel::linkedCells: {
@@ -51,13 +75,46 @@ Simulator::Simulator(SimulationSettings &simulationSettings, FileHandler::output
             }
             deltaT = simulationSettings.parametersLinkedCells.deltaT;
             endT = simulationSettings.parametersLinkedCells.endT;
+            domainSize = simulationSettings.parametersLinkedCells.domainSize;
+            boundaries = simulationSettings.parametersLinkedCells.boundaryConditions;
+            std::shared_ptr<DomainDecomposition> decomposition;
+#ifdef MOLSIM_WITH_MPI
+            if (processes > 1) {
+                decomposition = std::make_shared<DomainDecomposition>(MPI_COMM_WORLD, domainSize,
+                                                                      simulationSettings.parametersLinkedCells.rCutOff,
+                                                                      boundaries);
+                //Each process writes the particles of its own subdomain
+                rank = decomposition->getRank();
+                rankSuffix = "_rank" + std::to_string(rank);
+                outputFileBaseName += rankSuffix;
+            }
+#endif
             model = std::make_unique<LinkedCells>(*force, simulationSettings.parametersLinkedCells.deltaT,
                                                   simulationSettings.parametersLinkedCells.domainSize,
                                                   simulationSettings.parametersLinkedCells.rCutOff,
                                                   outputFormat,
                                                   simulationSettings.parametersLinkedCells.boundaryConditions,
                                                   simulationSettings.gravityOn,
-                                                  simulationSettings.gravityFactor);
+                                                  simulationSettings.gravityFactor,
+                                                  simulationSettings.parametersLinkedCells.particleLayout,
+                                                  simulationSettings.parametersLinkedCells.verletSkin,
+                                                  simulationSettings.parametersLinkedCells.threads,
+                                                  simulationSettings.parametersLinkedCells.parallelStrategy,
+                                                  simulationSettings.parametersLinkedCells.cellOrdering,
+                                                  simulationSettings.parametersLinkedCells.sortInterval,
+                                                  decomposition);
+        }
+        break;
+        case TypeOfModel::barnesHut: {
+            if (simulationSettings.parametersBarnesHut.force != TypeOfForce::gravity) {
+                throw std::invalid_argument("The Barnes-Hut model only supports the gravitational force.");
+            }
+            force = std::make_unique<Gravity>();
+            deltaT = simulationSettings.parametersBarnesHut.deltaT;
+            endT = simulationSettings.parametersBarnesHut.endT;
+            model = std::make_unique<BarnesHut>(*force, simulationSettings.parametersBarnesHut.deltaT, outputFormat,
+                                                simulationSettings.gravityOn, simulationSettings.gravityFactor,
+                                                simulationSettings.parametersBarnesHut.theta);
         }
         break;
         default: {
@@ -114,7 +171,17 @@ Simulator::Simulator(DirectSumSimulationParameters &parameters, std::string &inp
                      int outputFrequency, std::string &outputFileBaseName) : deltaT{parameters.deltaT},
                                                                              endT{parameters.endT},
                                                                              outputFrequency{outputFrequency},
-                                                                             outputFileBaseName{outputFileBaseName} {
+                                                                             outputFileBaseName{outputFileBaseName},
+                                                                             outputFormat{outputFormat},
+                                                                             resumed{false}, startTime{0},
+                                                                             startIteration{0},
+                                                                             currentTime{0}, currentIteration{0},
+                                                                             domainSize{0, 0, 0} {
+#ifdef MOLSIM_WITH_MPI
+    if (DomainDecomposition::getNumberOfWorldProcesses() > 1) {
+        throw std::invalid_argument("Only the linked cells model can be distributed over several MPI processes.");
+    }
+#endif
     switch (parameters.force) {
         case TypeOfForce::gravity: {
             force = std::make_unique<Gravity>();
@@ -128,7 +195,7 @@ Simulator::Simulator(DirectSumSimulationParameters &parameters, std::string &inp
             throw std::invalid_argument("Invalid Force Type");
         }
     }
-    model = std::make_unique<DirectSum>(*force, parameters.deltaT, outputFormat, false);
+    model = std::make_unique<DirectSum>(*force, parameters.deltaT, outputFormat, false, 1, parameters.threads);
     model->addViaFile(inputFilePath, FileHandler::inputFormat::txt);
 
     //Thermostat is not used
@@ -139,23 +206,127 @@ Simulator::Simulator(DirectSumSimulationParameters &parameters, std::string &inp
     totalMoleculeUpdates = 0;
 }
 
+void Simulator::setAsyncOutput(size_t queueCapacity) {
+    if (queueCapacity == 0) {
+        asyncOutputWriter.reset();
+    } else {
+        asyncOutputWriter = std::make_unique<outputWriter::AsyncOutputWriter>(outputFormat, queueCapacity);
+        asyncOutputWriter->setVTUOptions(vtuPrecision, vtuCompression, vtuPieces);
+    }
+}
+
+void Simulator::setVTUOptions(outputWriter::VTUWriter::Precision precision, bool compress, size_t pieces) {
+    vtuPrecision = precision;
+    vtuCompression = compress;
+    vtuPieces = pieces;
+    model->setVTUOptions(precision, compress, pieces);
+    if (asyncOutputWriter) {
+        asyncOutputWriter->setVTUOptions(precision, compress, pieces);
+    }
+}
+
+void Simulator::setPhaseTimesFile(const std::string &fileName) {
+#ifndef MOLSIM_WITH_PHASE_TIMERS
+    if (!fileName.empty()) {
+        throw std::invalid_argument("Phase times are not available, MolSim was built without MOLSIM_WITH_PHASE_TIMERS.");
+    }
+#endif
+    phaseTimesFile = fileName;
+}
+
+void Simulator::setTraceFile(const std::string &fileName, size_t capacity) {
+#ifndef MOLSIM_WITH_TRACING
+    if (!fileName.empty()) {
+        throw std::invalid_argument("Tracing is not available, MolSim was built without MOLSIM_WITH_TRACING.");
+    }
+#endif
+    if (!fileName.empty() && capacity == 0) {
+        throw std::invalid_argument("The capacity of the trace has to be positive.");
+    }
+    traceFile = fileName;
+    traceCapacity = capacity;
+}
+
+void Simulator::setPairStatistics(int interval, const std::string &fileName) {
+    if (interval < 0) {
+        throw std::invalid_argument("The interval of the pair statistics must not be negative.");
+    }
+    pairStatisticsInterval = interval;
+    pairStatisticsFile = fileName;
+}
+
+void Simulator::setMemoryReport(bool enabled) {
+    memoryReport = enabled;
+}
+
+MemoryFootprint Simulator::accountMemory() const {
+    MemoryFootprint footprint;
+    model->accountMemory(footprint);
+    if (asyncOutputWriter) {
+        asyncOutputWriter->accountMemory(footprint);
+    }
+    return footprint;
+}
+
+void Simulator::plot(int iteration, double time) {
+    if (asyncOutputWriter) {
+        asyncOutputWriter->submit(model->getParticles(), iteration, outputFileBaseName, time);
+    } else {
+        model->plot(iteration, outputFileBaseName, time);
+    }
+}
+
 void Simulator::run(bool benchmark) {
-    double current_time = 0;
-    int iteration = 0;
+    //A simulation resumed from a checkpoint continues with the time and iteration stored in it
+    double current_time = startTime;
+    int iteration = startIteration;
 
-    //Set the temperature of the system if specified
-    if (initialiseSystemWithBrownianMotion) {
+    //Set the temperature of the system if specified (not when resuming, the velocities are already initialised)
+    if (initialiseSystemWithBrownianMotion && !resumed) {
         thermostat->initialiseSystem();
     }
 
-    //Plot everything one time before the simulation starts.
+    //Plot everything one time before the simulation starts. A new simulation replaces an existing trajectory, a
+    //resumed one keeps the frames before its start iteration.
     if (!benchmark) {
-        model->plot(iteration, outputFileBaseName);
+        if (!resumed) {
+            if (asyncOutputWriter) {
+                asyncOutputWriter->startNewTrajectory();
+            } else {
+                model->startNewTrajectory();
+            }
+        }
+        plot(iteration, current_time);
+    }
+
+    //Calculate the initial forces before starting the simulation. A resumed simulation already has the forces of the
+    //checkpoint, recalculating them would overwrite the old forces needed by the next step.
+    if (!resumed) {
+        model->updateForces();
+    }
+
+
+    //Only the steps of this run are timed
+    PhaseTimers::global().reset();
+    if (!traceFile.empty()) {
+        Tracer::global().enable(traceCapacity);
     }
 
-    //Calculate the initial forces before starting the simulation
-    model->updateForces();
+    MemoryAccounting memory;
+    if (memoryReport) {
+        memory.record(accountMemory());
+    }
 
+    PairStatisticsRecorder pairStatistics;
+    bool samplePairStatistics = pairStatisticsInterval > 0;
+    if (samplePairStatistics) {
+        if (auto statistics = model->collectPairStatistics()) {
+            pairStatistics.add(iteration, *statistics);
+        } else {
+            spdlog::warn("Pair statistics are only available for the linked cells model.");
+            samplePairStatistics = false;
+        }
+    }
 
     while (current_time < endT) {
 
@@ -169,6 +340,7 @@ void Simulator::run(bool benchmark) {
 
         //Control temperature if thermostat is specified
         if (useThermostat && iteration % nThermostat == 0) {
+            PHASE_TIMER(Phase::thermostat);
             if (applyScalingGradually) {
                 thermostat->setTemperatureOfTheSystemViaGradualVelocityScaling();
             } else {
@@ -177,26 +349,134 @@ void Simulator::run(bool benchmark) {
         }
 
         iteration++;
+        current_time += deltaT;
+        if (samplePairStatistics && iteration % pairStatisticsInterval == 0) {
+            pairStatistics.add(iteration, *model->collectPairStatistics());
+        }
         if (!benchmark && iteration % outputFrequency == 0) {
-            model->plot(iteration, outputFileBaseName);
+            PHASE_TIMER(Phase::output);
+            plot(iteration, current_time);
+        }
+
+        if (memoryReport) {
+            memory.record(accountMemory());
         }
 
+#ifdef MOLSIM_WITH_PHASE_TIMERS
+        PhaseTimers::global().endStep(iteration);
+#endif
+
         spdlog::trace("Iteration {} finished.", iteration);
+    }
 
-        current_time += deltaT;
+    currentTime = current_time;
+    currentIteration = iteration;
+
+    //Wait until the last frames have been written
+    if (asyncOutputWriter) {
+        asyncOutputWriter->flush();
+    }
+
+    if (!traceFile.empty()) {
+        Tracer::global().disable();
+        Tracer::global().writeJSON(fileNameOfThisProcess(traceFile), rank);
+        if (Tracer::global().dropped() > 0) {
+            spdlog::warn("The trace is full, the {} oldest spans have been dropped.", Tracer::global().dropped());
+        }
+        spdlog::info("Trace written to {}.", fileNameOfThisProcess(traceFile));
+    }
+
+    if (memoryReport) {
+        memory.record(accountMemory());
+        memory.printReport(std::cout);
+    }
+
+    if (samplePairStatistics) {
+        pairStatistics.printReport(std::cout);
+        if (!pairStatisticsFile.empty()) {
+            pairStatistics.writeCSV(fileNameOfThisProcess(pairStatisticsFile));
+            spdlog::info("Pair statistics written to {}.", fileNameOfThisProcess(pairStatisticsFile));
+        }
     }
 
+#ifdef MOLSIM_WITH_PHASE_TIMERS
+    PhaseTimers::global().printReport(std::cout);
+    if (!phaseTimesFile.empty()) {
+        PhaseTimers::global().writeCSV(fileNameOfThisProcess(phaseTimesFile));
+        spdlog::info("Phase times written to {}.", fileNameOfThisProcess(phaseTimesFile));
+    }
+#endif
+
     spdlog::info("Output written. Terminating...");
 }
 
+std::string Simulator::fileNameOfThisProcess(const std::string &fileName) const {
+    if (rankSuffix.empty()) {
+        return fileName;
+    }
+    std::filesystem::path path{fileName};
+    return (path.parent_path() / (path.stem().string() + rankSuffix + path.extension().string())).string();
+}
+
 void Simulator::loadState(std::string &pathToMolecules) {
     int particlesBefore = model->getParticles().size();
-    model->addViaFile(pathToMolecules,FileHandler::inputFormat::txt);
+    //A distributed simulation is resumed from the checkpoints of its processes, if they exist
+    std::string checkpoint = fileNameOfThisProcess(pathToMolecules);
+    if (!std::filesystem::exists(checkpoint)) {
+        checkpoint = pathToMolecules;
+    }
+    if (CheckpointReader::isCheckpoint(checkpoint)) {
+        //The checkpoint replaces the particles generated from the input file
+        model->getParticles().clear();
+        particlesBefore = 0;
+        Checkpoint::Header header = CheckpointReader::readFile(model->getParticles(), checkpoint);
+        model->registerParameterTypes();
+        if (header.domainSize != domainSize) {
+            throw std::runtime_error("The domain of the checkpoint does not match the domain of the simulation");
+        }
+        BoundarySet &b = header.boundaries;
+        if (b.front != boundaries.front || b.right != boundaries.right || b.back != boundaries.back ||
+            b.left != boundaries.left || b.top != boundaries.top || b.bottom != boundaries.bottom) {
+            throw std::runtime_error(
+                "The boundary conditions of the checkpoint do not match the boundary conditions of the simulation");
+        }
+        resumed = true;
+        startTime = header.time;
+        startIteration = static_cast<int>(header.iteration);
+        currentTime = startTime;
+        currentIteration = startIteration;
+        std::istringstream randomEngineState(header.randomEngineState);
+        randomEngineState >> maxwellBoltzmannRandomEngine();
+        spdlog::info("Resuming simulation at t = {} (iteration {})", startTime, startIteration);
+    } else {
+        model->addViaFile(pathToMolecules,FileHandler::inputFormat::txt);
+    }
     spdlog::info("Loaded {} molecules into the simulation", model->getParticles().size() - particlesBefore);
 }
 
-void Simulator::saveState() {
-    model->saveState();
+void Simulator::saveState(FileHandler::stateFormat format, const std::string &fileName) {
+    switch (format) {
+        case FileHandler::stateFormat::binary: {
+            Checkpoint::Header header;
+            header.domainSize = domainSize;
+            header.boundaries = boundaries;
+            header.time = currentTime;
+            header.iteration = currentIteration;
+            std::ostringstream randomEngineState;
+            randomEngineState << maxwellBoltzmannRandomEngine();
+            header.randomEngineState = randomEngineState.str();
+            CheckpointWriter::writeToFile(model->getParticles(), header,
+                                          fileNameOfThisProcess(fileName.empty() ? "Checkpoint.bin" : fileName));
+        }
+        break;
+        case FileHandler::stateFormat::txt: {
+            model->saveState();
+        }
+        break;
+        default: {
+            throw std::invalid_argument("Invalid checkpoint format");
+        }
+    }
 }
 
 ParticleContainer &Simulator::getParticles() {
@@ -206,3 +486,11 @@ ParticleContainer &Simulator::getParticles() {
 unsigned long long Simulator::getTotalMoleculeUpdates() {
     return totalMoleculeUpdates;
 }
+
+int Simulator::getStepsOfLastRun() {
+    return currentIteration - startIteration;
+}
+
+unsigned long long Simulator::countPairInteractions() {
+    return model->countPairInteractions();
+}
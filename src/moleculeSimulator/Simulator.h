@@ -5,6 +5,7 @@
 #pragma once
 
 #include "fileHandling/FileHandler.h"
+#include "fileHandling/outputWriter/AsyncOutputWriter/AsyncOutputWriter.h"
 #include "fileHandling/outputWriter/VTKWriter/VTKWriter.h"
 #include "forceCalculation/Force.h"
 #include "models/Model.h"
@@ -13,6 +14,7 @@
 #include <moleculeSimulator/thermostat/Thermostat.h>
 #include "forceCalculation/gravity/Gravity.h"
 #include "forceCalculation/leonardJones/LeonardJonesForce.h"
+#include "models/barnesHut/BarnesHut.h"
 #include "models/directSum/DirectSum.h"
 #include "../models/linkedCells/LinkedCells.h"
 
@@ -41,9 +43,64 @@ private:
  //output
  int outputFrequency;
  std::string outputFileBaseName;
+ FileHandler::outputFormat outputFormat;
+ //If set, output files are written on a background thread
+ std::unique_ptr<outputWriter::AsyncOutputWriter> asyncOutputWriter;
+ //options of the binary vtu output
+ outputWriter::VTUWriter::Precision vtuPrecision = outputWriter::VTUWriter::Precision::float32;
+ bool vtuCompression = false;
+ size_t vtuPieces = 0;
+
+ //simulation state, needed to resume a simulation from a checkpoint
+ bool resumed;
+ double startTime;
+ int startIteration;
+ double currentTime;
+ int currentIteration;
+ std::array<double, 3> domainSize;
+ BoundarySet boundaries;
+
+ //Appended to the names of all files written by this process, if the simulation is distributed over several MPI processes
+ std::string rankSuffix;
+ //Rank of this process, 0 if the simulation is not distributed
+ int rank = 0;
+
+ /**
+  * @brief Append the rank suffix to a file name, in front of its extension.
+  *
+  * @param fileName File name.
+  *
+  * @return File name of this process.
+  */
+ [[nodiscard]] std::string fileNameOfThisProcess(const std::string &fileName) const;
 
  //performance measurements
  unsigned long long totalMoleculeUpdates;
+ //If set, the time of each phase of every step is written to this csv file
+ std::string phaseTimesFile;
+ //If set, a trace of the run is written to this json file, keeping at most traceCapacity spans
+ std::string traceFile;
+ size_t traceCapacity = 0;
+ //If greater than 0, the pair statistics are sampled every pairStatisticsInterval steps and optionally written to a csv file
+ int pairStatisticsInterval = 0;
+ std::string pairStatisticsFile;
+ //If set, the memory footprint is measured at the start of the run and after every step
+ bool memoryReport = false;
+
+ /**
+  * @brief Measure the bytes currently held by the model and the background writer.
+  *
+  * @return Current memory footprint.
+  */
+ [[nodiscard]] MemoryFootprint accountMemory() const;
+
+ /**
+  * @brief Write the current state of the model to an output file, either directly or via the background writer.
+  *
+  * @param iteration Current iteration.
+  * @param time Current simulation time.
+  */
+ void plot(int iteration, double time);
 
 public:
  Simulator() = delete;
@@ -75,6 +132,66 @@ public:
            FileHandler::outputFormat outputFormat, int outputFrequency,
            std::string &outputFileBaseName);
 
+ /**
+  * @brief Write the output files on a background thread, so the simulation continues while a frame is written.
+  *
+  * @param queueCapacity Maximal number of frames buffered for writing. If the writer falls behind, the simulation waits
+  *                      until a frame has been written. If set to 0, the output is written synchronously.
+  */
+ void setAsyncOutput(size_t queueCapacity);
+
+ /**
+  * @brief Configure the binary vtu output. Only has an effect, if the output format is vtu or pvtu.
+  *
+  * @param precision Precision of the floating point arrays.
+  * @param compress Compress the arrays with zlib.
+  * @param pieces Number of pieces per frame of the pvtu output. If 0, one piece per OpenMP thread is written, or
+  *               AsyncOutputWriter::backgroundPieces if the output is written on a background thread.
+  *
+  * @throws std::invalid_argument If compression is requested, but MolSim is built without zlib.
+  */
+ void setVTUOptions(outputWriter::VTUWriter::Precision precision, bool compress, size_t pieces = 0);
+
+ /**
+  * @brief Write the time of each phase of every step to a csv file at the end of the run.
+  *
+  * @param fileName Name of the csv file. If empty, no file is written.
+  *
+  * @throws std::invalid_argument If MolSim is built without MOLSIM_WITH_PHASE_TIMERS.
+  */
+ void setPhaseTimesFile(const std::string &fileName);
+
+ /**
+  * @brief Record a trace of the run and write it as Chrome trace-event JSON at the end of the run (see Tracer.h).
+  *
+  * @param fileName Name of the json file. If empty, no trace is recorded.
+  * @param capacity Maximal number of spans kept. If more spans are recorded, only the most recent ones are written.
+  *
+  * @throws std::invalid_argument If MolSim is built without MOLSIM_WITH_TRACING or the capacity is 0.
+  */
+ void setTraceFile(const std::string &fileName, size_t capacity);
+
+ /**
+  * @brief Sample statistics about the pair traversal during the run (see PairStatistics) and print a summary at the end
+  *        of the run. Only the linked cells model provides these statistics.
+  *
+  * Each sample costs about as much as a force calculation without evaluating the force.
+  *
+  * @param interval Number of steps between two samples. If 0, no statistics are sampled.
+  * @param fileName Name of a csv file to which every sample is written. If empty, only the summary is printed.
+  *
+  * @throws std::invalid_argument If the interval is negative.
+  */
+ void setPairStatistics(int interval, const std::string &fileName);
+
+ /**
+  * @brief Report the bytes held by the particles, the cells, the precomputed indices and the output buffers at the
+  *        start of the run and at their peak, together with the peak resident set size of the process.
+  *
+  * @param enabled Enable or disable the report.
+  */
+ void setMemoryReport(bool enabled);
+
  /**
   * @brief Run the simulation.
   *
@@ -89,14 +206,27 @@ public:
  /**
   * @brief Load the state of all molecules from a previous simulation back into this simulation.
   *
-  * @param pathToMolecules Path pointing to the txt file which stores the state of the molecules.
+  * @param pathToMolecules Path pointing to the binary checkpoint or the txt file which stores the state of the molecules.
+  *
+  * A binary checkpoint replaces all particles of this simulation and additionally restores simulation time, iteration
+  * and random engine, so the simulation is resumed exactly where the previous one stopped. Its domain and boundary
+  * conditions have to match this simulation. The Verlet lists are not part of the checkpoint. They are rebuilt on
+  * resume, which changes the order in which the forces are summed, so the resumed simulation is only bit-exact without
+  * Verlet lists.
+  * If the simulation is distributed over several MPI processes, each process loads the checkpoint it has written
+  * (see saveState()), if it exists. Otherwise, each process keeps the particles of its subdomain.
   */
  void loadState(std::string& pathToMolecules);
 
  /**
-  * @brief Export the current state of all molecules to a txt file for using them in a new simulation.
+  * @brief Export the current state of the simulation for using it in a new simulation.
+  *
+  * @param format Format of the checkpoint. The binary format is written to Checkpoint.bin, the txt format to Checkpoint.txt.
+  * @param fileName Name of the checkpoint file. If empty, the default name of the format is used. If the simulation is
+  *                 distributed over several MPI processes, each process writes the particles of its subdomain to its own
+  *                 checkpoint, whose name contains the rank of the process (e.g. Checkpoint_rank0.bin).
   */
- void saveState();
+ void saveState(FileHandler::stateFormat format = FileHandler::stateFormat::binary, const std::string &fileName = "");
 
  /**
   * @brief Get the Particle container of this simulator
@@ -108,4 +238,19 @@ public:
 
  unsigned long long getTotalMoleculeUpdates();
 
+ /**
+  * @brief Get the number of steps performed by the last call of run().
+  *
+  * @return Number of steps.
+  */
+ int getStepsOfLastRun();
+
+ /**
+  * @brief Count the pairs of particles interacting with each other in the current state (see
+  *        Model::countPairInteractions()).
+  *
+  * @return Number of interacting pairs, or 0 if the model cannot tell.
+  */
+ unsigned long long countPairInteractions();
+
 };
@@ -4,6 +4,7 @@
 
 #pragma once
 #include "particleRepresentation/particle/Particle.h"
+#include "particleRepresentation/particle/ParticleSoA.h"
 
 /**
  * @brief Interface representing the force that the source exerts on the target.
@@ -32,4 +33,52 @@ public:
     */
 
     virtual std::array<double, 3> computeOptimized(Particle &target, Particle &source, std::array<double, 3>& difference, double distance) = 0;
+
+    /**
+     * @brief Compute the forces between all pairs of particles within one cell stored as structure of arrays.
+     *
+     * @param cell Particles of the cell. The resulting forces are added to the force arrays of this buffer.
+     * @param rCutOff Only pairs with a distance smaller or equal than the cut-off radius interact.
+     *
+     * Newton's third law of motion is used, so each pair is evaluated only once.
+     */
+    virtual void computeWithinCellSoA(ParticleSoA &cell, double rCutOff) = 0;
+
+    /**
+     * @brief Compute the forces between all pairs of particles of two different cells stored as structure of arrays.
+     *
+     * @param cell1 Particles of the first cell.
+     * @param cell2 Particles of the second cell.
+     * @param rCutOff Only pairs with a distance smaller or equal than the cut-off radius interact.
+     *
+     * Newton's third law of motion is used, so the forces are added to both buffers.
+     */
+    virtual void computeBetweenCellsSoA(ParticleSoA &cell1, ParticleSoA &cell2, double rCutOff) = 0;
+
+    /**
+     * @brief Compute the force that a reflective wall exerts on a particle.
+     *
+     * @param p Particle close to the wall.
+     * @param distance Distance of the particle to the wall.
+     * @return Force in the direction of the normal pointing from the wall into the domain.
+     *
+     * The wall acts like a ghost particle mirrored at the wall, i.e. a particle of the same type at distance
+     * 2 * distance. Since the force only acts along the normal of the wall, it is reduced to one dimension.
+     */
+    virtual double computeWall(Particle &p, double distance) = 0;
+
+    /**
+     * @brief Register a pair of Leonard-Jones parameters with this force, so particles can refer to it by their
+     *        parameter type (see Particle::setParameterType()).
+     *
+     * @param sigma Leonard-Jones parameter sigma.
+     * @param epsilon Leonard-Jones parameter epsilon.
+     *
+     * @return Parameter type of the pair. Forces not depending on the parameters always return 0.
+     *
+     * Parameters are registered while the particles are added to a model, not during the force calculation.
+     */
+    virtual int registerParameterType(double sigma, double epsilon) {
+        return 0;
+    }
 };
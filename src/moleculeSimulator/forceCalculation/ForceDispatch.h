@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Force.h"
+#include "gravity/Gravity.h"
+#include "leonardJones/LeonardJonesForce.h"
+
+/**
+ * @brief Call a generic functor with the concrete type of a force.
+ *
+ * @param force Force to dispatch.
+ * @param function Generic functor (e.g. a lambda with an auto parameter) that is called with the force cast to its
+ *                 concrete type.
+ *
+ * All concrete forces are final, so the compiler can resolve the calls of compute() and computeOptimized()
+ * within the functor statically and inline them into the traversal of the particles. Unknown forces are passed
+ * as Force and keep the virtual calls.
+ */
+template<typename F>
+void dispatchForce(Force &force, F &&function) {
+    if (auto *leonardJonesForce = dynamic_cast<LeonardJonesForce *>(&force)) {
+        function(*leonardJonesForce);
+    } else if (auto *gravity = dynamic_cast<Gravity *>(&force)) {
+        function(*gravity);
+    } else {
+        function(force);
+    }
+}
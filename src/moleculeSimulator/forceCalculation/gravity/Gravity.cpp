@@ -10,6 +10,57 @@ std::array<double, 3> Gravity::compute(Particle &target, Particle &source) {
 
 std::array<double, 3> Gravity::computeOptimized(Particle &target, Particle &source, std::array<double, 3> &difference,
     double distance) {
-    spdlog::error("Not implemented yet!");
-    exit(-1);
+    return (target.getM() * source.getM()) / (distance * distance * distance) * difference;
+}
+
+void Gravity::computeWithinCellSoA(ParticleSoA &cell, double rCutOff) {
+    const double rCutOffSquared = rCutOff * rCutOff;
+    const size_t n = cell.size();
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            double dX = cell.x[0][j] - cell.x[0][i];
+            double dY = cell.x[1][j] - cell.x[1][i];
+            double dZ = cell.x[2][j] - cell.x[2][i];
+            double squared_distance = dX * dX + dY * dY + dZ * dZ;
+            if (squared_distance > rCutOffSquared) {
+                continue;
+            }
+            double distance = std::sqrt(squared_distance);
+            double scalar = (cell.m[i] * cell.m[j]) / (squared_distance * distance);
+            cell.f[0][i] += scalar * dX;
+            cell.f[1][i] += scalar * dY;
+            cell.f[2][i] += scalar * dZ;
+            cell.f[0][j] -= scalar * dX;
+            cell.f[1][j] -= scalar * dY;
+            cell.f[2][j] -= scalar * dZ;
+        }
+    }
+}
+
+void Gravity::computeBetweenCellsSoA(ParticleSoA &cell1, ParticleSoA &cell2, double rCutOff) {
+    const double rCutOffSquared = rCutOff * rCutOff;
+    for (size_t i = 0; i < cell1.size(); i++) {
+        for (size_t j = 0; j < cell2.size(); j++) {
+            double dX = cell2.x[0][j] - cell1.x[0][i];
+            double dY = cell2.x[1][j] - cell1.x[1][i];
+            double dZ = cell2.x[2][j] - cell1.x[2][i];
+            double squared_distance = dX * dX + dY * dY + dZ * dZ;
+            if (squared_distance > rCutOffSquared) {
+                continue;
+            }
+            double distance = std::sqrt(squared_distance);
+            double scalar = (cell1.m[i] * cell2.m[j]) / (squared_distance * distance);
+            cell1.f[0][i] += scalar * dX;
+            cell1.f[1][i] += scalar * dY;
+            cell1.f[2][i] += scalar * dZ;
+            cell2.f[0][j] -= scalar * dX;
+            cell2.f[1][j] -= scalar * dY;
+            cell2.f[2][j] -= scalar * dZ;
+        }
+    }
+}
+
+double Gravity::computeWall(Particle &p, double distance) {
+    //The mirror image attracts the particle towards the wall
+    return -(p.getM() * p.getM()) / (4 * distance * distance);
 }
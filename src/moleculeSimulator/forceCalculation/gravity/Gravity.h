@@ -14,7 +14,7 @@
  *
  * The gravitational force is one example of a force which might act between two particles in space.
  */
-class Gravity : public Force {
+class Gravity final : public Force {
 public:
     /**
     * @brief Actual computation of the gravitational force occurring.
@@ -28,9 +28,40 @@ public:
     std::array<double, 3> compute(Particle &target, Particle &source) override;
 
     /**
-    * @brief We needed this to integrate our optimization in our code to prevent breaking the inheritance hierachy.
-    *        Will be removed, when we integrated the optimization properly.
+    * @brief Computation of the gravitational force using an already known difference vector and distance.
+    *
+    * @param target Particle on which the gravitational force acts.
+    * @param source Particle which exerts the gravitational force on the target.
+    * @param difference Difference vector of the positions (source - target).
+    * @param distance Distance between the particles.
+    * @return 3 dimensional force vector.
     */
 
     std::array<double, 3> computeOptimized(Particle &target, Particle &source, std::array<double, 3>& difference, double distance) override;
+
+    /**
+     * @brief Compute the gravitational forces between all pairs of particles within one cell stored as structure of arrays.
+     *
+     * @param cell Particles of the cell.
+     * @param rCutOff Cut-off radius.
+     */
+    void computeWithinCellSoA(ParticleSoA &cell, double rCutOff) override;
+
+    /**
+     * @brief Compute the gravitational forces between all pairs of particles of two cells stored as structure of arrays.
+     *
+     * @param cell1 Particles of the first cell.
+     * @param cell2 Particles of the second cell.
+     * @param rCutOff Cut-off radius.
+     */
+    void computeBetweenCellsSoA(ParticleSoA &cell1, ParticleSoA &cell2, double rCutOff) override;
+
+    /**
+     * @brief Compute the gravitational force between a particle and its mirror image at a reflective wall.
+     *
+     * @param p Particle close to the wall.
+     * @param distance Distance of the particle to the wall.
+     * @return Force in the direction of the normal pointing from the wall into the domain.
+     */
+    double computeWall(Particle &p, double distance) override;
 };
@@ -4,26 +4,74 @@
 
 #include "LeonardJonesForce.h"
 
+#include <cassert>
 
-LeonardJonesForce::LeonardJonesForce()= default;
+LeonardJonesForce::LeonardJonesForce() : LeonardJonesForce(LeonardJonesKernels::detectSimdLevel()) {
+}
+
+LeonardJonesForce::LeonardJonesForce(LeonardJonesKernels::SimdLevel simdLevel) : kernel{
+                                                                                     LeonardJonesKernels::getKernel(simdLevel)
+                                                                                 }, simdLevel{simdLevel} {
+    spdlog::debug("Leonard-Jones force uses the {} kernel", LeonardJonesKernels::toString(simdLevel));
+}
+
+int LeonardJonesForce::registerParameterType(double sigma, double epsilon) {
+    return registry.registerType(sigma, epsilon);
+}
 
 std::array<double, 3> LeonardJonesForce::compute(Particle &target, Particle &source) {
-    //compute mixing constants
-    double sigma_ij = (target.getSigma() + source.getSigma()) / 2;
-    double epsilon_ij = std::sqrt(target.getEpsilon() * source.getEpsilon());
+    //look up precomputed mixing constants
+    const int type1 = target.getParameterType();
+    const int type2 = source.getParameterType();
+    //A particle added to a container directly keeps parameter type 0 until Model::registerParameterTypes() is called
+    assert(registry.hasParameters(type1, target.getSigma(), target.getEpsilon()) && "Parameter type not registered");
+    assert(registry.hasParameters(type2, source.getSigma(), source.getEpsilon()) && "Parameter type not registered");
     auto difference = source.getX() - target.getX();
-    double squared_distance = std::pow(ArrayUtils::L2Norm(difference), 2);
-    double c1 = std::pow(sigma_ij * sigma_ij / squared_distance, 3);
+    double squared_distance = difference[0] * difference[0] + difference[1] * difference[1] + difference[2] * difference[2];
+    double c1 = registry.getSigmaSquared(type1, type2) / squared_distance;
+    c1 = c1 * c1 * c1;
     double c2 = 2 * c1 * c1;
-    return ((24 * epsilon_ij) / squared_distance) * (c1 - c2) * difference;
+    return (registry.getTwentyFourEpsilon(type1, type2) / squared_distance) * (c1 - c2) * difference;
 }
 
 std::array<double, 3> LeonardJonesForce::computeOptimized(Particle &target, Particle &source, std::array<double, 3>& difference, double distance) {
-    //compute mixing constants
-    double sigma_ij = (target.getSigma() + source.getSigma()) / 2;
-    double epsilon_ij = std::sqrt(target.getEpsilon()* source.getEpsilon());
-    double squared_distance = std::pow(distance, 2);
-    double c1 = std::pow(sigma_ij * sigma_ij / squared_distance, 3);
+    //look up precomputed mixing constants
+    const int type1 = target.getParameterType();
+    const int type2 = source.getParameterType();
+    //A particle added to a container directly keeps parameter type 0 until Model::registerParameterTypes() is called
+    assert(registry.hasParameters(type1, target.getSigma(), target.getEpsilon()) && "Parameter type not registered");
+    assert(registry.hasParameters(type2, source.getSigma(), source.getEpsilon()) && "Parameter type not registered");
+    double squared_distance = distance * distance;
+    double c1 = registry.getSigmaSquared(type1, type2) / squared_distance;
+    c1 = c1 * c1 * c1;
     double c2 = 2 * c1 * c1;
-    return ((24 * epsilon_ij) / squared_distance) * (c1 - c2) * difference;
-}
\ No newline at end of file
+    return (registry.getTwentyFourEpsilon(type1, type2) / squared_distance) * (c1 - c2) * difference;
+}
+
+double LeonardJonesForce::computeWall(Particle &p, double distance) {
+    //The mirror image has the same type, so the mixing constants of the type with itself are used
+    const int type = p.getParameterType();
+    assert(registry.hasParameters(type, p.getSigma(), p.getEpsilon()) && "Parameter type not registered");
+    double squared_distance = 4 * distance * distance;
+    double c1 = registry.getSigmaSquared(type, type) / squared_distance;
+    c1 = c1 * c1 * c1;
+    double c2 = 2 * c1 * c1;
+    return (registry.getTwentyFourEpsilon(type, type) / squared_distance) * (c2 - c1) * 2 * distance;
+}
+
+void LeonardJonesForce::computeWithinCellSoA(ParticleSoA &cell, double rCutOff) {
+    const double rCutOffSquared = rCutOff * rCutOff;
+    const size_t n = cell.size();
+    for (size_t i = 0; i < n; i++) {
+        kernel(cell, i, cell, i + 1, n, rCutOffSquared, registry);
+    }
+}
+
+void LeonardJonesForce::computeBetweenCellsSoA(ParticleSoA &cell1, ParticleSoA &cell2, double rCutOff) {
+    const double rCutOffSquared = rCutOff * rCutOff;
+    const size_t n1 = cell1.size();
+    const size_t n2 = cell2.size();
+    for (size_t i = 0; i < n1; i++) {
+        kernel(cell1, i, cell2, 0, n2, rCutOffSquared, registry);
+    }
+}
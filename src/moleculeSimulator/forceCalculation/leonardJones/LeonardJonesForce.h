@@ -4,13 +4,50 @@
 
 #pragma once
 #include "../Force.h"
+#include "LeonardJonesKernels.h"
 
-class LeonardJonesForce : public Force {
+class LeonardJonesForce final : public Force {
+
+private:
+    /**
+     * Kernel used for the force calculation on structure of arrays buffers.
+     */
+    LeonardJonesKernels::Kernel kernel;
+
+    /**
+     * SIMD level of the kernel.
+     */
+    LeonardJonesKernels::SimdLevel simdLevel;
+
+    /**
+     * Mixed constants of all pairs of Leonard-Jones parameters of the particles this force acts on.
+     */
+    LeonardJonesTypeRegistry registry;
 
 public:
 
+    /**
+     * @brief Construct a Leonard-Jones force using the widest SIMD kernel supported by the CPU.
+     */
     LeonardJonesForce();
 
+    /**
+     * @brief Construct a Leonard-Jones force using the kernel of a specific SIMD level.
+     *
+     * @param simdLevel SIMD level of the kernel. Must be supported by the CPU.
+     */
+    explicit LeonardJonesForce(LeonardJonesKernels::SimdLevel simdLevel);
+
+    /**
+     * @brief Register a pair of Leonard-Jones parameters in the registry of this force.
+     *
+     * @param sigma Leonard-Jones parameter sigma.
+     * @param epsilon Leonard-Jones parameter epsilon.
+     *
+     * @return Parameter type of the pair.
+     */
+    int registerParameterType(double sigma, double epsilon) override;
+
     /**
     * @brief Actual computation of the Leonard-Jones force occurring.
     *
@@ -18,7 +55,9 @@ public:
     * @param source Particle which exerts the Leonard-Jones force on the target.
     * @return 3 dimensional force vector.
     *
-    * Computation of the Leonard-Jones force which exerts the source on the target.
+    * Computation of the Leonard-Jones force which exerts the source on the target. The parameter types of both
+    * particles have to be registered with this force (see Model::registerParameterTypes()), which is checked by an
+    * assertion in debug builds.
     */
     std::array<double, 3> compute(Particle &target, Particle &source) override;
 
@@ -29,4 +68,38 @@ public:
     */
 
     std::array<double, 3> computeOptimized(Particle &target, Particle &source, std::array<double, 3>& difference, double distance) override;
+
+    /**
+     * @brief Compute the Leonard-Jones forces between all pairs of particles within one cell stored as structure of arrays.
+     *
+     * @param cell Particles of the cell.
+     * @param rCutOff Cut-off radius.
+     */
+    void computeWithinCellSoA(ParticleSoA &cell, double rCutOff) override;
+
+    /**
+     * @brief Compute the Leonard-Jones forces between all pairs of particles of two cells stored as structure of arrays.
+     *
+     * @param cell1 Particles of the first cell.
+     * @param cell2 Particles of the second cell.
+     * @param rCutOff Cut-off radius.
+     */
+    void computeBetweenCellsSoA(ParticleSoA &cell1, ParticleSoA &cell2, double rCutOff) override;
+
+    /**
+     * @brief Compute the Leonard-Jones force between a particle and its mirror image at a reflective wall.
+     *
+     * @param p Particle close to the wall.
+     * @param distance Distance of the particle to the wall.
+     * @return Force in the direction of the normal pointing from the wall into the domain.
+     */
+    double computeWall(Particle &p, double distance) override;
+
+    [[nodiscard]] LeonardJonesKernels::SimdLevel getSimdLevel() const {
+        return simdLevel;
+    }
+
+    [[nodiscard]] const LeonardJonesTypeRegistry &getRegistry() const {
+        return registry;
+    }
 };
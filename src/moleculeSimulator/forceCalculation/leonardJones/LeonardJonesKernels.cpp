@@ -0,0 +1,211 @@
+#include "LeonardJonesKernels.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LJ_KERNELS_X86
+#endif
+
+namespace LeonardJonesKernels {
+    namespace {
+        void computeScalar(ParticleSoA &target, size_t i, ParticleSoA &sources, size_t begin, size_t end,
+                           double rCutOffSquared, const LeonardJonesTypeRegistry &registry) {
+            const double xI = target.x[0][i];
+            const double yI = target.x[1][i];
+            const double zI = target.x[2][i];
+            //Rows of the parameter tables belonging to the type of particle i
+            const int numberOfTypes = registry.getNumberOfTypes();
+            const double *sigmaSquaredI = registry.getSigmaSquaredTable() + target.parameterType[i] * numberOfTypes;
+            const double *twentyFourEpsilonI = registry.getTwentyFourEpsilonTable() + target.parameterType[i] * numberOfTypes;
+            double fX = 0;
+            double fY = 0;
+            double fZ = 0;
+            for (size_t j = begin; j < end; j++) {
+                double dX = sources.x[0][j] - xI;
+                double dY = sources.x[1][j] - yI;
+                double dZ = sources.x[2][j] - zI;
+                double squaredDistance = dX * dX + dY * dY + dZ * dZ;
+                if (squaredDistance > rCutOffSquared) {
+                    continue;
+                }
+                //look up precomputed mixing constants
+                const int typeJ = sources.parameterType[j];
+                double c1 = sigmaSquaredI[typeJ] / squaredDistance;
+                c1 = c1 * c1 * c1;
+                double scalar = (twentyFourEpsilonI[typeJ] / squaredDistance) * (c1 - 2 * c1 * c1);
+                fX += scalar * dX;
+                fY += scalar * dY;
+                fZ += scalar * dZ;
+                sources.f[0][j] -= scalar * dX;
+                sources.f[1][j] -= scalar * dY;
+                sources.f[2][j] -= scalar * dZ;
+            }
+            target.f[0][i] += fX;
+            target.f[1][i] += fY;
+            target.f[2][i] += fZ;
+        }
+
+#ifdef LJ_KERNELS_X86
+        //Undefined vectors used inside some intrinsics of GCC (e.g. gathers) trigger false positive warnings
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+        __attribute__((target("avx2,fma")))
+        double horizontalSum(__m256d v) {
+            __m128d low = _mm256_castpd256_pd128(v);
+            __m128d high = _mm256_extractf128_pd(v, 1);
+            low = _mm_add_pd(low, high);
+            return _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+        }
+
+        __attribute__((target("avx2,fma")))
+        void computeAVX2(ParticleSoA &target, size_t i, ParticleSoA &sources, size_t begin, size_t end,
+                         double rCutOffSquared, const LeonardJonesTypeRegistry &registry) {
+            const __m256d xI = _mm256_set1_pd(target.x[0][i]);
+            const __m256d yI = _mm256_set1_pd(target.x[1][i]);
+            const __m256d zI = _mm256_set1_pd(target.x[2][i]);
+            //Rows of the parameter tables belonging to the type of particle i
+            const int numberOfTypes = registry.getNumberOfTypes();
+            const double *sigmaSquaredI = registry.getSigmaSquaredTable() + target.parameterType[i] * numberOfTypes;
+            const double *twentyFourEpsilonI = registry.getTwentyFourEpsilonTable() + target.parameterType[i] * numberOfTypes;
+            const __m256d cutOff = _mm256_set1_pd(rCutOffSquared);
+            const __m256d two = _mm256_set1_pd(2);
+            __m256d fX = _mm256_setzero_pd();
+            __m256d fY = _mm256_setzero_pd();
+            __m256d fZ = _mm256_setzero_pd();
+
+            size_t j = begin;
+            for (; j + 4 <= end; j += 4) {
+                __m256d dX = _mm256_sub_pd(_mm256_loadu_pd(&sources.x[0][j]), xI);
+                __m256d dY = _mm256_sub_pd(_mm256_loadu_pd(&sources.x[1][j]), yI);
+                __m256d dZ = _mm256_sub_pd(_mm256_loadu_pd(&sources.x[2][j]), zI);
+                __m256d squaredDistance = _mm256_fmadd_pd(dX, dX, _mm256_fmadd_pd(dY, dY, _mm256_mul_pd(dZ, dZ)));
+                __m256d mask = _mm256_cmp_pd(squaredDistance, cutOff, _CMP_LE_OQ);
+                if (_mm256_movemask_pd(mask) == 0) {
+                    continue;
+                }
+                //gather precomputed mixing constants
+                __m128i typesJ = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&sources.parameterType[j]));
+                __m256d sigmaSquared = _mm256_i32gather_pd(sigmaSquaredI, typesJ, 8);
+                __m256d twentyFourEpsilon = _mm256_i32gather_pd(twentyFourEpsilonI, typesJ, 8);
+                __m256d c1 = _mm256_div_pd(sigmaSquared, squaredDistance);
+                c1 = _mm256_mul_pd(_mm256_mul_pd(c1, c1), c1);
+                __m256d scalar = _mm256_mul_pd(_mm256_div_pd(twentyFourEpsilon, squaredDistance),
+                                               _mm256_fnmadd_pd(two, _mm256_mul_pd(c1, c1), c1));
+                //Pairs outside the cut-off radius do not contribute
+                scalar = _mm256_and_pd(scalar, mask);
+                __m256d fXj = _mm256_mul_pd(scalar, dX);
+                __m256d fYj = _mm256_mul_pd(scalar, dY);
+                __m256d fZj = _mm256_mul_pd(scalar, dZ);
+                fX = _mm256_add_pd(fX, fXj);
+                fY = _mm256_add_pd(fY, fYj);
+                fZ = _mm256_add_pd(fZ, fZj);
+                _mm256_storeu_pd(&sources.f[0][j], _mm256_sub_pd(_mm256_loadu_pd(&sources.f[0][j]), fXj));
+                _mm256_storeu_pd(&sources.f[1][j], _mm256_sub_pd(_mm256_loadu_pd(&sources.f[1][j]), fYj));
+                _mm256_storeu_pd(&sources.f[2][j], _mm256_sub_pd(_mm256_loadu_pd(&sources.f[2][j]), fZj));
+            }
+            target.f[0][i] += horizontalSum(fX);
+            target.f[1][i] += horizontalSum(fY);
+            target.f[2][i] += horizontalSum(fZ);
+
+            //Process the remaining partners one by one
+            computeScalar(target, i, sources, j, end, rCutOffSquared, registry);
+        }
+
+        __attribute__((target("avx512f")))
+        void computeAVX512(ParticleSoA &target, size_t i, ParticleSoA &sources, size_t begin, size_t end,
+                           double rCutOffSquared, const LeonardJonesTypeRegistry &registry) {
+            const __m512d xI = _mm512_set1_pd(target.x[0][i]);
+            const __m512d yI = _mm512_set1_pd(target.x[1][i]);
+            const __m512d zI = _mm512_set1_pd(target.x[2][i]);
+            //Rows of the parameter tables belonging to the type of particle i
+            const int numberOfTypes = registry.getNumberOfTypes();
+            const double *sigmaSquaredI = registry.getSigmaSquaredTable() + target.parameterType[i] * numberOfTypes;
+            const double *twentyFourEpsilonI = registry.getTwentyFourEpsilonTable() + target.parameterType[i] * numberOfTypes;
+            const __m512d cutOff = _mm512_set1_pd(rCutOffSquared);
+            const __m512d two = _mm512_set1_pd(2);
+            __m512d fX = _mm512_setzero_pd();
+            __m512d fY = _mm512_setzero_pd();
+            __m512d fZ = _mm512_setzero_pd();
+
+            for (size_t j = begin; j < end; j += 8) {
+                //The last iteration may contain less than 8 partners, the remaining lanes are masked out
+                const __mmask8 valid = end - j >= 8 ? 0xFF : static_cast<__mmask8>((1u << (end - j)) - 1);
+                __m512d dX = _mm512_sub_pd(_mm512_maskz_loadu_pd(valid, &sources.x[0][j]), xI);
+                __m512d dY = _mm512_sub_pd(_mm512_maskz_loadu_pd(valid, &sources.x[1][j]), yI);
+                __m512d dZ = _mm512_sub_pd(_mm512_maskz_loadu_pd(valid, &sources.x[2][j]), zI);
+                __m512d squaredDistance = _mm512_fmadd_pd(dX, dX, _mm512_fmadd_pd(dY, dY, _mm512_mul_pd(dZ, dZ)));
+                const __mmask8 mask = _mm512_mask_cmp_pd_mask(valid, squaredDistance, cutOff, _CMP_LE_OQ);
+                if (mask == 0) {
+                    continue;
+                }
+                //gather precomputed mixing constants
+                __m256i typesJ = _mm512_castsi512_si256(_mm512_maskz_loadu_epi32(mask, &sources.parameterType[j]));
+                __m512d sigmaSquared = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, typesJ, sigmaSquaredI, 8);
+                __m512d twentyFourEpsilon = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, typesJ, twentyFourEpsilonI, 8);
+                __m512d c1 = _mm512_maskz_div_pd(mask, sigmaSquared, squaredDistance);
+                c1 = _mm512_mul_pd(_mm512_mul_pd(c1, c1), c1);
+                //Pairs outside the cut-off radius do not contribute
+                __m512d scalar = _mm512_maskz_mul_pd(mask,
+                                                     _mm512_maskz_div_pd(mask, twentyFourEpsilon, squaredDistance),
+                                                     _mm512_fnmadd_pd(two, _mm512_mul_pd(c1, c1), c1));
+                __m512d fXj = _mm512_mul_pd(scalar, dX);
+                __m512d fYj = _mm512_mul_pd(scalar, dY);
+                __m512d fZj = _mm512_mul_pd(scalar, dZ);
+                fX = _mm512_add_pd(fX, fXj);
+                fY = _mm512_add_pd(fY, fYj);
+                fZ = _mm512_add_pd(fZ, fZj);
+                _mm512_mask_storeu_pd(&sources.f[0][j], mask, _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, &sources.f[0][j]), fXj));
+                _mm512_mask_storeu_pd(&sources.f[1][j], mask, _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, &sources.f[1][j]), fYj));
+                _mm512_mask_storeu_pd(&sources.f[2][j], mask, _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, &sources.f[2][j]), fZj));
+            }
+            target.f[0][i] += _mm512_reduce_add_pd(fX);
+            target.f[1][i] += _mm512_reduce_add_pd(fY);
+            target.f[2][i] += _mm512_reduce_add_pd(fZ);
+        }
+#pragma GCC diagnostic pop
+#endif
+    }
+
+    SimdLevel detectSimdLevel() {
+#ifdef LJ_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SimdLevel::avx512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return SimdLevel::avx2;
+        }
+#endif
+        return SimdLevel::scalar;
+    }
+
+    Kernel getKernel(SimdLevel level) {
+        if (level > detectSimdLevel()) {
+            throw std::invalid_argument("SIMD level " + toString(level) + " is not supported by this CPU");
+        }
+        switch (level) {
+#ifdef LJ_KERNELS_X86
+            case SimdLevel::avx512:
+                return computeAVX512;
+            case SimdLevel::avx2:
+                return computeAVX2;
+#endif
+            default:
+                return computeScalar;
+        }
+    }
+
+    std::string toString(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::avx512:
+                return "AVX-512";
+            case SimdLevel::avx2:
+                return "AVX2";
+            default:
+                return "Scalar";
+        }
+    }
+}
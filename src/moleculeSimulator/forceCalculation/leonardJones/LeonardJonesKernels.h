@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+
+#include "LeonardJonesTypeRegistry.h"
+#include "particleRepresentation/particle/ParticleSoA.h"
+
+/**
+ * @brief Kernels calculating the Leonard-Jones forces between one particle and a range of partner particles
+ *        stored as structure of arrays.
+ *
+ * Besides the scalar kernel there are explicitly vectorised kernels processing 4 (AVX2) or 8 (AVX-512) partners
+ * at once. Which kernels can be used is decided at runtime by querying the CPU, so the same binary runs on all machines.
+ */
+namespace LeonardJonesKernels {
+    /**
+     * Instruction set extensions the kernels are available for, ordered by vector width.
+     */
+    enum class SimdLevel {
+        scalar, avx2, avx512
+    };
+
+    /**
+     * @brief Signature of all kernels.
+     *
+     * @param target Buffer containing the target particle.
+     * @param i Index of the target particle in its buffer.
+     * @param sources Buffer containing the partner particles. May be the same buffer as target.
+     * @param begin Index of the first partner particle.
+     * @param end Index after the last partner particle.
+     * @param rCutOffSquared Squared cut-off radius. Only pairs with a squared distance smaller or equal interact.
+     * @param registry Registry holding the mixed constants of the parameter types of the particles.
+     *
+     * The force on the target is accumulated and added once to target.f, the opposite forces are subtracted
+     * from sources.f (Newton's third law of motion). If both buffers are the same, the target must not lie in [begin, end).
+     */
+    using Kernel = void (*)(ParticleSoA &target, size_t i, ParticleSoA &sources, size_t begin, size_t end,
+                            double rCutOffSquared, const LeonardJonesTypeRegistry &registry);
+
+    /**
+     * @brief Determine the widest instruction set extension supported by the CPU the program is running on.
+     *
+     * @return Best supported SIMD level.
+     */
+    SimdLevel detectSimdLevel();
+
+    /**
+     * @brief Get the kernel for a specific SIMD level.
+     *
+     * @param level SIMD level of the kernel.
+     *
+     * @return Corresponding kernel.
+     *
+     * Throws std::invalid_argument, if the CPU does not support the requested level.
+     */
+    Kernel getKernel(SimdLevel level);
+
+    /**
+     * @brief Convert a SIMD level to a human readable string.
+     *
+     * @param level SIMD level to convert.
+     *
+     * @return Corresponding string.
+     */
+    std::string toString(SimdLevel level);
+}
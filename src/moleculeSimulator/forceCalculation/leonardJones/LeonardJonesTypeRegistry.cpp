@@ -0,0 +1,33 @@
+#include "LeonardJonesTypeRegistry.h"
+
+#include <cmath>
+
+LeonardJonesTypeRegistry::LeonardJonesTypeRegistry() {
+    registerType(1, 5);
+}
+
+void LeonardJonesTypeRegistry::buildTables() {
+    numberOfTypes = static_cast<int>(parameters.size());
+    sigmaSquared.resize(numberOfTypes * numberOfTypes);
+    twentyFourEpsilon.resize(numberOfTypes * numberOfTypes);
+    for (int i = 0; i < numberOfTypes; i++) {
+        for (int j = 0; j < numberOfTypes; j++) {
+            //compute mixing constants
+            double sigma_ij = (parameters[i].first + parameters[j].first) / 2;
+            double epsilon_ij = std::sqrt(parameters[i].second * parameters[j].second);
+            sigmaSquared[i * numberOfTypes + j] = sigma_ij * sigma_ij;
+            twentyFourEpsilon[i * numberOfTypes + j] = 24 * epsilon_ij;
+        }
+    }
+}
+
+int LeonardJonesTypeRegistry::registerType(double sigma, double epsilon) {
+    for (size_t i = 0; i < parameters.size(); i++) {
+        if (parameters[i].first == sigma && parameters[i].second == epsilon) {
+            return static_cast<int>(i);
+        }
+    }
+    parameters.emplace_back(sigma, epsilon);
+    buildTables();
+    return numberOfTypes - 1;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Registry of all distinct pairs of Leonard-Jones parameters (sigma, epsilon) used in a simulation.
+ *
+ * Each distinct pair is assigned a parameter type when it is registered. For all combinations of two parameter types
+ * the mixed constants (Lorentz-Berthelot mixing rule) needed by the Leonard-Jones force are precomputed and stored in
+ * dense tables, so the force calculation only needs a single table lookup per pair instead of recomputing sigma_ij and
+ * the square root of epsilon_ij.
+ *
+ * The registry is owned by a LeonardJonesForce and filled while the particles are added to a model, before the force
+ * calculation starts. Registering a new type rebuilds the tables, which invalidates the pointers returned by
+ * getSigmaSquaredTable() and getTwentyFourEpsilonTable(). Types must not be registered concurrently to the force
+ * calculation. The default parameters of a particle are always registered as parameter type 0.
+ */
+class LeonardJonesTypeRegistry {
+private:
+    /**
+     * Parameters (sigma, epsilon) of each registered type.
+     */
+    std::vector<std::pair<double, double>> parameters;
+
+    /**
+     * sigma_ij² for all pairs of types, stored row by row.
+     */
+    std::vector<double> sigmaSquared;
+
+    /**
+     * 24 * epsilon_ij for all pairs of types, stored row by row.
+     */
+    std::vector<double> twentyFourEpsilon;
+
+    /**
+     * Number of registered types (length of one row of the tables).
+     */
+    int numberOfTypes = 0;
+
+    /**
+     * @brief Recompute the tables of the mixed constants for all registered types.
+     */
+    void buildTables();
+
+public:
+    /**
+     * @brief Create a registry containing the default parameters of a particle (sigma = 1, epsilon = 5) as type 0.
+     */
+    LeonardJonesTypeRegistry();
+
+    /**
+     * @brief Get the parameter type of a pair of Leonard-Jones parameters. The type is registered, if it is not known yet.
+     *
+     * @param sigma Leonard-Jones parameter sigma.
+     * @param epsilon Leonard-Jones parameter epsilon.
+     *
+     * @return Parameter type.
+     */
+    int registerType(double sigma, double epsilon);
+
+    /**
+     * @brief Get the number of registered parameter types.
+     *
+     * @return Number of registered parameter types.
+     */
+    [[nodiscard]] int getNumberOfTypes() const {
+        return numberOfTypes;
+    }
+
+    /**
+     * @brief Get the parameters of all registered types, ordered by their parameter type.
+     *
+     * @return Pairs (sigma, epsilon).
+     */
+    [[nodiscard]] const std::vector<std::pair<double, double>> &getParameters() const {
+        return parameters;
+    }
+
+    /**
+     * @brief Check if a parameter type has been registered with a pair of Leonard-Jones parameters.
+     *
+     * @param type Parameter type.
+     * @param sigma Leonard-Jones parameter sigma.
+     * @param epsilon Leonard-Jones parameter epsilon.
+     *
+     * @return True, if the type is registered with exactly these parameters.
+     */
+    [[nodiscard]] bool hasParameters(int type, double sigma, double epsilon) const {
+        return type >= 0 && type < numberOfTypes && parameters[type] == std::pair{sigma, epsilon};
+    }
+
+    /**
+     * @brief Get sigma_ij² of two parameter types.
+     *
+     * @param type1 Parameter type of the first particle.
+     * @param type2 Parameter type of the second particle.
+     *
+     * @return Squared mixed sigma.
+     */
+    [[nodiscard]] double getSigmaSquared(int type1, int type2) const {
+        return sigmaSquared[type1 * numberOfTypes + type2];
+    }
+
+    /**
+     * @brief Get 24 * epsilon_ij of two parameter types.
+     *
+     * @param type1 Parameter type of the first particle.
+     * @param type2 Parameter type of the second particle.
+     *
+     * @return Mixed epsilon multiplied by 24.
+     */
+    [[nodiscard]] double getTwentyFourEpsilon(int type1, int type2) const {
+        return twentyFourEpsilon[type1 * numberOfTypes + type2];
+    }
+
+    /**
+     * @brief Get the table of sigma_ij², e.g. for gathering multiple values at once.
+     *
+     * @return Pointer to the first entry. The entry of types i and j is at i * getNumberOfTypes() + j.
+     */
+    [[nodiscard]] const double *getSigmaSquaredTable() const {
+        return sigmaSquared.data();
+    }
+
+    /**
+     * @brief Get the table of 24 * epsilon_ij, e.g. for gathering multiple values at once.
+     *
+     * @return Pointer to the first entry. The entry of types i and j is at i * getNumberOfTypes() + j.
+     */
+    [[nodiscard]] const double *getTwentyFourEpsilonTable() const {
+        return twentyFourEpsilon.data();
+    }
+};
@@ -28,10 +28,13 @@ double Thermostat::calculateKineticEnergy() {
 }
 
 double Thermostat::calculateTemperature() {
-    if(model.particles.size() == 0) {
+    //If the simulation is distributed over several processes, the temperature is the one of the whole system
+    std::vector<double> sums{calculateKineticEnergy(), static_cast<double>(model.particles.size())};
+    model.sumOverSubdomains(sums);
+    if(sums[1] == 0) {
         throw std::invalid_argument("Temperature given when none expected.");
     }
-    return 2 * calculateKineticEnergy() / (static_cast<double>(model.particles.size()) * dimensions);
+    return 2 * sums[0] / (sums[1] * dimensions);
 }
 
 void Thermostat::setTemperatureOfTheSystemViaVelocityScaling() {
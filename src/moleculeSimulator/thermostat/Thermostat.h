@@ -29,7 +29,8 @@ public:
     /**
        * @brief Helper method to calculate the current kinetic energy of the system.
        *
-       * @return Current kinetic energy of the system.
+       * @return Current kinetic energy of the system. If the model is distributed over several processes, only the
+       *         kinetic energy of the particles of this process.
        */
     double calculateKineticEnergy();
 
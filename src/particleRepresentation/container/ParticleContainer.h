@@ -4,6 +4,7 @@
 
 #pragma once
 #include "particleRepresentation/particle/Particle.h"
+#include "profiling/MemoryFootprint.h"
 
 /**
  * Abstract base class for a particle container. Each type of a particle container should extend this class.
@@ -21,6 +22,11 @@ public:
 
     virtual void add(Particle& p) = 0;
 
+    /**
+     * @brief Remove all particles from this container.
+     */
+    virtual void clear() = 0;
+
     /**
      * @brief Get the number of particles stored in this container.
      *
@@ -53,6 +59,13 @@ public:
     */
     virtual void applyToAllUniquePairsInDomain(const std::function<void(Particle&, Particle&)> &function) = 0;
 
+    /**
+     * @brief Add the bytes held by the data structures of this container to a memory footprint.
+     *
+     * @param footprint Footprint to add to.
+     */
+    virtual void accountMemory(MemoryFootprint &footprint) const = 0;
+
    /**
     *@brief Virtual default constructor to guarantee appropriate memory clean up
     */
@@ -4,6 +4,8 @@
 
 #include "DefaultParticleContainer.h"
 
+#include <stdexcept>
+
 
 DefaultParticleContainer::DefaultParticleContainer(size_t capacity) {
     particles.reserve(capacity);
@@ -13,6 +15,10 @@ void DefaultParticleContainer::add(Particle &p) {
     particles.push_back(std::move(p));
 }
 
+void DefaultParticleContainer::clear() {
+    particles.clear();
+}
+
 Particle &DefaultParticleContainer::at(size_t i) {
     return particles.at(i);
 }
@@ -21,6 +27,13 @@ size_t DefaultParticleContainer::size() const {
     return particles.size();
 }
 
+void DefaultParticleContainer::setThreads(int threads) {
+    if (threads < 1) {
+        throw std::invalid_argument("The number of threads has to be at least 1.");
+    }
+    this->threads = threads;
+}
+
 size_t DefaultParticleContainer::capacity() {
     return particles.capacity();
 }
@@ -37,6 +50,19 @@ void DefaultParticleContainer::reserve(size_t n) {
     particles.reserve(n);
 }
 
+void DefaultParticleContainer::copyFrom(ParticleContainer &other) {
+    size_t i = 0;
+    other.applyToEachParticle([this, &i](Particle &p) {
+        if (i < particles.size()) {
+            particles[i] = p;
+        } else {
+            particles.push_back(p);
+        }
+        i++;
+    });
+    particles.erase(particles.begin() + static_cast<long>(i), particles.end());
+}
+
 bool DefaultParticleContainer::contains(Particle &p) {
     for (Particle &toCheck: particles) {
         if (toCheck == p) {
@@ -47,22 +73,26 @@ bool DefaultParticleContainer::contains(Particle &p) {
 }
 
 void DefaultParticleContainer::applyToEachParticle(const std::function<void(Particle &)> &function) {
-    for(Particle& p : particles) {
-        function(p);
-    }
+    forEachParticle(function);
 }
 
 void DefaultParticleContainer::applyToEachParticleInDomain(const std::function<void(Particle &)> &function) {
-    applyToEachParticle(function);
+    forEachParticleInDomain(function);
 }
 
 void DefaultParticleContainer::applyToAllUniquePairsInDomain(
     const std::function<void(Particle &, Particle &)> &function) {
-    for (auto p_i = particles.begin(); p_i != particles.end(); std::advance(p_i,1)) {
-        for (auto p_j = std::next(p_i); p_j != particles.end(); std::advance(p_j,1)) {
-           function(*p_i, *p_j);
+    forEachUniquePairInDomain(function);
+}
+
+void DefaultParticleContainer::accountMemory(MemoryFootprint &footprint) const {
+    footprint.add(MemoryCategory::particles, particles.size() * sizeof(Particle));
+    footprint.add(MemoryCategory::cellSlack, (particles.capacity() - particles.size()) * sizeof(Particle));
+    size_t tileBytes = MemoryFootprint::bytesOf(threadTiles);
+    for (auto &tiles: threadTiles) {
+        for (auto &tile: tiles) {
+            tileBytes += tile.capacityBytes();
         }
     }
+    footprint.add(MemoryCategory::workBuffers, MemoryFootprint::bytesOf(tilePairs) + tileBytes);
 }
-
-
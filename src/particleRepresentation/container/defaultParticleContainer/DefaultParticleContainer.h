@@ -5,21 +5,42 @@
 #pragma once
 
 #include "particleRepresentation/particle/Particle.h"
+#include <algorithm>
+#include <omp.h>
+#include <utility>
 #include <vector>
 
 #include "../ParticleContainer.h"
+#include "particleRepresentation/particle/ParticleSoA.h"
+#include "profiling/Tracer.h"
 
 /**
  * @brief Container to store the particles for simulation using the direct sum algorithm.
  *
  * The storage of the particles is based on std::vector. This guarantees fast iteration over the particles, because
  * they are stored consecutively in memory.
+ *
+ * For the force calculation the particles are copied into tiles of tileSize consecutive particles stored as structure
+ * of arrays, so that the forces can use their vectorised kernels and the particles of two tiles stay in the L1 cache
+ * while all pairs between them are processed.
  */
 
 class DefaultParticleContainer : public ParticleContainer {
 private:
     std::vector<Particle> particles;
 
+    //Number of particles per tile. Two tiles (about 15 KB) fit into the L1 cache together.
+    static constexpr size_t tileSize = 128;
+
+    //Number of threads used by applyForcesToAllUniqueTilePairs()
+    int threads = 1;
+
+    //All pairs of tiles (i, j) with i <= j, kept between force calculations to avoid allocations
+    std::vector<std::pair<size_t, size_t>> tilePairs;
+
+    //Tiles of each thread, kept between force calculations to avoid allocations
+    std::vector<std::vector<ParticleSoA>> threadTiles;
+
 public:
     DefaultParticleContainer() = default;
 
@@ -41,6 +62,11 @@ public:
      */
     void add(Particle &p) override;
 
+    /**
+     * @brief Remove all particles from this container.
+     */
+    void clear() override;
+
     /**
      * @brief Obtain particle at position i.
      *
@@ -95,6 +121,16 @@ public:
      */
     void reserve(size_t n);
 
+    /**
+     * @brief Replace the content of this container by copies of all particles of another container.
+     *
+     * @param other Container to copy the particles from.
+     *
+     * The storage of the particles already in this container is reused, so taking repeated snapshots of a container
+     * of constant size does not allocate.
+     */
+    void copyFrom(ParticleContainer &other);
+
     /**
      * @brief Check, if this particle container contains an particle p' that equals p.
      *
@@ -106,6 +142,69 @@ public:
      */
     bool contains(Particle &p);
 
+    /**
+     * @brief Iterate over all particles in this container and apply a functor to them.
+     *
+     * @param function Functor that is applied to each particle.
+     *
+     * In contrast to applyToEachParticle() the functor is a template parameter, so it can be inlined.
+     */
+    template<typename F>
+    void forEachParticle(F &&function) {
+        for (Particle &p: particles) {
+            function(p);
+        }
+    }
+
+    /**
+     * @brief Iterate over all particles that are part of the domain (in this container all particles) and apply a functor to them.
+     *
+     * @param function Functor that is applied to each particle.
+     */
+    template<typename F>
+    void forEachParticleInDomain(F &&function) {
+        forEachParticle(function);
+    }
+
+    /**
+     * @brief Iterate over all unique pairs of particles (in this container all particles) and apply a functor to them.
+     *
+     * @param function Functor that is applied to each unique pair of particles.
+     *
+     * The first particle of a pair is always stored before the second one.
+     */
+    template<typename F>
+    void forEachUniquePairInDomain(F &&function) {
+        for (size_t i = 0; i < particles.size(); i++) {
+            for (size_t j = i + 1; j < particles.size(); j++) {
+                function(particles[i], particles[j]);
+            }
+        }
+    }
+
+    /**
+     * @brief Calculate the forces between all unique pairs of particles tile by tile and add them to the particles.
+     *
+     * @param withinTile Functor adding the forces between all pairs of particles within one tile to that tile.
+     * @param betweenTiles Functor adding the forces between all pairs of particles of two different tiles to both tiles.
+     *
+     * The pairs of tiles are distributed dynamically over the threads (see setThreads()). Each thread loads its own
+     * copy of the tiles, whose forces are added to the particles afterwards. The forces are not reset before.
+     */
+    template<typename W, typename B>
+    void applyForcesToAllUniqueTilePairs(W &&withinTile, B &&betweenTiles);
+
+    /**
+     * @brief Set the number of threads used by applyForcesToAllUniqueTilePairs().
+     *
+     * @param threads Number of threads.
+     */
+    void setThreads(int threads);
+
+    [[nodiscard]] int getThreads() const {
+        return threads;
+    }
+
     /**
      * @brief Iterate over all particles in this container and apply a lambda function to them.
      *
@@ -132,4 +231,63 @@ public:
      * Newton's third law of motion.
      */
     void applyToAllUniquePairsInDomain(const std::function<void(Particle &, Particle &)> &function) override;
+
+    /**
+     * @brief Add the bytes of the particles, the unused capacity of their storage and the buffers of the parallel force
+     *        calculation to a memory footprint.
+     *
+     * @param footprint Footprint to add to.
+     */
+    void accountMemory(MemoryFootprint &footprint) const override;
 };
+
+template<typename W, typename B>
+void DefaultParticleContainer::applyForcesToAllUniqueTilePairs(W &&withinTile, B &&betweenTiles) {
+    const size_t numberTiles = (particles.size() + tileSize - 1) / tileSize;
+    if (tilePairs.size() != numberTiles * (numberTiles + 1) / 2) {
+        tilePairs.clear();
+        for (size_t tileI = 0; tileI < numberTiles; tileI++) {
+            for (size_t tileJ = tileI; tileJ < numberTiles; tileJ++) {
+                tilePairs.emplace_back(tileI, tileJ);
+            }
+        }
+    }
+    threadTiles.resize(threads);
+    const int numberTilePairs = static_cast<int>(tilePairs.size());
+    const int numberParticles = static_cast<int>(particles.size());
+
+    #pragma omp parallel num_threads(threads)
+    {
+        TRACE_SPAN("pair forces (tiles)");
+        auto &tiles = threadTiles[omp_get_thread_num()];
+        tiles.resize(numberTiles);
+        for (size_t t = 0; t < numberTiles; t++) {
+            const size_t begin = t * tileSize;
+            tiles[t].load(particles.data() + begin, std::min(tileSize, particles.size() - begin));
+        }
+
+        //Diagonal tiles contain only half of the pairs, so the pairs of tiles are distributed dynamically
+        #pragma omp for schedule(dynamic)
+        for (int t = 0; t < numberTilePairs; t++) {
+            const auto [tileI, tileJ] = tilePairs[t];
+            if (tileI == tileJ) {
+                withinTile(tiles[tileI]);
+            } else {
+                betweenTiles(tiles[tileI], tiles[tileJ]);
+            }
+        }
+
+        //Reduce all tiles. The implicit barrier of the loop above guarantees that all tiles are complete.
+        #pragma omp for schedule(static)
+        for (int i = 0; i < numberParticles; i++) {
+            std::array<double, 3> force = particles[i].getF();
+            for (auto &otherTiles: threadTiles) {
+                const ParticleSoA &tile = otherTiles[i / tileSize];
+                for (int d = 0; d < 3; d++) {
+                    force[d] += tile.f[d][i % tileSize];
+                }
+            }
+            particles[i].setF(force);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include "CellArena.h"
+
+#include <algorithm>
+#include <memory>
+#include <new>
+
+CellArena::CellArena(size_t minimumSlabCapacity) : minimumSlabCapacity{std::max<size_t>(minimumSlabCapacity, 1)} {
+}
+
+CellArena::~CellArena() {
+    std::allocator<Particle> heap;
+    for (auto &[slab, capacity]: slabs) {
+        heap.deallocate(slab, capacity);
+    }
+}
+
+size_t CellArena::sizeClass(size_t n) {
+    if (n <= 1) {
+        return 0;
+    }
+    //Smallest k with n <= 2^k
+    size_t k = 1;
+    while ((size_t{1} << k) < n) {
+        k++;
+    }
+    //Between 2^(k-1) and 2^k lies the size class 3 * 2^(k-2)
+    return k >= 2 && n <= (size_t{3} << (k - 2)) ? 2 * k - 2 : 2 * k - 1;
+}
+
+size_t CellArena::capacityOfSizeClass(size_t index) {
+    if (index == 0) {
+        return 1;
+    }
+    return index % 2 == 1 ? size_t{1} << ((index + 1) / 2) : size_t{3} << (index / 2 - 1);
+}
+
+size_t CellArena::blockCapacity(size_t n) {
+    return capacityOfSizeClass(sizeClass(n));
+}
+
+Particle *CellArena::allocate(size_t n) {
+    const size_t index = sizeClass(n);
+    const size_t capacity = capacityOfSizeClass(index);
+    blockCapacities += capacity;
+    //Reuse a released block of the same size class
+    if (FreeBlock *block = freeBlocks[index]) {
+        freeBlocks[index] = block->next;
+        return reinterpret_cast<Particle *>(block);
+    }
+    if (static_cast<size_t>(end - next) < capacity) {
+        addSlab(capacity);
+    }
+    Particle *block = next;
+    next += capacity;
+    return block;
+}
+
+void CellArena::deallocate(Particle *block, size_t n) noexcept {
+    const size_t index = sizeClass(n);
+    blockCapacities -= capacityOfSizeClass(index);
+    release(block, index);
+}
+
+void CellArena::reserve(size_t n) {
+    if (static_cast<size_t>(end - next) < n) {
+        addSlab(n);
+    }
+}
+
+void CellArena::release(Particle *block, size_t index) noexcept {
+    freeBlocks[index] = ::new(static_cast<void *>(block)) FreeBlock{freeBlocks[index]};
+}
+
+void CellArena::addSlab(size_t n) {
+    //Keep the rest of the current slab as blocks of the largest size classes fitting into it
+    while (next != end) {
+        const auto remaining = static_cast<size_t>(end - next);
+        size_t index = sizeClass(remaining);
+        if (capacityOfSizeClass(index) > remaining) {
+            index--;
+        }
+        release(next, index);
+        next += capacityOfSizeClass(index);
+    }
+    //Growing by half of the current capacity keeps the number of heap allocations logarithmic
+    const size_t capacity = std::max({n, minimumSlabCapacity, slabCapacity / 2});
+    Particle *slab = std::allocator<Particle>().allocate(capacity);
+    slabs.emplace_back(slab, capacity);
+    slabCapacity += capacity;
+    next = slab;
+    end = slab + capacity;
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "particleRepresentation/particle/Particle.h"
+
+/**
+ * @brief Slab pool for the particle storage of the cells of a LinkedCellsContainer.
+ *
+ * The storage is carved from a few large slabs instead of being requested from the heap cell by cell. Blocks are
+ * handed out in size classes of 1, 2, 3, 4, 6, 8, 12, 16, ... particles, so the capacity of a growing cell always
+ * matches a size class. Released blocks are kept in a free list per size class and handed out again, so once the
+ * cells have reached their typical sizes, no further heap allocation takes place. Slabs are only released together
+ * with the arena.
+ *
+ * The arena is not thread-safe. The cells must only be resized by one thread at a time.
+ */
+class CellArena {
+public:
+    /**
+     * @brief Constructor of the CellArena class.
+     *
+     * @param minimumSlabCapacity Minimal number of particles of a newly allocated slab.
+     */
+    explicit CellArena(size_t minimumSlabCapacity = 1024);
+
+    ~CellArena();
+
+    CellArena(const CellArena &) = delete;
+
+    CellArena &operator=(const CellArena &) = delete;
+
+    /**
+     * @brief Get the storage for a number of particles. The storage is not initialized.
+     *
+     * @param n Number of particles.
+     *
+     * @return Pointer to a block of blockCapacity(n) particles.
+     */
+    Particle *allocate(size_t n);
+
+    /**
+     * @brief Return a block to the free list of its size class.
+     *
+     * @param block Block obtained from allocate().
+     * @param n Number of particles passed to allocate().
+     */
+    void deallocate(Particle *block, size_t n) noexcept;
+
+    /**
+     * @brief Make sure that the next blocks with a total capacity of n particles are carved from a single slab
+     *        without any further heap allocation, i.e. consecutively in memory.
+     *
+     * @param n Number of particles.
+     */
+    void reserve(size_t n);
+
+    /**
+     * @brief Get the capacity of the smallest size class holding a number of particles.
+     *
+     * @param n Number of particles.
+     *
+     * @return Capacity of the size class.
+     */
+    static size_t blockCapacity(size_t n);
+
+    /**
+     * @brief Get the bytes of all slabs, i.e. the heap memory held by the arena.
+     *
+     * @return Bytes of all slabs.
+     */
+    [[nodiscard]] size_t getSlabBytes() const {
+        return slabCapacity * sizeof(Particle);
+    }
+
+    /**
+     * @brief Get the bytes of all blocks currently in use.
+     *
+     * @return Bytes of all blocks handed out and not returned yet.
+     */
+    [[nodiscard]] size_t getBlockBytes() const {
+        return blockCapacities * sizeof(Particle);
+    }
+
+    /**
+     * @brief Get the number of heap allocations made by the arena so far.
+     *
+     * @return Number of slabs.
+     */
+    [[nodiscard]] size_t getSlabCount() const {
+        return slabs.size();
+    }
+
+private:
+    /**
+     * @brief Released block, linked to the next released block of the same size class.
+     */
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    static_assert(sizeof(Particle) >= sizeof(FreeBlock), "A released block has to hold the link of the free list");
+
+    //Size classes up to 3 * 2^62 particles
+    static constexpr size_t numberOfSizeClasses = 126;
+
+    /**
+     * @brief Get the size class of a number of particles.
+     *
+     * @param n Number of particles.
+     *
+     * @return Index of the smallest size class holding n particles.
+     */
+    static size_t sizeClass(size_t n);
+
+    /**
+     * @brief Get the capacity of a size class.
+     *
+     * @param index Index of the size class.
+     *
+     * @return Number of particles of the blocks of that size class.
+     */
+    static size_t capacityOfSizeClass(size_t index);
+
+    /**
+     * @brief Put a released block into its free list.
+     *
+     * @param block Block.
+     * @param index Index of the size class of the block.
+     */
+    void release(Particle *block, size_t index) noexcept;
+
+    /**
+     * @brief Allocate a new slab. The rest of the current slab is split into blocks of the free lists.
+     *
+     * @param n Number of particles the new slab has to hold at least.
+     */
+    void addSlab(size_t n);
+
+    size_t minimumSlabCapacity;
+
+    //Slabs allocated from the heap and their capacity
+    std::vector<std::pair<Particle *, size_t>> slabs;
+
+    //Capacity of all slabs
+    size_t slabCapacity = 0;
+
+    //Capacity of all blocks handed out and not returned yet
+    size_t blockCapacities = 0;
+
+    //Next unused particle of the latest slab and the end of that slab
+    Particle *next = nullptr;
+    Particle *end = nullptr;
+
+    //Heads of the free lists of all size classes
+    std::array<FreeBlock *, numberOfSizeClasses> freeBlocks{};
+};
+
+/**
+ * @brief Allocator handing out the storage of a cell from a CellArena.
+ *
+ * The allocator is propagated together with the cell, so cells can be swapped and moved within the same container.
+ * The arena has to outlive all cells using it.
+ */
+template<typename T>
+class CellAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit CellAllocator(CellArena *arena) noexcept: arena{arena} {
+    }
+
+    template<typename U>
+    CellAllocator(const CellAllocator<U> &other) noexcept: arena{other.getArena()} {
+    }
+
+    T *allocate(size_t n) {
+        static_assert(std::is_same_v<T, Particle>, "The cell arena only stores particles");
+        return arena->allocate(n);
+    }
+
+    void deallocate(T *block, size_t n) noexcept {
+        arena->deallocate(block, n);
+    }
+
+    [[nodiscard]] CellArena *getArena() const noexcept {
+        return arena;
+    }
+
+    friend bool operator==(const CellAllocator &a, const CellAllocator &b) noexcept {
+        return a.arena == b.arena;
+    }
+
+    friend bool operator!=(const CellAllocator &a, const CellAllocator &b) noexcept {
+        return a.arena != b.arena;
+    }
+
+private:
+    CellArena *arena;
+};
+
+/**
+ * Storage of the particles of one cell.
+ */
+using ParticleCell = std::vector<Particle, CellAllocator<Particle>>;
@@ -4,6 +4,11 @@
 
 #include "LinkedCellsContainer.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include "utils/SpaceFillingCurve.h"
+
 using namespace enumsStructs;
 
 void LinkedCellsContainer::calculateHaloCellIndices() {
@@ -74,11 +79,57 @@ void LinkedCellsContainer::calculateBoundaryCellIndices() {
     }
 }
 
+void LinkedCellsContainer::calculateCellOrdering() {
+    if (cellOrdering == CellOrdering::rowMajor) {
+        return;
+    }
+    //Sort the row-major indices of all cells by their key along the curve
+    const int bits = SpaceFillingCurve::bitsFor(static_cast<uint32_t>(std::max({nX, nY, nZ})));
+    const int numberCells = nX * nY * nZ;
+    std::vector<uint64_t> keys(numberCells);
+    for (int index = 0; index < numberCells; index++) {
+        std::array<uint32_t, 3> coordinates{static_cast<uint32_t>(index % baseY),
+                                            static_cast<uint32_t>((index % baseZ) / baseY),
+                                            static_cast<uint32_t>(index / baseZ)};
+        keys[index] = cellOrdering == CellOrdering::morton
+                          ? SpaceFillingCurve::mortonKey(coordinates, bits)
+                          : SpaceFillingCurve::hilbertKey(coordinates, bits, twoD ? 2 : 3);
+    }
+    rowMajorIndices.resize(numberCells);
+    std::iota(rowMajorIndices.begin(), rowMajorIndices.end(), 0);
+    std::sort(rowMajorIndices.begin(), rowMajorIndices.end(), [&keys](int a, int b) {
+        return keys[a] < keys[b];
+    });
+    cellIndices.resize(numberCells);
+    for (int index = 0; index < numberCells; index++) {
+        cellIndices[rowMajorIndices[index]] = index;
+    }
+}
+
 void LinkedCellsContainer::calculateDomainCellsIterationScheme() {
     //constants to handle 2D edge case
     int Z1 = !twoD;
     int Z2 = twoD ? 0 : nZ - 2;
 
+    //Relevant neighbours of a cell
+    //
+    //         z-1         z           z+1
+    //
+    //       ^ ooo      ^ xxx        ^ xxx          c: current cell
+    //     y | ooo    y | ocx     y  | xxx          x: ignored adjacent cells
+    //       | ooo      | ooo        | xxx          o: considered adjacent cells
+    //        ----->     ----->       ----->
+    //         x          x            x
+    std::vector<std::array<int, 3>> offsets{{-1, -1, 0}, {-1, 0, 0}, {0, -1, 0}, {1, -1, 0}};
+    //For 3D 9 more cells do exist.
+    if (!twoD) {
+        for (int y = -1; y <= 1; y++) {
+            for (int x = -1; x <= 1; x++) {
+                offsets.push_back({x, y, -1});
+            }
+        }
+    }
+
     //initialize data structure
     int cellNumber = (nX - 2) * (nY - 2) * (twoD ? 1 : nZ - 2);
     domainCellIterationScheme.reserve(cellNumber);
@@ -93,97 +144,119 @@ void LinkedCellsContainer::calculateDomainCellsIterationScheme() {
                 //First insert the cell itself
                 domainCellIterationScheme[index].push_back(threeDToOneD(x, y, z));
 
-                //Then insert all relevant neighbours
-                //
-                //         z-1         z           z+1
-                //
-                //       ^ ooo      ^ xxx        ^ xxx          c: current cell
-                //     y | ooo    y | ocx     y  | xxx          x: ignored adjacent cells
-                //       | ooo      | ooo        | xxx          o: considered adjacent cells
-                //        ----->     ----->       ----->
-                //         x          x            x
-
-                //(x-1, y-1, z)
-                if (x >= 2 && y >= 2) {
-                    domainCellIterationScheme[index].push_back(threeDToOneD(x - 1, y - 1, z));
-                }
-                //(x-1, y, z)
-                if (x >= 2) {
-                    domainCellIterationScheme[index].push_back(threeDToOneD(x - 1, y, z));
-                }
-                //(x, y-1, z)
-                if (y >= 2) {
-                    domainCellIterationScheme[index].push_back(threeDToOneD(x, y - 1, z));
-                }
-                //(x+1, y-1, z)
-                if (x <= nX - 3 && y >= 2) {
-                    domainCellIterationScheme[index].push_back(threeDToOneD(x + 1, y - 1, z));
-                }
-                //For 3D possibly up to 9 more cells do exist.
-                if (z >= 2) {
-                    //(x - 1, y - 1, z - 1)
-                    if (x >= 2 && y >= 2) {
-                        domainCellIterationScheme[index].push_back(threeDToOneD(x - 1, y - 1, z - 1));
-                    }
-                    //(x - 1, y, z - 1)
-                    if (x >= 2) {
-                        domainCellIterationScheme[index].push_back(threeDToOneD(x - 1, y, z - 1));
-                    }
-                    //(x, y - 1, z - 1)
-                    if (y >= 2) {
-                        domainCellIterationScheme[index].push_back(threeDToOneD(x, y - 1, z - 1));
-                    }
-                    //(x + 1, y - 1, z - 1)
-                    if (x <= nX - 3 && y >= 2) {
-                        domainCellIterationScheme[index].push_back(threeDToOneD(x + 1, y - 1, z - 1));
-                    }
-                    //(x - 1, y + 1, z - 1)
-                    if (x >= 2 && y <= nY - 3) {
-                        domainCellIterationScheme[index].push_back(threeDToOneD(x - 1, y + 1, z - 1));
-                    }
-                    //(x, y + 1, z - 1)
-                    if (y <= nY - 3) {
-                        domainCellIterationScheme[index].push_back(threeDToOneD(x, y + 1, z - 1));
+                //Then insert all relevant neighbours. Neighbours across periodic boundaries are part of the ghost layer.
+                for (auto &offset: offsets) {
+                    std::array<int, 3> neighbour{x + offset[0], y + offset[1], z + offset[2]};
+                    if (isCellInDomain(neighbour) || isPeriodicHaloCell(neighbour)) {
+                        domainCellIterationScheme[index].push_back(threeDToOneD(neighbour[0], neighbour[1], neighbour[2]));
                     }
+                }
+                index++;
+            }
+        }
+    }
 
-                    //(x + 1, y + 1, z - 1)
-                    if (x <= nX - 3 && y <= nY - 3) {
-                        domainCellIterationScheme[index].push_back(threeDToOneD(x + 1, y + 1, z - 1));
-                    }
+    //Process the cells along the cell ordering
+    if (cellOrdering != CellOrdering::rowMajor) {
+        std::sort(domainCellIterationScheme.begin(), domainCellIterationScheme.end(),
+                  [](const std::vector<int> &a, const std::vector<int> &b) {
+                      return a[0] < b[0];
+                  });
+    }
+}
 
-                    //(x + 1, y , z - 1)
-                    if (x <= nX - 3) {
-                        domainCellIterationScheme[index].push_back(threeDToOneD(x + 1, y, z - 1));
-                    }
+void LinkedCellsContainer::calculateGhostLayer() {
+    std::vector<bool> isGhostCell(cells.size(), false);
+    for (auto &cellGroup: domainCellIterationScheme) {
+        for (auto neighbour = cellGroup.begin() + 1; neighbour != cellGroup.end(); std::advance(neighbour, 1)) {
+            if (isGhostCell[*neighbour] || isCellInDomain(oneDToThreeD(*neighbour))) {
+                continue;
+            }
+            isGhostCell[*neighbour] = true;
+
+            //The images of halo cells of other subdomains are provided from outside
+            auto cell = oneDToThreeD(*neighbour);
+            if (isRemoteCell(cell)) {
+                ghostLayer.push_back({*neighbour, *neighbour, {0, 0, 0}, 0, true});
+                continue;
+            }
 
-                    //(x, y, z - 1)
-                    domainCellIterationScheme[index].push_back(threeDToOneD(x, y, z - 1));
+            //The images of the halo cell are taken from the boundary cell on the opposite side
+            auto source = cell;
+            std::array<double, 3> shift{0, 0, 0};
+            std::array<int, 3> n{nX, nY, nZ};
+            for (int dim = 0; dim < (twoD ? 2 : 3); dim++) {
+                if (cell[dim] == 0) {
+                    source[dim] = n[dim] - 2;
+                    shift[dim] = -domainSize[dim];
+                } else if (cell[dim] == n[dim] - 1) {
+                    source[dim] = 1;
+                    shift[dim] = domainSize[dim];
                 }
-                index++;
             }
+            ghostLayer.push_back({*neighbour, threeDToOneD(source[0], source[1], source[2]), shift, 0, false});
         }
     }
 }
 
+bool LinkedCellsContainer::isPeriodicHaloCell(std::array<int, 3> cell) const {
+    if (cell[0] < 0 || cell[0] >= nX || cell[1] < 0 || cell[1] >= nY || cell[2] < 0 || cell[2] >= nZ) {
+        return false;
+    }
+    if (isCellInDomain(cell)) {
+        return false;
+    }
+    //Each side the cell lies beyond has to be periodic or shared with another subdomain
+    auto periodic = [this](BoundaryCondition condition, Side side) {
+        return condition == BoundaryCondition::periodic || remoteSides[static_cast<int>(side)];
+    };
+    return (cell[0] != 0 || periodic(boundariesSet.left, Side::left))
+           && (cell[0] != nX - 1 || periodic(boundariesSet.right, Side::right))
+           && (cell[1] != 0 || periodic(boundariesSet.front, Side::front))
+           && (cell[1] != nY - 1 || periodic(boundariesSet.back, Side::back))
+           && (twoD || ((cell[2] != 0 || periodic(boundariesSet.bottom, Side::bottom))
+                        && (cell[2] != nZ - 1 || periodic(boundariesSet.top, Side::top))));
+}
+
+bool LinkedCellsContainer::isRemoteCell(std::array<int, 3> cell) const {
+    return (cell[0] == 0 && remoteSides[static_cast<int>(Side::left)])
+           || (cell[0] == nX - 1 && remoteSides[static_cast<int>(Side::right)])
+           || (cell[1] == 0 && remoteSides[static_cast<int>(Side::front)])
+           || (cell[1] == nY - 1 && remoteSides[static_cast<int>(Side::back)])
+           || (!twoD && ((cell[2] == 0 && remoteSides[static_cast<int>(Side::bottom)])
+                         || (cell[2] == nZ - 1 && remoteSides[static_cast<int>(Side::top)])));
+}
+
+void LinkedCellsContainer::calculateColourGroups() {
+    colourGroups.resize(twoD ? 9 : 18);
+    for (size_t i = 0; i < domainCellIterationScheme.size(); i++) {
+        auto cell = oneDToThreeD(domainCellIterationScheme[i][0]);
+        int colour = cell[0] % 3 + 3 * (cell[1] % 3) + 9 * (cell[2] % 2);
+        colourGroups[colour].push_back(static_cast<int>(i));
+    }
+}
+
 double LinkedCellsContainer::calcDistanceFromBoundary(Particle &p, Side side) {
+    //Position relative to the front lower left corner of the domain
+    auto x = p.getX() - origin;
     switch (side) {
         case Side::front: {
-            return p.getX()[1];
+            return x[1];
         }
         case Side::right: {
-            return domainSize[0] - p.getX()[0];
+            return domainSize[0] - x[0];
         }
         case Side::back: {
-            return domainSize[1] - p.getX()[1];
+            return domainSize[1] - x[1];
         }
         case Side::left: {
-            return p.getX()[0];
+            return x[0];
         }
         case Side::top: {
-            return domainSize[2] - p.getX()[2];
+            return domainSize[2] - x[2];
         }
         case Side::bottom: {
-            return p.getX()[2];
+            return x[2];
         }
     }
     throw std::invalid_argument("A boundary was specified that does not exist!");
@@ -191,193 +264,117 @@ double LinkedCellsContainer::calcDistanceFromBoundary(Particle &p, Side side) {
 
 std::array<double, 3> LinkedCellsContainer::calcGhostParticle(Particle &p, Side side) {
     std::array<double, 3> position = p.getX();
+    //Position relative to the front lower left corner of the domain
+    auto x = p.getX() - origin;
     switch (side) {
         case Side::front: {
-            position[1] -= 2 * p.getX()[1];
+            position[1] -= 2 * x[1];
         }
         break;
         case Side::right: {
-            position[0] += 2 * (domainSize[0] - p.getX()[0]);
+            position[0] += 2 * (domainSize[0] - x[0]);
         }
         break;
         case Side::back: {
-            position[1] += 2 * (domainSize[1] - p.getX()[1]);
+            position[1] += 2 * (domainSize[1] - x[1]);
         }
         break;
         case Side::left: {
-            position[0] -= 2 * p.getX()[0];
+            position[0] -= 2 * x[0];
         }
         break;
         case Side::top: {
-            position[2] += 2 * (domainSize[2] - p.getX()[2]);
+            position[2] += 2 * (domainSize[2] - x[2]);
         }
         break;
         case Side::bottom: {
-            position[2] -= 2 * p.getX()[2];
+            position[2] -= 2 * x[2];
         }
     }
     return position;
 }
 
 void LinkedCellsContainer::teleportParticlesToOppositeSideHelper(Side sideStart, int dimension, int modus) {
+    verletListsValid = false;
     for (auto &cell: haloCells[static_cast<int>(sideStart)]) {
-        for (auto p = cells[cell].begin(); p != cells[cell].end();) {
+        for (size_t i = 0; i < cells[cell].size();) {
+            Particle &p = cells[cell][i];
             //Update position
             if (modus == 0) {
 
-                p->setX(fromLowToHigh(p->getX(), dimension));
+                p.setX(fromLowToHigh(p.getX(), dimension));
             } else {
-                p->setX(fromHighToLow(p->getX(), dimension));
+                p.setX(fromHighToLow(p.getX(), dimension));
             }
             //Update cell if particle is back in domain
-            if (isParticleInDomain(p->getX())) {
-                cells[calcCellIndex(p->getX())].push_back(*p);
-                p = cells[cell].erase(p);
+            if (isParticleInDomain(p.getX())) {
+                //The last particle of the cell takes its place and has to be processed next
+                moveParticleToMigrationBuffer(cell, i, calcCellIndex(p.getX()));
             } else {
-                ++p;
+                ++i;
             }
         }
     }
+    flushMigrationBuffer();
 }
 
-void LinkedCellsContainer::applyForceToOppositeCellsHelper(Side side, std::array<int, 3> cellToProcess) {
-    std::array<int, 3> origin = cellToProcess;
-    switch (side) {
-        case Side::front: {
-            //Go to cell of opposite boundary back
-            origin[0] -= 1;
-            origin[1] = nY - 2;
-            origin[2] -= 1;
-
-            for (int x = 0; x < 3; x++) {
-                for (int z = 0; z < 3; z++) {
-                    if (isCellInDomain(origin)) {
-                        applyForcesBetweenTwoCells(threeDToOneD(cellToProcess[0], cellToProcess[1], cellToProcess[2]),
-                                                   threeDToOneD(origin[0], origin[1], origin[2]),
-                                                   {0, -domainSize[1], 0});
-                    }
-                    origin[2]++;
-                }
-                origin[2] -= 3;
-                origin[0]++;
-            }
-        }
-        break;
-        case Side::right: {
-            //Go to cell of opposite boundary left
-            origin[0] = 1;
-            origin[1] -= 1;
-            origin[2] -= 1;
-
-            for (int y = 0; y < 3; y++) {
-                for (int z = 0; z < 3; z++) {
-                    if (isCellInDomain(origin)) {
-                        applyForcesBetweenTwoCells(threeDToOneD(cellToProcess[0], cellToProcess[1], cellToProcess[2]),
-                                                   threeDToOneD(origin[0], origin[1], origin[2]),
-                                                   {domainSize[0], 0, 0});
-                    }
-                    origin[2]++;
-                }
-                origin[2] -= 3;
-                origin[1]++;
-            }
-        }
-        break;
-        case Side::back: {
-            //Go to cell of opposite boundary front
-            origin[0] -= 1;
-            origin[1] = 1;
-            origin[2] -= 1;
-
-            for (int x = 0; x < 3; x++) {
-                for (int z = 0; z < 3; z++) {
-                    if (isCellInDomain(origin)) {
-                        applyForcesBetweenTwoCells(threeDToOneD(cellToProcess[0], cellToProcess[1], cellToProcess[2]),
-                                                   threeDToOneD(origin[0], origin[1], origin[2]),
-                                                   {0, domainSize[1], 0});
-                    }
-                    origin[2]++;
-                }
-                origin[2] -= 3;
-                origin[0]++;
-            }
-        }
-        break;
-        case Side::left: {
-            //Go to cell of opposite boundary right
-            origin[0] = nX - 2;
-            origin[1] -= 1;
-            origin[2] -= 1;
-
-            for (int y = 0; y < 3; y++) {
-                for (int z = 0; z < 3; z++) {
-                    if (isCellInDomain(origin)) {
-                        applyForcesBetweenTwoCells(threeDToOneD(cellToProcess[0], cellToProcess[1], cellToProcess[2]),
-                                                   threeDToOneD(origin[0], origin[1], origin[2]),
-                                                   {-domainSize[0], 0, 0});
-                    }
-                    origin[2]++;
-                }
-                origin[2] -= 3;
-                origin[1]++;
-            }
-        }
-        break;
-        case Side::top: {
-            //Go to cell of opposite boundary bottom
-            origin[0] -= 1;
-            origin[1] -= 1;
-            origin[2] = 1;
-
-            for (int x = 0; x < 3; x++) {
-                for (int y = 0; y < 3; y++) {
-                    if (isCellInDomain(origin)) {
-                        applyForcesBetweenTwoCells(threeDToOneD(cellToProcess[0], cellToProcess[1], cellToProcess[2]),
-                                                   threeDToOneD(origin[0], origin[1], origin[2]),
-                                                   {0, 0, domainSize[2]});
-                    }
-                    origin[1]++;
-                }
-                origin[1] -= 3;
-                origin[0]++;
-            }
-        }
-        break;
-        case Side::bottom: {
-            //Go to cell of opposite boundary top
-            origin[0] -= 1;
-            origin[1] -= 1;
-            origin[2] = nZ - 2;
-
-            for (int x = 0; x < 3; x++) {
-                for (int y = 0; y < 3; y++) {
-                    if (isCellInDomain(origin)) {
-                        applyForcesBetweenTwoCells(threeDToOneD(cellToProcess[0], cellToProcess[1], cellToProcess[2]),
-                                                   threeDToOneD(origin[0], origin[1], origin[2]),
-                                                   {0, 0, -domainSize[2]});
-                    }
-                    origin[1]++;
-                }
-                origin[1] -= 3;
-                origin[0]++;
-            }
-        }
-        break;
+void LinkedCellsContainer::moveParticleToMigrationBuffer(int cell, size_t position, int newCell) {
+    auto &particles = cells[cell];
+    migrationBuffer.push_back(std::move(particles[position]));
+    migrationTargets.push_back(newCell);
+    if (position + 1 != particles.size()) {
+        particles[position] = std::move(particles.back());
     }
+    particles.pop_back();
 }
 
-void LinkedCellsContainer::applyForceToOppositeEdgeHelper(std::array<int, 3> cellToProcess,
-                                                          std::array<int, 3> offsetCell,
-                                                          std::array<double, 3> offsetPosition, int dim) {
-    auto origin = cellToProcess + offsetCell;
-    origin[dim] -=1;
-    for(int d = 0; d < 3; d++) {
-        if(isCellInDomain(origin)) {
-            applyForcesBetweenTwoCells(threeDToOneD(cellToProcess[0], cellToProcess[1], cellToProcess[2]),
-                                   threeDToOneD(origin[0], origin[1], origin[2]), offsetPosition);
+void LinkedCellsContainer::repackCells() {
+    //Moving the particles invalidates the pointers stored in the Verlet lists.
+    verletListsValid = false;
+    //Mean number of particles per domain cell
+    const auto expected = static_cast<size_t>(std::ceil(static_cast<double>(currentSize) / static_cast<double>(
+                                                            std::max<size_t>(domainCellIterationScheme.size(), 1))));
+    //Halo cells outside the ghost layer only hold particles about to leave the domain, so they only get the capacity
+    //they need right now
+    std::vector<size_t> capacities(cells.size());
+    for (size_t cell = 0; cell < cells.size(); cell++) {
+        capacities[cell] = cells[cell].empty() ? 0 : CellArena::blockCapacity(cells[cell].size());
+    }
+    for (auto &cellGroup: domainCellIterationScheme) {
+        capacities[cellGroup[0]] = std::max(capacities[cellGroup[0]], CellArena::blockCapacity(expected));
+    }
+    for (auto &ghostCell: ghostLayer) {
+        capacities[ghostCell.haloCell] = std::max(capacities[ghostCell.haloCell], CellArena::blockCapacity(expected));
+    }
+    size_t total = 0;
+    for (size_t capacity: capacities) {
+        total += capacity;
+    }
+
+    //Carve the storage of all cells consecutively from one slab, with a quarter of headroom for growing cells
+    auto packedArena = std::make_unique<CellArena>();
+    packedArena->reserve(total + total / 4);
+    std::vector<ParticleCell> packed;
+    packed.reserve(cells.size());
+    for (size_t cell = 0; cell < cells.size(); cell++) {
+        packed.emplace_back(CellAllocator<Particle>{packedArena.get()});
+        packed.back().reserve(capacities[cell]);
+        for (auto &p: cells[cell]) {
+            packed.back().push_back(std::move(p));
         }
-        origin[dim]++;
     }
+    cells.swap(packed);
+    arena.swap(packedArena);
+    preallocatedParticles = currentSize;
+    //packed now holds the old cells, which are released before the old arena held by packedArena
+}
+
+void LinkedCellsContainer::flushMigrationBuffer() {
+    for (size_t i = 0; i < migrationBuffer.size(); i++) {
+        cells[migrationTargets[i]].push_back(std::move(migrationBuffer[i]));
+    }
+    migrationBuffer.clear();
+    migrationTargets.clear();
 }
 
 bool LinkedCellsContainer::isCellInDomain(std::array<int, 3> cell) const {
@@ -396,28 +393,20 @@ bool LinkedCellsContainer::isCellInDomain(std::array<int, 3> cell) const {
 }
 
 bool LinkedCellsContainer::isParticleInDomain(const std::array<double, 3>& position) const {
-    return 0 <= position[0] and position[0] < domainSize[0]
-    and    0 <= position[1] and position[1] < domainSize[1]
-    and    (twoD or (0 <= position[2] and  position[2] < domainSize[2]));
-}
-
-void LinkedCellsContainer::applyForcesBetweenTwoCells(int cellTarget, int cellSource,
-                                                      std::array<double, 3> offsetSource) {
-    for (auto &target: cells[cellTarget]) {
-        for (auto &source: cells[cellSource]) {
-            //Offset particle
-            source.setX(source.getX() + offsetSource);
-            if (ArrayUtils::L2Norm(target.getX() - source.getX()) <= rCutOff) {
-                target.setF(target.getF() + lJF.compute(target, source));
-            }
-            //Reset offset
-            source.setX(source.getX() - offsetSource);
-        }
-    }
+    return origin[0] <= position[0] and position[0] < origin[0] + domainSize[0]
+    and    origin[1] <= position[1] and position[1] < origin[1] + domainSize[1]
+    and    (twoD or (origin[2] <= position[2] and  position[2] < origin[2] + domainSize[2]));
 }
 
-LinkedCellsContainer::LinkedCellsContainer(std::array<double, 3> domainSize, double rCutOff, BoundarySet boundarySet) : currentSize{0},
-                                                                                                                        rCutOff{rCutOff}, domainSize{domainSize}, boundariesSet{boundarySet} {
+LinkedCellsContainer::LinkedCellsContainer(std::array<double, 3> domainSize, double rCutOff, BoundarySet boundarySet,
+                                           ParticleLayout layout, double verletSkin, int threads,
+                                           ParallelStrategy parallelStrategy, CellOrdering cellOrdering,
+                                           std::array<double, 3> origin, std::array<bool, 6> remoteSides) : layout{layout}, currentSize{0},
+                                                                    rCutOff{rCutOff}, verletSkin{verletSkin}, domainSize{domainSize},
+                                                                    origin{origin}, remoteSides{remoteSides},
+                                                                    boundariesSet{boundarySet}, verletListsValid{false},
+                                                                    cellOrdering{cellOrdering}, threads{threads},
+                                                                    parallelStrategy{parallelStrategy} {
     if (domainSize[0] <= 0 || domainSize[1] <= 0 || domainSize[2] < 0) {
         throw std::invalid_argument("Domain Size is invalid");
     }
@@ -426,6 +415,26 @@ LinkedCellsContainer::LinkedCellsContainer(std::array<double, 3> domainSize, dou
         throw std::invalid_argument("rCutOff is less than 0");
     }
 
+    if (layout == ParticleLayout::invalid) {
+        throw std::invalid_argument("Particle layout is invalid");
+    }
+
+    if (verletSkin < 0) {
+        throw std::invalid_argument("Verlet skin is less than 0");
+    }
+
+    if (threads < 1) {
+        throw std::invalid_argument("Number of threads is less than 1");
+    }
+
+    if (parallelStrategy == ParallelStrategy::invalid) {
+        throw std::invalid_argument("Parallel strategy is invalid");
+    }
+
+    if (cellOrdering == CellOrdering::invalid) {
+        throw std::invalid_argument("Cell ordering is invalid");
+    }
+
     //Determine if we are in 2D or 3D
     twoD = __fpclassify(domainSize[2]) == FP_ZERO;
 
@@ -433,10 +442,12 @@ LinkedCellsContainer::LinkedCellsContainer(std::array<double, 3> domainSize, dou
 
     //Calculate number of cells in each dimension. We add here plus two, because each dimension contains two extra halo cells.
     //If the cutOff radius is smaller than the domain size, we set the cell number to 1 because we need at least one cell.
-    nX = static_cast<int>(floor(domainSize[0] / rCutOff)) + 2 + (domainSize[0] < rCutOff ? 1 : 0);
-    nY = static_cast<int>(floor(domainSize[1] / rCutOff)) + 2 + (domainSize[1] < rCutOff ? 1 : 0);
+    //If Verlet lists are used, the cells have to cover the cut-off radius plus the skin radius.
+    double cellLength = rCutOff + verletSkin;
+    nX = static_cast<int>(floor(domainSize[0] / cellLength)) + 2 + (domainSize[0] < cellLength ? 1 : 0);
+    nY = static_cast<int>(floor(domainSize[1] / cellLength)) + 2 + (domainSize[1] < cellLength ? 1 : 0);
     //If we have only 2 dimensions, we define nZ := 1
-    nZ = twoD ? 1 : static_cast<int>(floor(domainSize[2] / rCutOff)) + 2 + (domainSize[2] < rCutOff ? 1 : 0);
+    nZ = twoD ? 1 : static_cast<int>(floor(domainSize[2] / cellLength)) + 2 + (domainSize[2] < cellLength ? 1 : 0);
 
     //Calculate cell sizes
     cellSizeX = domainSize[0] / (nX - 2);
@@ -451,13 +462,23 @@ LinkedCellsContainer::LinkedCellsContainer(std::array<double, 3> domainSize, dou
     int numberCells = nX * nY * nZ;
     cells.reserve(numberCells);
     for (int n = 0; n < numberCells; n++) {
-        cells.emplace_back();
+        cells.emplace_back(CellAllocator<Particle>{arena.get()});
+    }
+    if (layout == ParticleLayout::soa) {
+        soaCells.resize(numberCells);
     }
 
     //Precalculate indizes for fast access in the future
+    calculateCellOrdering();
     calculateHaloCellIndices();
     calculateBoundaryCellIndices();
     calculateDomainCellsIterationScheme();
+    calculateGhostLayer();
+    calculateColourGroups();
+
+    if (threads > 1) {
+        spdlog::info("Using {} threads for the force calculation", threads);
+    }
 }
 
 int LinkedCellsContainer::calcCellIndex(const std::array<double, 3> &position) {
@@ -472,35 +493,37 @@ int LinkedCellsContainer::calcCellIndex(const std::array<double, 3> &position) {
         throw std::length_error("Particle Index error");
     }
 
-    if (position[0] < 0) {
+    //The bounds are compared with the absolute position, so that the same position is never inside of two
+    //neighbouring subdomains
+    if (position[0] < origin[0]) {
         x = 0;
-    } else if (position[0] >= domainSize[0]) {
+    } else if (position[0] >= origin[0] + domainSize[0]) {
         x = nX - 1;
     } else {
-        x = static_cast<int>(floor(position[0] / cellSizeX)) + 1;
+        x = std::min(static_cast<int>(floor((position[0] - origin[0]) / cellSizeX)) + 1, nX - 2);
     }
 
-    if (position[1] < 0) {
+    if (position[1] < origin[1]) {
         y = 0;
-    } else if (position[1] >= domainSize[1]) {
+    } else if (position[1] >= origin[1] + domainSize[1]) {
         y = nY - 1;
     } else {
-        y = static_cast<int>(floor(position[1] / cellSizeY)) + 1;
+        y = std::min(static_cast<int>(floor((position[1] - origin[1]) / cellSizeY)) + 1, nY - 2);
     }
 
     if (twoD) {
-        return x + baseY * y;
+        return threeDToOneD(x, y, 0);
     }
 
-    if (position[2] < 0) {
+    if (position[2] < origin[2]) {
         z = 0;
-    } else if (position[2] >= domainSize[2]) {
-        z = nY - 1;
+    } else if (position[2] >= origin[2] + domainSize[2]) {
+        z = nZ - 1;
     } else {
-        z = static_cast<int>(floor(position[2] / cellSizeZ)) + 1;
+        z = std::min(static_cast<int>(floor((position[2] - origin[2]) / cellSizeZ)) + 1, nZ - 2);
     }
 
-    return x + baseY * y + baseZ * z;
+    return threeDToOneD(x, y, z);
 }
 
 void LinkedCellsContainer::add(Particle &p) {
@@ -510,15 +533,33 @@ void LinkedCellsContainer::add(Particle &p) {
         throw std::invalid_argument("Adding Particle in 3D space to a 2D Linked Cell. This Operation is Impossible");
     }
     int index = calcCellIndex(p.getX());
+    if (isRemoteCell(oneDToThreeD(index))) {
+        return;
+    }
     cells[index].push_back(std::move(p));
     currentSize++;
+    //Adding a particle may reallocate the cell, so the pointers stored in the Verlet lists can be invalid now.
+    verletListsValid = false;
+}
+
+void LinkedCellsContainer::clear() {
+    for (auto &cell: cells) {
+        cell.clear();
+    }
+    ghostOrigins.clear();
+    currentSize = 0;
+    verletListsValid = false;
 }
 
 int LinkedCellsContainer::threeDToOneD(int x, int y, int z) const {
-    return x + baseY * y + baseZ * z;
+    int index = x + baseY * y + baseZ * z;
+    return cellIndices.empty() ? index : cellIndices[index];
 }
 
 std::array<int, 3> LinkedCellsContainer::oneDToThreeD(int index) const {
+    if (!rowMajorIndices.empty()) {
+        index = rowMajorIndices[index];
+    }
     int z = index / baseZ;
     index -= z * baseZ;
     int y = index / baseY;
@@ -527,17 +568,99 @@ std::array<int, 3> LinkedCellsContainer::oneDToThreeD(int index) const {
 }
 
 void LinkedCellsContainer::updateCells() {
+    //Moving particles between cells invalidates the pointers stored in the Verlet lists.
+    verletListsValid = false;
+    if (currentSize > 2 * preallocatedParticles) {
+        repackCells();
+    }
     for (auto &index: domainCellIterationScheme) {
-        for (auto p = cells[index[0]].begin(); p != cells[index[0]].end();) {
-            int newIndex = calcCellIndex(p->getX());
+        auto &cell = cells[index[0]];
+        for (size_t i = 0; i < cell.size();) {
+            int newIndex = calcCellIndex(cell[i].getX());
             if (newIndex != index[0]) {
-                cells[newIndex].push_back(*p);
-                p = cells[index[0]].erase(p);
+                //The last particle of the cell takes its place and has to be processed next
+                moveParticleToMigrationBuffer(index[0], i, newIndex);
             } else {
-                ++p;
+                ++i;
             }
         }
     }
+    migratedParticles = migrationBuffer.size();
+    totalMigratedParticles += migratedParticles;
+    //Migrants are appended after the pass, so no particle is examined twice
+    flushMigrationBuffer();
+}
+
+void LinkedCellsContainer::sortParticles() {
+    //The new arena hands out the storage of all cells in the order of the cells, while the free blocks of the old
+    //arena would be scattered
+    repackCells();
+}
+
+void LinkedCellsContainer::accountMemory(MemoryFootprint &footprint) const {
+    size_t used = 0;
+    for (auto &cell: cells) {
+        used += cell.size() * sizeof(Particle);
+    }
+    footprint.add(MemoryCategory::particles, used);
+    //Everything held by the arena, which is not occupied by a particle, i.e. unused capacity and free blocks
+    footprint.add(MemoryCategory::cellSlack,
+                  arena->getSlabBytes() - used + (cells.capacity() - cells.size()) * sizeof(ParticleCell));
+    for (size_t side = 0; side < 6; side++) {
+        footprint.add(MemoryCategory::haloCells, MemoryFootprint::bytesOf(haloCells[side]));
+        footprint.add(MemoryCategory::boundaries, MemoryFootprint::bytesOf(boundaries[side]));
+    }
+    footprint.add(MemoryCategory::cellIterationScheme, MemoryFootprint::bytesOf(domainCellIterationScheme));
+    footprint.add(MemoryCategory::cellStructures,
+                  cells.size() * sizeof(ParticleCell) + MemoryFootprint::bytesOf(colourGroups)
+                  + MemoryFootprint::bytesOf(ghostLayer) + MemoryFootprint::bytesOf(cellIndices)
+                  + MemoryFootprint::bytesOf(rowMajorIndices));
+    footprint.add(MemoryCategory::verletLists,
+                  MemoryFootprint::bytesOf(verletParticles) + MemoryFootprint::bytesOf(verletReferencePositions)
+                  + MemoryFootprint::bytesOf(verletNeighbourOffsets) + MemoryFootprint::bytesOf(verletNeighbours)
+                  + MemoryFootprint::bytesOf(verletShifts));
+    size_t soaBytes = MemoryFootprint::bytesOf(soaCells);
+    for (auto &soaCell: soaCells) {
+        soaBytes += soaCell.capacityBytes();
+    }
+    footprint.add(MemoryCategory::workBuffers,
+                  soaBytes + MemoryFootprint::bytesOf(migrationBuffer) + MemoryFootprint::bytesOf(migrationTargets)
+                  + MemoryFootprint::bytesOf(ghostOrigins) + MemoryFootprint::bytesOf(ghostPool)
+                  + MemoryFootprint::bytesOf(cellOffsets) + MemoryFootprint::bytesOf(threadForceBuffers));
+}
+
+PairStatistics LinkedCellsContainer::collectPairStatistics() const {
+    PairStatistics statistics;
+    const double rCutOffSquared = rCutOff * rCutOff;
+    for (auto &cellGroup: domainCellIterationScheme) {
+        auto &cell = cells[cellGroup[0]];
+        if (statistics.occupancy.size() <= cell.size()) {
+            statistics.occupancy.resize(cell.size() + 1, 0);
+        }
+        statistics.occupancy[cell.size()]++;
+
+        statistics.candidatePairs += cell.size() * (cell.size() - (cell.empty() ? 0 : 1)) / 2;
+        for (size_t i = 0; i < cell.size(); i++) {
+            for (size_t j = i + 1; j < cell.size(); j++) {
+                statistics.pairsWithinCutOff += ArrayUtils::L2NormSquared(cell[i].getX() - cell[j].getX()) <= rCutOffSquared;
+            }
+        }
+        for (auto neighbour = cellGroup.begin() + 1; neighbour != cellGroup.end(); std::advance(neighbour, 1)) {
+            auto &neighbourCell = cells[*neighbour];
+            statistics.candidatePairs += cell.size() * neighbourCell.size();
+            for (auto &p_i: cell) {
+                for (auto &p_j: neighbourCell) {
+                    statistics.pairsWithinCutOff += ArrayUtils::L2NormSquared(p_i.getX() - p_j.getX()) <= rCutOffSquared;
+                }
+            }
+        }
+    }
+    if (verletListsValid) {
+        statistics.verletPairs = verletNeighbours.size();
+    }
+    statistics.migratedParticles = migratedParticles;
+    statistics.totalMigratedParticles = totalMigratedParticles;
+    return statistics;
 }
 
 size_t LinkedCellsContainer::size() const {
@@ -568,21 +691,25 @@ void LinkedCellsContainer::teleportParticlesToOppositeSide(Side sideStart) {
     switch (sideStart) {
         case Side::front: {
             teleportParticlesToOppositeSideHelper(sideStart, 2, 0);
+            break;
         }
         case Side::right: {
             teleportParticlesToOppositeSideHelper(sideStart, 1, 1);
+            break;
         }
         case Side::back: {
             teleportParticlesToOppositeSideHelper(sideStart, 2, 1);
+            break;
         }
         case Side::left: {
             teleportParticlesToOppositeSideHelper(sideStart, 1, 0);
+            break;
         }
         case Side::top: {
             if(!twoD) {
                 teleportParticlesToOppositeSideHelper(sideStart, 3, 1);
             }
-
+            break;
         }
         case Side::bottom: {
             if(!twoD) {
@@ -592,202 +719,87 @@ void LinkedCellsContainer::teleportParticlesToOppositeSide(Side sideStart) {
     }
 }
 
-void LinkedCellsContainer::applyForcesFromOppositeSide(Side side) {
-    int Z1 = !twoD;
-    int Z2 = twoD ? 1 : nZ - 1;
-    int NZ = twoD ? 2 : nZ;
-    switch (side) {
-        case Side::front: {
-            //Calculate forces from opposite side without edges and corners
-            for (int z = Z1; z < Z2; z++) {
-                for (int x = 1; x < nX - 1; x++) {
-                    applyForceToOppositeCellsHelper(side, {x, 1, z});
-                }
-            }
-
-
-            //Calculate forces of edges (only relevant for 3D)
-            if(!twoD) {
-                if (boundariesSet.bottom == BoundaryCondition::periodic) {
-                    for (int x = 1; x < nX - 1; x++) {
-                        applyForceToOppositeEdgeHelper({x, 1, 1}, {0, nY - 3, nZ - 3},
-                                                       {0, -domainSize[1], -domainSize[2]}, 0);
-                    }
-                }
-
-                if (boundariesSet.right == BoundaryCondition::periodic) {
-                    for (int z = 1; z < nZ - 1; z++) {
-                        applyForceToOppositeEdgeHelper({nX - 2, 1, z}, {-(nX - 3), nY - 3, 0},
-                                                       {domainSize[0], -domainSize[1], 0}, 2);
-                    }
-                }
-
-                if (boundariesSet.top == BoundaryCondition::periodic) {
-                    for (int x = 1; x < nX - 1; x++) {
-                        applyForceToOppositeEdgeHelper({x, 1, nZ - 2}, {0, nY - 3, -(nZ - 3)},
-                                                       {0, -domainSize[1], domainSize[2]}, 0);
-                    }
-                }
-
-                if (boundariesSet.left == BoundaryCondition::periodic) {
-                    for (int z = 1; z < nZ - 1; z++) {
-                        applyForceToOppositeEdgeHelper({1, 1, z}, {nX - 3, nY - 3, 0},
-                                                       {-domainSize[0], -domainSize[1], 0}, 2);
-                    }
-                }
-            }
-            //Calculate forces of corners
-            if(boundariesSet.left == BoundaryCondition::periodic and boundariesSet.bottom == BoundaryCondition::periodic) {
-                applyForcesBetweenTwoCells(threeDToOneD(1,1,Z1), threeDToOneD(nX - 2, nY - 2, NZ - 2), {-domainSize[0], -domainSize[1], -domainSize[2]});
-            }
-
-            if(boundariesSet.right == BoundaryCondition::periodic and boundariesSet.bottom == BoundaryCondition::periodic) {
-                applyForcesBetweenTwoCells(threeDToOneD(nX - 1,1,Z1), threeDToOneD(1, nY - 2, NZ - 2), {domainSize[0], -domainSize[1], -domainSize[2]});
-            }
-            if(!twoD) {
-                if(boundariesSet.left == BoundaryCondition::periodic and boundariesSet.top == BoundaryCondition::periodic) {
-                    applyForcesBetweenTwoCells(threeDToOneD(1,1,nZ - 2), threeDToOneD(nX - 2, nY - 2, 1), {-domainSize[0], -domainSize[1], domainSize[2]});
-                }
-                if(boundariesSet.right == BoundaryCondition::periodic and boundariesSet.top == BoundaryCondition::periodic) {
-                    applyForcesBetweenTwoCells(threeDToOneD(nX - 1,1,nZ - 2), threeDToOneD(1, nY - 2, 1), {domainSize[0], -domainSize[1], domainSize[2]});
-                }
-            }
-        }
-        break;
-        case Side::right: {
-            //Calculate forces from opposite side without edges and corners
-            for (int z = Z1; z < Z2; z++) {
-                for (int y = 1; y < nY - 1; y++) {
-                    applyForceToOppositeCellsHelper(side, {nX - 2, y, z});
-                }
-            }
-
-            //Calculate forces of edges
-            if(!twoD) {
-                if(boundariesSet.top == BoundaryCondition::periodic) {
-                    for (int y = 1; y < nY - 1; y++) {
-                        applyForceToOppositeEdgeHelper({nX - 2, y, nZ - 2}, {-(nX - 3), 0, -(nZ - 3)},
-                                                       {domainSize[0], 0, domainSize[2]}, 1);
-                    }
-                }
-                if(boundariesSet.bottom == BoundaryCondition::periodic) {
-                    for (int y = 1; y < nY - 1; y++) {
-                        applyForceToOppositeEdgeHelper({nX - 2, y, 1}, {-(nX - 3), 0, nZ - 3},
-                                                       {domainSize[0], 0, -domainSize[2]}, 1);
-                    }
-                }
-                if(boundariesSet.back == BoundaryCondition::periodic) {
-                    for (int z = 1; z < nZ - 1; z++) {
-                        applyForceToOppositeEdgeHelper({nX - 2, nY - 2, 1}, {-(nX - 3), -(nY - 3), 0},
-                                                       {domainSize[0], domainSize[1], 0}, 2);
-                    }
-                }
-            }
-
-            //Calculate forces of corner
-            if(boundariesSet.bottom == BoundaryCondition::periodic and boundariesSet.back == BoundaryCondition::periodic) {
-                applyForcesBetweenTwoCells(threeDToOneD(nX - 2,nY - 2,Z1), threeDToOneD(1, 1, NZ - 2), {domainSize[0], domainSize[1], -domainSize[2]});
-            }
-            if(!twoD and boundariesSet.top == BoundaryCondition::periodic and boundariesSet.back == BoundaryCondition::periodic) {
-                applyForcesBetweenTwoCells(threeDToOneD(nX - 2,nY - 2,nZ - 2), threeDToOneD(1, 1, 1), {domainSize[0], domainSize[1], domainSize[2]});
+void LinkedCellsContainer::createGhostParticles() {
+    ghostOrigins.clear();
+    for (auto &ghostCell: ghostLayer) {
+        auto &halo = cells[ghostCell.haloCell];
+        ghostCell.start = halo.size();
+        if (ghostCell.remote) {
+            continue;
+        }
+        for (auto &original: cells[ghostCell.sourceCell]) {
+            //Reuse a particle of the pool, so no particle has to be constructed
+            if (ghostPool.empty()) {
+                halo.push_back(original);
+            } else {
+                halo.push_back(std::move(ghostPool.back()));
+                ghostPool.pop_back();
+                halo.back() = original;
             }
+            Particle &ghost = halo.back();
+            ghost.setX(original.getX() + ghostCell.shift);
+            ghost.setF({0, 0, 0});
+            ghostOrigins.push_back(&original);
         }
-        break;
-        case Side::back: {
-            for (int z = Z1; z < Z2; z++) {
-                for (int x = 1; x < nY - 1; x++) {
-                    applyForceToOppositeCellsHelper(side, {x, nY - 2, z});
-                }
-            }
-
-            //Calculate forces of edges
-
-            if(!twoD) {
-                if(boundariesSet.top == BoundaryCondition::periodic) {
-                    for (int x = 1; x < nX - 1; x++) {
-                        applyForceToOppositeEdgeHelper({x, nY - 2, nZ - 2}, {0, -(nY - 3), -(nZ - 3)},
-                                                       {0, domainSize[1], domainSize[2]}, 0);
-                    }
-                }
-                if(boundariesSet.bottom == BoundaryCondition::periodic) {
-                    for (int x = 1; x < nX - 1; x++) {
-                        applyForceToOppositeEdgeHelper({x, nY - 2, 1}, {0, -(nY - 3), nZ - 3},
-                                                       {0, domainSize[1], -domainSize[2]}, 0);
-                    }
-                }
-                if(boundariesSet.left == BoundaryCondition::periodic) {
-                    for (int z = 1; z < nZ - 1; z++) {
-                        applyForceToOppositeEdgeHelper({1, nY - 2, z}, {nX - 3, -(nY - 3), 0},
-                                                       {-domainSize[0], domainSize[1], 0}, 2);
-                    }
-                }
-            }
+    }
+}
 
-            //Calculate forces of corner
-            if(boundariesSet.bottom == BoundaryCondition::periodic && boundariesSet.left == BoundaryCondition::periodic) {
-                applyForcesBetweenTwoCells(threeDToOneD(1,nY - 2, Z1), threeDToOneD(nX - 2, 1, NZ - 2), {-domainSize[0], domainSize[1], -domainSize[2]});
-            }
-            if(!twoD and boundariesSet.top == BoundaryCondition::periodic && boundariesSet.left == BoundaryCondition::periodic) {
-                applyForcesBetweenTwoCells(threeDToOneD(1,nY - 2, nZ - 2), threeDToOneD(nX - 2, 1, 1), {-domainSize[0], domainSize[1], domainSize[2]});
+void LinkedCellsContainer::removeGhostParticles() {
+    size_t index = 0;
+    for (auto &ghostCell: ghostLayer) {
+        auto &halo = cells[ghostCell.haloCell];
+        for (size_t i = ghostCell.start; i < halo.size(); i++) {
+            //The forces of images of other subdomains are returned by the caller
+            if (!ghostCell.remote) {
+                Particle *original = ghostOrigins[index++];
+                original->setF(original->getF() + halo[i].getF());
             }
+            ghostPool.push_back(std::move(halo[i]));
         }
-        break;
-        case Side::left: {
-            for (int z = Z1; z < Z2; z++) {
-                for (int y = 1; y < nY - 1; y++) {
-                    applyForceToOppositeCellsHelper(side, {1, y, z});
-                }
-            }
-
-            //Calculate forces of edges
-
-            if(!twoD) {
-                if(boundariesSet.top == BoundaryCondition::periodic) {
-                    for (int y = 1; y < nY - 1; y++) {
-                        applyForceToOppositeEdgeHelper({1, y, nZ - 2}, {nX - 3, 0, -(nZ - 3)},
-                                                       {-domainSize[0], 0, domainSize[2]}, 1);
-                    }
-                }
-                if(boundariesSet.bottom == BoundaryCondition::periodic) {
-                    for (int y = 1; y < nY - 1; y++) {
-                        applyForceToOppositeEdgeHelper({1, y, 1}, {nX - 3, 0, nZ - 3},
-                                                       {-domainSize[0], 0, -domainSize[2]}, 1);
-                    }
-                }
-            }
+        halo.resize(ghostCell.start);
+    }
+    ghostOrigins.clear();
+}
 
-            //All corners are already covered
+std::vector<int> LinkedCellsContainer::getRemoteGhostCells() const {
+    std::vector<int> remoteGhostCells;
+    for (auto &ghostCell: ghostLayer) {
+        if (ghostCell.remote) {
+            remoteGhostCells.push_back(ghostCell.haloCell);
         }
-        break;
-        case Side::top: {
-            //Calculate forces from opposite side without edges and corners
-            for (int x = 1; x < nX - 1; x++) {
-                for (int y = 1; y < nY - 1; y++) {
-                    applyForceToOppositeCellsHelper(side, {x, y, nZ - 2});
-                }
-            }
+    }
+    return remoteGhostCells;
+}
 
-            //All edges are already covered
+Particle &LinkedCellsContainer::appendGhostParticle(int haloCell) {
+    auto &halo = cells[haloCell];
+    if (ghostPool.empty()) {
+        halo.emplace_back();
+    } else {
+        halo.push_back(std::move(ghostPool.back()));
+        ghostPool.pop_back();
+    }
+    Particle &ghost = halo.back();
+    ghost.setF({0, 0, 0});
+    return ghost;
+}
 
-            //All corners are already covered
-        }
-        break;
-        case Side::bottom: {
-            //Calculate forces from opposite side without edges and corners
-            for (int x = 1; x < nX - 1; x++) {
-                for (int y = 1; y < nY - 1; y++) {
-                    applyForceToOppositeCellsHelper(side, {x, y, 1});
-                }
+void LinkedCellsContainer::extractHaloParticles(std::vector<Particle> &leaving) {
+    verletListsValid = false;
+    //Cells at edges and corners belong to several sides, but are empty after their first visit
+    for (auto &side: haloCells) {
+        for (int cell: side) {
+            currentSize -= cells[cell].size();
+            for (auto &p: cells[cell]) {
+                leaving.push_back(std::move(p));
             }
-
-            //All edges are already covered
-
-            //All corners are already covered
+            cells[cell].clear();
         }
     }
 }
 
 void LinkedCellsContainer::clearHaloCells(Side side) {
+    verletListsValid = false;
     for (auto cell: haloCells[static_cast<int>(side)]) {
         currentSize -= cells[cell].size();
         cells[cell].clear();
@@ -795,37 +807,75 @@ void LinkedCellsContainer::clearHaloCells(Side side) {
 }
 
 void LinkedCellsContainer::applyToEachParticle(const std::function<void(Particle &)> &function) {
-    for (auto &cell: cells) {
-        std::for_each(cell.begin(), cell.end(), function);
-    }
+    forEachParticle(function);
 }
 
 void LinkedCellsContainer::applyToEachParticleInDomain(const std::function<void(Particle &)> &function) {
-    for (auto &cellGroup: domainCellIterationScheme) {
-        for (auto &p: cells[cellGroup[0]]) {
-            function(p);
-        }
-    }
+    forEachParticleInDomain(function);
 }
 
 void LinkedCellsContainer::applyToAllUniquePairsInDomain(const std::function<void(Particle &, Particle &)> &function) {
-    for (auto &cellGroup: domainCellIterationScheme) {
-        //First, consider all pairs within the cell that distance is smaller or equal then the cutoff radius
+    forEachUniquePairInDomain(function);
+}
 
-        for (auto p_i = cells[cellGroup[0]].begin(); p_i != cells[cellGroup[0]].end(); std::advance(p_i, 1)) {
-            for (auto p_j = std::next(p_i); p_j != cells[cellGroup[0]].end(); std::advance(p_j, 1)) {
-                if (ArrayUtils::L2Norm(p_i->getX() - p_j->getX()) <= rCutOff) {
-                    function(*p_i, *p_j);
-                }
-            }
-        }
-        //Then, consider all relevant neighbour cells
+void LinkedCellsContainer::applyToAllUniquePairsInDomainOptimized(
+    const std::function<void(Particle &, Particle &, std::array<double, 3>, double)> &function) {
+    forEachUniquePairInDomainOptimized(function);
+}
 
-        for (auto neighbour = cellGroup.begin() + 1; neighbour != cellGroup.end(); std::advance(neighbour, 1)) {
-            for (auto &p_i: cells[cellGroup[0]]) {
-                for (auto &p_j: cells[*neighbour]) {
-                    if (ArrayUtils::L2Norm(p_i.getX() - p_j.getX()) <= rCutOff) {
-                        function(p_i, p_j);
+void LinkedCellsContainer::loadSoA() {
+    const int numberCellGroups = static_cast<int>(domainCellIterationScheme.size());
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (int i = 0; i < numberCellGroups; i++) {
+        int cell = domainCellIterationScheme[i][0];
+        soaCells[cell].load(cells[cell]);
+    }
+    //The ghost layer takes part in the force calculation as well
+    const int numberGhostCells = static_cast<int>(ghostLayer.size());
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (int i = 0; i < numberGhostCells; i++) {
+        int cell = ghostLayer[i].haloCell;
+        soaCells[cell].load(cells[cell]);
+    }
+}
+
+void LinkedCellsContainer::extractSoA() {
+    const int numberCellGroups = static_cast<int>(domainCellIterationScheme.size());
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (int i = 0; i < numberCellGroups; i++) {
+        int cell = domainCellIterationScheme[i][0];
+        soaCells[cell].extractForces(cells[cell]);
+    }
+    //The ghost layer takes part in the force calculation as well
+    const int numberGhostCells = static_cast<int>(ghostLayer.size());
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (int i = 0; i < numberGhostCells; i++) {
+        int cell = ghostLayer[i].haloCell;
+        soaCells[cell].extractForces(cells[cell]);
+    }
+}
+
+void LinkedCellsContainer::applyToAllUniqueCellPairsInDomainSoA(const std::function<void(ParticleSoA &)> &withinCell,
+                                                                const std::function<void(ParticleSoA &, ParticleSoA &)> &betweenCells) {
+    //Cell groups of the same colour do not share any cell, so they can be processed concurrently
+    for (auto &colour: colourGroups) {
+        const int numberColourGroups = static_cast<int>(colour.size());
+        #pragma omp parallel num_threads(threads)
+        {
+            TRACE_SPAN("pair forces (SoA colour)");
+            #pragma omp for schedule(dynamic)
+            for (int i = 0; i < numberColourGroups; i++) {
+                auto &cellGroup = domainCellIterationScheme[colour[i]];
+                ParticleSoA &cell = soaCells[cellGroup[0]];
+                if (cell.size() == 0) {
+                    continue;
+                }
+                //First, consider all pairs within the cell
+                withinCell(cell);
+                //Then, consider all relevant neighbour cells
+                for (auto neighbour = cellGroup.begin() + 1; neighbour != cellGroup.end(); std::advance(neighbour, 1)) {
+                    if (soaCells[*neighbour].size() != 0) {
+                        betweenCells(cell, soaCells[*neighbour]);
                     }
                 }
             }
@@ -833,34 +883,88 @@ void LinkedCellsContainer::applyToAllUniquePairsInDomain(const std::function<voi
     }
 }
 
-void LinkedCellsContainer::applyToAllUniquePairsInDomainOptimized(
-    const std::function<void(Particle &, Particle &, std::array<double, 3>, double)> &function) {
+void LinkedCellsContainer::buildVerletLists() {
+    verletParticles.clear();
+    verletReferencePositions.clear();
+    verletNeighbourOffsets.clear();
+    verletNeighbours.clear();
+
+    //Number the particles inside the domain cell by cell, so the neighbours can be stored by their index
+    std::vector<uint32_t> cellStarts(cells.size(), 0);
     for (auto &cellGroup: domainCellIterationScheme) {
-        //First, consider all pairs within the cell that distance is smaller or equal then the cutoff radius
-
-        for (auto p_i = cells[cellGroup[0]].begin(); p_i != cells[cellGroup[0]].end(); std::advance(p_i, 1)) {
-            for (auto p_j = std::next(p_i); p_j != cells[cellGroup[0]].end(); std::advance(p_j, 1)) {
-                auto difference = p_j->getX() - p_i->getX();
-                auto distance = ArrayUtils::L2Norm(difference);
-                if (distance <= rCutOff) {
-                    function(*p_i, *p_j, difference, distance);
-                }
-            }
+        cellStarts[cellGroup[0]] = static_cast<uint32_t>(verletParticles.size());
+        for (auto &p: cells[cellGroup[0]]) {
+            verletParticles.push_back(&p);
+            verletReferencePositions.push_back(p.getX());
         }
-        //Then, consider all relevant neighbour cells
+    }
+    //The images of a ghost cell are stored as the particles of its source cell plus the offset of the ghost cell
+    std::vector<int> ghostCellOf(cells.size(), -1);
+    verletShifts.assign(1, {0, 0, 0});
+    for (size_t g = 0; g < ghostLayer.size(); g++) {
+        ghostCellOf[ghostLayer[g].haloCell] = static_cast<int>(g);
+        verletShifts.push_back(ghostLayer[g].shift);
+    }
 
-        for (auto neighbour = cellGroup.begin() + 1; neighbour != cellGroup.end(); std::advance(neighbour, 1)) {
-            for (auto &p_i: cells[cellGroup[0]]) {
-                for (auto &p_j: cells[*neighbour]) {
-                    auto difference = p_j.getX() - p_i.getX();
-                    auto distance = ArrayUtils::L2Norm(difference);
-                    if (distance <= rCutOff) {
-                        function(p_i, p_j, difference, distance);
+    const double verletRadiusSquared = (rCutOff + verletSkin) * (rCutOff + verletSkin);
+    for (auto &cellGroup: domainCellIterationScheme) {
+        auto &cell = cells[cellGroup[0]];
+        for (size_t k = 0; k < cell.size(); k++) {
+            verletNeighbourOffsets.push_back(verletNeighbours.size());
+            auto &x_i = cell[k].getX();
+            //First, consider all following particles within the same cell
+            for (size_t l = k + 1; l < cell.size(); l++) {
+                if (ArrayUtils::L2NormSquared(x_i - cell[l].getX()) <= verletRadiusSquared) {
+                    verletNeighbours.push_back({static_cast<uint32_t>(cellStarts[cellGroup[0]] + l), 0});
+                }
+            }
+            //Then, consider all relevant neighbour cells
+            for (auto neighbour = cellGroup.begin() + 1; neighbour != cellGroup.end(); std::advance(neighbour, 1)) {
+                auto &neighbourCell = cells[*neighbour];
+                const int g = ghostCellOf[*neighbour];
+                if (g < 0) {
+                    for (size_t l = 0; l < neighbourCell.size(); l++) {
+                        if (ArrayUtils::L2NormSquared(x_i - neighbourCell[l].getX()) <= verletRadiusSquared) {
+                            verletNeighbours.push_back({static_cast<uint32_t>(cellStarts[*neighbour] + l), 0});
+                        }
+                    }
+                    continue;
+                }
+                //The images are appended behind the particles of the halo cell in the order of their source cell. Images
+                //of other subdomains have no original particle in this container.
+                const GhostCell &ghostCell = ghostLayer[g];
+                if (ghostCell.remote) {
+                    continue;
+                }
+                const uint32_t sourceStart = cellStarts[ghostCell.sourceCell];
+                for (size_t l = ghostCell.start; l < neighbourCell.size(); l++) {
+                    if (ArrayUtils::L2NormSquared(x_i - neighbourCell[l].getX()) <= verletRadiusSquared) {
+                        verletNeighbours.push_back({static_cast<uint32_t>(sourceStart + l - ghostCell.start),
+                                                    static_cast<uint32_t>(g + 1)});
                     }
                 }
             }
         }
     }
+    verletNeighbourOffsets.push_back(verletNeighbours.size());
+    verletListsValid = true;
+}
+
+bool LinkedCellsContainer::areVerletListsOutdated() {
+    if (!verletListsValid) {
+        return true;
+    }
+    const double maxDisplacementSquared = verletSkin * verletSkin / 4;
+    for (size_t i = 0; i < verletParticles.size(); i++) {
+        auto &position = verletParticles[i]->getX();
+        if (!isParticleInDomain(position)) {
+            return true;
+        }
+        if (ArrayUtils::L2NormSquared(position - verletReferencePositions[i]) > maxDisplacementSquared) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void LinkedCellsContainer::applyToAllBoundaryParticles(
@@ -3,13 +3,20 @@
 //
 
 #pragma once
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <omp.h>
 #include <vector>
 
 #include "../ParticleContainer.h"
+#include "CellArena.h"
 #include "fileHandling/outputWriter/VTKWriter/VTKWriter.h"
 #include "particleRepresentation/particle/Particle.h"
+#include "particleRepresentation/particle/ParticleSoA.h"
+#include "profiling/PairStatistics.h"
+#include "profiling/Tracer.h"
 #include "utils/enumsStructs.h"
-#include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
 
 using namespace enumsStructs;
 
@@ -21,11 +28,90 @@ class LinkedCellsContainer : public ParticleContainer{
 private:
 
     //Data structure
+    /**
+     * Slab pool holding the particles of all cells. It is declared before the cells, so that it outlives them.
+     */
+    std::unique_ptr<CellArena> arena = std::make_unique<CellArena>();
+
     /**
      * We use an 1D vector to store the flattened 3D cell structure
-     * being an essential property of the linked cells algorithm. Each cell is represented itself by an 1D vector of particles.
+     * being an essential property of the linked cells algorithm. Each cell is represented itself by an 1D vector of particles,
+     * whose storage is taken from the arena above.
+     */
+    std::vector<ParticleCell> cells;
+
+    /**
+     * Number of particles the capacities of the cells have last been preallocated for (see repackCells()).
+     */
+    size_t preallocatedParticles = 0;
+
+    /**
+     * Memory layout the particles are processed in during the force calculation. The particles are always stored in
+     * the cells above. If the structure of arrays layout is selected, the positions, masses and parameter types of the
+     * particles of each domain cell are mirrored into the corresponding buffer of soaCells before the pair forces are
+     * calculated, and only the forces are written back afterwards.
+     */
+    ParticleLayout layout;
+
+    /**
+     * Structure of arrays buffers, one for each cell. Only used if the structure of arrays layout is selected.
+     */
+    std::vector<ParticleSoA> soaCells;
+
+    /**
+     * Particles leaving their cell during a rebinning pass, collected here and appended to their new cells in bulk
+     * once the pass is finished. The buffers keep their capacity, so no reallocation happens in steady state.
+     */
+    std::vector<Particle> migrationBuffer;
+
+    /**
+     * Index of the new cell of each particle in migrationBuffer.
+     */
+    std::vector<int> migrationTargets;
+
+    /**
+     * Number of particles moved to another cell by the last call of updateCells().
+     */
+    uint64_t migratedParticles = 0;
+
+    /**
+     * Number of particles moved to another cell by all calls of updateCells().
+     */
+    uint64_t totalMigratedParticles = 0;
+
+    /**
+     * @brief Halo cell that is filled with periodic images of the particles of a boundary cell on the opposite side.
+     */
+    struct GhostCell {
+        //Index of the halo cell
+        int haloCell;
+        //Index of the domain cell the images are taken from
+        int sourceCell;
+        //Offset added to the positions of the images
+        std::array<double, 3> shift;
+        //Number of particles in the halo cell before the images were appended
+        size_t start;
+        //Specifies, if the images are copies of particles of another subdomain (see appendGhostParticle())
+        bool remote;
+    };
+
+    /**
+     * All halo cells that are part of the domain cell iteration scheme. This is only the case for halo cells across
+     * periodic boundaries and sides shared with another subdomain. Before the force calculation, they are filled with
+     * images of the particles on the opposite side or of the other subdomain, so that the regular traversal of the cell
+     * pairs also handles all interactions across these sides.
+     */
+    std::vector<GhostCell> ghostLayer;
+
+    /**
+     * Original particle of each image in the ghost layer, in the order the images were created.
      */
-    std::vector<std::vector<Particle>> cells;
+    std::vector<Particle *> ghostOrigins;
+
+    /**
+     * Particles that are reused for the images, so the ghost layer can be rebuilt without constructing new particles.
+     */
+    std::vector<Particle> ghostPool;
 
     /**
      * The current number of particles that is contained in this container is tracked by the attribute currentSize and kept up-to-date
@@ -50,6 +136,11 @@ private:
      * The indices of the order in which all cells within the domain are processed to process each pair of particles only ones
      */
     std::vector<std::vector<int>> domainCellIterationScheme;
+    /**
+     * Indices into domainCellIterationScheme grouped by colour. Cell groups of the same colour do not share any cell,
+     * so they can be processed in parallel without data races.
+     */
+    std::vector<std::vector<int>> colourGroups;
 
 
     //All parameters used in this model:
@@ -90,22 +181,116 @@ private:
      * Cut-off radius.
      */
     double rCutOff;
+    /**
+     * Skin radius of the Verlet lists. A value of 0 disables the Verlet lists.
+     */
+    double verletSkin;
     /**
      * Specifies, if the simulation only uses 2 of 3 dimensions. If this is the case, resources can be saved.
      */
     bool twoD;
 
     /**
-     * Size of the domain {x, y , z}. The front lower left corner of the domain is set to (0,0,0) by definition.
+     * Size of the domain {x, y , z}.
      */
     std::array<double, 3> domainSize;
 
-    outputWriter::VTKWriter vtk_writer;
+    /**
+     * Front lower left corner of the domain. It is (0,0,0), unless the container only holds a subdomain of the
+     * simulation domain.
+     */
+    std::array<double, 3> origin;
+
+    /**
+     * Specifies for each side, if it is shared with another subdomain instead of being a boundary of the simulation
+     * domain. Indexed like haloCells.
+     */
+    std::array<bool, 6> remoteSides;
 
-    LeonardJonesForce lJF;
+    outputWriter::VTKWriter vtk_writer;
 
     BoundarySet boundariesSet;
 
+    //Verlet lists:
+    //The neighbour lists are stored in a compressed format. For the i-th particle in verletParticles, its neighbours
+    //are verletNeighbours[verletNeighbourOffsets[i]] to verletNeighbours[verletNeighbourOffsets[i + 1] - 1].
+    //Each pair of particles is only stored once, so Newton's third law of motion can be used.
+    //The pointers stay valid as long as no particle is moved between cells, so the cells must not be updated between two rebuilds.
+    //The images in the ghost layer only exist during a force calculation, so a neighbour across a periodic boundary is
+    //stored as its original particle and the offset of its image.
+
+    /**
+     * @brief Entry of the Verlet lists.
+     */
+    struct VerletNeighbour {
+        //Index of the neighbour in verletParticles
+        uint32_t index;
+        //Index of the offset added to the position of the neighbour in verletShifts, 0 if it is not an image
+        uint32_t shift;
+    };
+
+    /**
+     * All particles inside the domain at the time the Verlet lists were built.
+     */
+    std::vector<Particle *> verletParticles;
+    /**
+     * Positions of the particles in verletParticles at the time the Verlet lists were built.
+     */
+    std::vector<std::array<double, 3>> verletReferencePositions;
+    /**
+     * Start of the neighbours of each particle in verletNeighbours (one more entry than verletParticles).
+     */
+    std::vector<size_t> verletNeighbourOffsets;
+    /**
+     * Neighbours of all particles in verletParticles.
+     */
+    std::vector<VerletNeighbour> verletNeighbours;
+    /**
+     * Offsets of the images of the neighbours. The first entry is zero, the others are the offsets of the ghost cells.
+     */
+    std::vector<std::array<double, 3>> verletShifts;
+    /**
+     * Specifies, if the Verlet lists match the current cells.
+     */
+    bool verletListsValid;
+
+    //Cell ordering:
+
+    /**
+     * Order in which the cells are numbered and stored.
+     */
+    CellOrdering cellOrdering;
+
+    /**
+     * Index of each cell along the cell ordering, looked up by its row-major index (x + nX * y + nX * nY * z).
+     * Empty for the row-major ordering.
+     */
+    std::vector<int> cellIndices;
+
+    /**
+     * Row-major index of each cell, looked up by its index along the cell ordering. Empty for the row-major ordering.
+     */
+    std::vector<int> rowMajorIndices;
+
+    //Parallelisation:
+
+    /**
+     * Number of threads used for the force calculation.
+     */
+    int threads;
+    /**
+     * Strategy to avoid data races between threads when using Newton's third law of motion.
+     */
+    ParallelStrategy parallelStrategy;
+    /**
+     * Index of the first particle of each cell when numbering all particles cell by cell. Used to index the force buffers.
+     */
+    std::vector<size_t> cellOffsets;
+    /**
+     * One force buffer per thread, holding the force contributions for each particle calculated by that thread.
+     */
+    std::vector<std::vector<std::array<double, 3>>> threadForceBuffers;
+
 
     //Helper methods for index calculation
 
@@ -119,11 +304,71 @@ private:
      */
     void calculateBoundaryCellIndices();
 
+    /**
+     * @brief Pre-calculation of the numbering of the cells along the space-filling curve of the cell ordering.
+     */
+    void calculateCellOrdering();
+
     /**
      * @brief Pre-calculation of the indices defining the processing order of cells.
+     *
+     * Each domain cell is paired with the 4 (2D) or 13 (3D) neighbours of a half shell, so that each pair of cells is
+     * processed exactly once. Neighbours across periodic boundaries are halo cells, which are part of the ghost layer.
      */
     void calculateDomainCellsIterationScheme();
 
+    /**
+     * @brief Pre-calculation of the ghost layer from the halo cells used in the domain cell iteration scheme.
+     */
+    void calculateGhostLayer();
+
+    /**
+     * @brief Checks, if the specified cell is a halo cell that only lies outside the domain across periodic boundaries
+     *        or sides shared with another subdomain.
+     *
+     * @param cell Cell to check.
+     * @return True, if the cell can hold images of particles.
+     */
+    [[nodiscard]] bool isPeriodicHaloCell(std::array<int, 3> cell) const;
+
+    /**
+     * @brief Checks, if the specified cell lies outside the domain across a side shared with another subdomain.
+     *
+     * @param cell Cell to check.
+     * @return True, if the cell belongs to another subdomain.
+     */
+    [[nodiscard]] bool isRemoteCell(std::array<int, 3> cell) const;
+
+    /**
+     * @brief Pre-calculation of the colour groups of the domain cell iteration scheme.
+     *
+     * Each cell group touches the cell itself and its neighbours at most one cell away in x and y
+     * and in z only the layer below. Cell groups with the same coordinates modulo (3, 3, 2) therefore never share
+     * a cell, which results in 18 colours in 3D (9 in 2D).
+     */
+    void calculateColourGroups();
+
+    /**
+     * @brief Apply a lambda function to all unique pairs of particles of one cell group of the domain cell iteration scheme
+     *        which distance is smaller or equal than the cut-off radius.
+     *
+     * @param cellGroup Cell group to process.
+     * @param function Lambda function that is applied to each pair of particles.
+     */
+    template<typename F>
+    void processCellGroup(const std::vector<int> &cellGroup, F &&function);
+
+    /**
+     * @brief Calculate the forces between a particle and all its neighbours in the Verlet lists which distance is
+     *        smaller or equal than the cut-off radius.
+     *
+     * @param i Index of the particle in verletParticles.
+     * @param forceFunction Lambda function calculating the force that the second particle exerts on the first one.
+     * @param addForces Lambda function adding the force to the particles with the indices i and j.
+     */
+    template<typename F, typename A>
+    void processVerletNeighbours(size_t i, F &&forceFunction, A &&addForces);
+
     /**
      * @brief Calculate the distance that a particle has to a specific side of the domain.
      *        In 2D the distance to sides top and bottom is always 0.
@@ -157,24 +402,30 @@ private:
     void teleportParticlesToOppositeSideHelper(Side sideStart, int dimension, int modus);
 
     /**
-     * @brief Used for periodic boundaries to calculate the force that all particles from
-     *        the opposite edge exert on the particles on the specified cell on the specified side.
+     * @brief Move a particle from its cell into the migration buffer. The last particle of the cell takes its place,
+     *        so no other particles have to be shifted.
      *
-     * @param side Side on which the force is exerted.
-     * @param cellToProcess Specific cell of that side.
+     * @param cell Index of the cell the particle is currently stored in.
+     * @param position Position of the particle in its cell.
+     * @param newCell Index of the cell the particle is moved to, once the migration buffer is flushed.
      */
-    void applyForceToOppositeCellsHelper(Side side, std::array<int,3> cellToProcess);
+    void moveParticleToMigrationBuffer(int cell, size_t position, int newCell);
 
     /**
-     * @brief Used for periodic boundaries to calculate the force that all particles
-     *        from the opposite edge exert on the particles of the specified cell
+     * @brief Move the particles of all cells into a new arena, in the order of the cell indices, and release the old
+     *        arena.
      *
-     * @param cellToProcess Cell on which particles the force is exerted.
-     * @param offsetCell Offset to reach the cell of the opposite edge.
-     * @param offsetPosition Offset to move the particles of the opposite edge to the current edge for proper force calculation.
-     * @param dim Dimension in which the edge is living.
+     * The capacity of each domain cell and each cell of the ghost layer is preallocated for the current density, i.e.
+     * for the mean number of particles per domain cell. A larger margin would spread the particles over more memory
+     * and slow down the traversal of sparse cells. All capacities are carved from a single slab, which has some
+     * headroom for the cells growing beyond the mean.
      */
-    void applyForceToOppositeEdgeHelper(std::array<int, 3> cellToProcess, std::array<int, 3> offsetCell, std::array<double,3> offsetPosition , int dim);
+    void repackCells();
+
+    /**
+     * @brief Append all particles in the migration buffer to their new cells and empty the buffer.
+     */
+    void flushMigrationBuffer();
 
     /**
      * @brief Checks, if the specified cell is part of the domain.
@@ -192,15 +443,6 @@ private:
      */
     [[nodiscard]] bool isParticleInDomain(const std::array<double, 3>& position) const;
 
-    /**
-     * @brief Calculates the forces that particles in the cell source apply to the particles in cell target.
-     *
-     * @param cellTarget Index of the cell containing the particles to which the force is applied.
-     * @param cellSource Index of the cell containing the particles which exert the force.
-     * @param offsetSource Offset to move the particles of the cell source in the right position for force calculations.
-     */
-    void applyForcesBetweenTwoCells(int cellTarget, int cellSource, std::array<double, 3> offsetSource);
-
 
 public:
     /**
@@ -212,9 +454,38 @@ public:
      *
      * @param domainSize Size of the simulation domain. Syntax {x, y, z}. Front lower left corner is by definition (0,0,0).
      * @param rCutOff The cut-off radius
+     * @param boundarySet Boundary conditions for each side.
+     * @param layout Memory layout the particles are processed in during the force calculation.
+     * @param verletSkin Skin radius of the Verlet lists. If it is greater than 0, the cells are sized by rCutOff + verletSkin,
+     *                   so that the Verlet lists can be built from adjacent cells only. A value of 0 disables the Verlet lists.
+     * @param threads Number of threads used for the force calculation.
+     * @param parallelStrategy Strategy to avoid data races between threads when using Newton's third law of motion.
+     * @param cellOrdering Order in which the cells are numbered, stored and processed. Morton and Hilbert ordering keep
+     *                     neighbouring cells close in memory.
+     * @param origin Front lower left corner of the domain. Only differs from (0,0,0), if the container holds a subdomain.
+     * @param remoteSides Sides shared with another subdomain (see DomainDecomposition), indexed by Side. Their boundary
+     *                    conditions are ignored. Instead, their halo cells are part of the ghost layer, which has to be
+     *                    filled with appendGhostParticle().
+     */
+
+    LinkedCellsContainer(std::array<double, 3> domainSize, double rCutOff, BoundarySet boundarySet,
+                         ParticleLayout layout = ParticleLayout::aos, double verletSkin = 0, int threads = 1,
+                         ParallelStrategy parallelStrategy = ParallelStrategy::coloring,
+                         CellOrdering cellOrdering = CellOrdering::rowMajor, std::array<double, 3> origin = {0, 0, 0},
+                         std::array<bool, 6> remoteSides = {});
+
+    /**
+     * The cells hold pointers to the arena, so a container must not be copied. Moving a container moves the arena
+     * together with its cells. Assigning a container is not supported, because the old arena would be released before
+     * the old cells.
      */
+    LinkedCellsContainer(const LinkedCellsContainer &) = delete;
+
+    LinkedCellsContainer(LinkedCellsContainer &&) = default;
 
-    LinkedCellsContainer(std::array<double, 3> domainSize, double rCutOff, BoundarySet boundarySet);
+    LinkedCellsContainer &operator=(const LinkedCellsContainer &) = delete;
+
+    LinkedCellsContainer &operator=(LinkedCellsContainer &&) = delete;
 
     /**
      * @brief Calculate the index of the cell to which a particle decided by its position belongs.
@@ -232,9 +503,15 @@ public:
      *
      * If the simulation environment is 2D, only particles living in 2D space are accepted. Try adding particles living in 3D space
      * to 2D simulation environment will lead to the termination of the program.
+     * Particles beyond sides shared with another subdomain belong to that subdomain and are ignored.
      */
     void add(Particle& p) override;
 
+    /**
+     * @brief Remove all particles from this container. The storage of the cells is kept for the next particles.
+     */
+    void clear() override;
+
     /**
      * @brief Convert 3 dimensional coordinates to one dimensional coordinates.
      *
@@ -257,9 +534,42 @@ public:
 
     /**
      * @brief Assign each particle to its correct cell after there positions have been changed.
+     *
+     * If the number of particles has more than doubled since the capacities of the cells have last been preallocated,
+     * e.g. at the first update after the particles have been added, the cells are repacked for the current density
+     * first.
      */
     void updateCells();
 
+    /**
+     * @brief Re-sort the particle storage along the cell ordering.
+     *
+     * The storage of all cells is reallocated in the order of the cell indices, so that the particles of cells
+     * which are close along the cell ordering also end up close in memory. The capacities of the cells are
+     * preallocated for the current density and the storage released by the cells since the last re-sort is returned
+     * to the heap.
+     */
+    void sortParticles();
+
+    /**
+     * @brief Count the pairs tested by the cell traversal and the pairs within the cut-off radius, the particles in
+     *        each domain cell and the particles migrated by updateCells().
+     *
+     * The pairs are counted in an extra pass over the same cell groups as the force calculation, so the force
+     * calculation itself stays free of counters. The ghost layer is only included, if it is currently filled.
+     *
+     * @return Statistics of the current state.
+     */
+    [[nodiscard]] PairStatistics collectPairStatistics() const;
+
+    /**
+     * @brief Add the bytes of the particles, the unused storage of the cell arena, the precomputed indices, the Verlet
+     *        lists and the buffers kept between steps to a memory footprint.
+     *
+     * @param footprint Footprint to add to.
+     */
+    void accountMemory(MemoryFootprint &footprint) const override;
+
     /**
      * @brief Delete all particles in all halo cells being part of a specific size.
      *
@@ -267,6 +577,44 @@ public:
      */
     void clearHaloCells(Side side);
 
+    //Templated traversals:
+    //They take the functor as a template parameter, so that the compiler can inline it into the loops.
+    //The overrides of the std::function based interface of ParticleContainer forward to them.
+
+    /**
+     * @brief Iterate over all particles in this container and apply a functor to them.
+     *
+     * @param function Functor that is applied to each particle.
+     */
+    template<typename F>
+    void forEachParticle(F &&function);
+
+    /**
+     * @brief Iterate over all particles that are part of the domain and apply a functor to them.
+     *
+     * @param function Functor that is applied to each particle.
+     */
+    template<typename F>
+    void forEachParticleInDomain(F &&function);
+
+    /**
+     * @brief Iterate over all unique pairs of particles being part of the simulation domain which distance is smaller
+     *        or equal than the cut-off radius and apply a functor to them.
+     *
+     * @param function Functor that is applied to each unique pair of particles.
+     */
+    template<typename F>
+    void forEachUniquePairInDomain(F &&function);
+
+    /**
+     * @brief Same as forEachUniquePairInDomain, but the difference vector x_j - x_i and the distance of each pair
+     *        are passed to the functor as well, so they do not have to be calculated twice.
+     *
+     * @param function Functor that is applied to each unique pair of particles.
+     */
+    template<typename F>
+    void forEachUniquePairInDomainOptimized(F &&function);
+
     /**
      * @brief Iterate over all particles in this container and apply a lambda function to them.
      *
@@ -301,6 +649,89 @@ public:
 
     void applyToAllUniquePairsInDomainOptimized(const std::function<void(Particle &, Particle &, std::array<double, 3>, double)> &function);
 
+    /**
+     * @brief Calculate the forces between all unique pairs of particles being part of the simulation domain in parallel
+     *        and add them to the particles using Newton's third law of motion.
+     *
+     * @param forceFunction Lambda function calculating the force that the second particle exerts on the first one.
+     *                      It must not modify the particles, because it is called concurrently.
+     *
+     * Depending on the parallel strategy, either cell groups of the same colour are processed concurrently
+     * and the forces are added directly to the particles, or each thread accumulates its forces in its own buffer
+     * and all buffers are reduced afterwards.
+     */
+    template<typename F>
+    void applyForcesToAllUniquePairsInDomainParallel(F &&forceFunction);
+
+    /**
+     * @brief Copy positions, masses and parameter types of the particles of all cells inside the domain into their
+     *        structure of arrays buffers and reset the forces of the buffers.
+     */
+    void loadSoA();
+
+    /**
+     * @brief Write the forces of the structure of arrays buffers back to the particles of all cells inside the domain.
+     */
+    void extractSoA();
+
+    /**
+     * @brief Iterate over all cells and all unique pairs of neighbouring cells being part of the simulation domain
+     *        in their structure of arrays representation.
+     *
+     * @param withinCell Lambda function that is applied to each cell to process all pairs within that cell.
+     * @param betweenCells Lambda function that is applied to each unique pair of neighbouring cells.
+     *
+     * The buffers have to be filled using loadSoA() before. In contrast to applyToAllUniquePairsInDomain the cut-off
+     * radius has to be checked by the lambda functions themselves, so that they can process whole cells at once.
+     * If more than one thread is used, cell groups of the same colour are processed concurrently.
+     */
+    void applyToAllUniqueCellPairsInDomainSoA(const std::function<void(ParticleSoA &)> &withinCell,
+                                              const std::function<void(ParticleSoA &, ParticleSoA &)> &betweenCells);
+
+    /**
+     * @brief Build the Verlet lists of all particles inside the domain from the current cells.
+     *
+     * All unique pairs of particles with a distance smaller or equal than rCutOff + verletSkin are stored, including
+     * the pairs with the images of the ghost layer. Therefore, it has to be called after createGhostParticles().
+     */
+    void buildVerletLists();
+
+    /**
+     * @brief Check if the Verlet lists have to be rebuilt.
+     *
+     * @return True, if the lists have not been built yet, a particle has been added, a particle has left the domain
+     *         or a particle has moved more than half of the skin radius since the last rebuild. False otherwise.
+     *
+     * As long as no particle has moved more than half of the skin radius, no pair that is not part of the Verlet lists
+     * can have come closer than the cut-off radius.
+     */
+    bool areVerletListsOutdated();
+
+    /**
+     * @brief Check if the Verlet lists have been built and no particle has been added or moved to another cell since.
+     *
+     * @return True, if the Verlet lists match the current cells.
+     */
+    [[nodiscard]] bool areVerletListsBuilt() const {
+        return verletListsValid;
+    }
+
+    /**
+     * @brief Calculate the forces between all unique pairs of particles in the Verlet lists which distance is smaller
+     *        or equal than the cut-off radius and add them to the particles using Newton's third law of motion.
+     *
+     * @param forceFunction Lambda function calculating the force that the second particle exerts on the first one.
+     *                      Like in forEachUniquePairInDomainOptimized, the difference vector x_j - x_i and the distance
+     *                      of the pair are passed as well. For a pair with an image of the ghost layer, the second
+     *                      particle is the original particle and the difference refers to the image.
+     *                      It must not modify the particles, because it is called concurrently.
+     *
+     * If more than one thread is used, each thread accumulates its forces in its own buffer and all buffers are
+     * reduced afterwards, regardless of the parallel strategy.
+     */
+    template<typename F>
+    void applyForcesToAllVerletPairs(F &&forceFunction);
+
     /**
      * @brief Iterate over all particles in the boundary cells of a specific side
      *        which have a distance to that side that is smaller or equal than the threshold.
@@ -314,6 +745,20 @@ public:
      */
     void applyToAllBoundaryParticles(const std::function<void(Particle &, std::array<double, 3>&)> &function, Side boundary);
 
+    /**
+     * @brief Apply the force of a reflective wall to all particles in the boundary cells of a specific side
+     *        which have a distance to that side that is smaller or equal than the threshold.
+     *
+     * @param wallForce Lambda function that receives a particle and its distance to the wall (see
+     *                  calcDistanceFromBoundary()) and returns the force along the normal pointing into the domain.
+     * @param boundary Side to which the boundary cells belong.
+     *
+     * In contrast to applyToAllBoundaryParticles(), no ghost particle is involved: the wall only acts along one
+     * dimension, so only this component of the force is updated.
+     */
+    template<typename F>
+    void applyWallForces(F &&wallForce, Side boundary);
+
     /**
      * @brief Get the number of particles stored in this container.
      *
@@ -355,20 +800,62 @@ public:
 
 
     /**
-     * @brief Used for periodic boundaries to calculate the force that all particles from
-     *        the opposite edge exert on the particles on the specified cell on the specified side.
+     * @brief Fill the halo cells across periodic boundaries with images of the particles on the opposite side.
+     *
+     * The images are shifted by the size of the domain and start without any force. Afterwards, all traversals of the
+     * unique pairs in the domain also cover the interactions across periodic boundaries, each of them exactly once.
+     * The ghost layer has to be removed with removeGhostParticles() before the particles are moved between cells.
+     */
+    void createGhostParticles();
+
+    /**
+     * @brief Add the forces accumulated by the images to their original particles and remove the images again.
+     *
+     * This completes Newton's third law of motion for pairs across periodic boundaries.
+     */
+    void removeGhostParticles();
+
+    /**
+     * @brief Get the halo cells of the ghost layer which are filled with copies of the particles of other subdomains.
+     *
+     * @return Indices of the halo cells.
+     */
+    [[nodiscard]] std::vector<int> getRemoteGhostCells() const;
+
+    /**
+     * @brief Append an image to a halo cell of the ghost layer that belongs to another subdomain.
+     *
+     * Must only be called between createGhostParticles() and removeGhostParticles(). The image is taken from the pool
+     * and has to be initialised by the caller (position and properties, its force is reset). Its force is not
+     * added to any particle of this container when the ghost layer is removed.
+     *
+     * @param haloCell Index of the halo cell (see getRemoteGhostCells()).
+     *
+     * @return The new image.
+     */
+    Particle &appendGhostParticle(int haloCell);
+
+    /**
+     * @brief Move all particles stored in halo cells out of the container.
+     *
+     * Used to hand the particles which have left the domain across a side shared with another subdomain over to that
+     * subdomain, after all other halo cells have been processed.
      *
-     * @param side Side on which the force is exerted.
+     * @param leaving Vector the particles are appended to.
      */
-    void applyForcesFromOppositeSide(Side side);
+    void extractHaloParticles(std::vector<Particle> &leaving);
 
 
     //Getter and setters. Especially the setters should only by used for testing purposes.
 
-    std::vector<std::vector<Particle>>& getCells(){
+    std::vector<ParticleCell>& getCells(){
         return cells;
     }
 
+    [[nodiscard]] const CellArena& getCellArena() const {
+        return *arena;
+    }
+
     std::array<std::vector<int>,6>& getHaloCells(){
         return haloCells;
     }
@@ -381,6 +868,10 @@ public:
         return domainCellIterationScheme;
     }
 
+    [[nodiscard]] size_t getNumberOfGhostCells() const {
+        return ghostLayer.size();
+    }
+
     [[nodiscard]] int getNX() const {
         return nX;
     }
@@ -416,5 +907,325 @@ public:
     [[nodiscard]] std::array<double, 3> getDomainSize() const {
         return domainSize;
     }
+
+    [[nodiscard]] std::array<double, 3> getOrigin() const {
+        return origin;
+    }
+
+    [[nodiscard]] std::array<bool, 6> getRemoteSides() const {
+        return remoteSides;
+    }
+
+    [[nodiscard]] ParticleLayout getLayout() const {
+        return layout;
+    }
+
+    [[nodiscard]] double getVerletSkin() const {
+        return verletSkin;
+    }
+
+    [[nodiscard]] bool useVerletLists() const {
+        return verletSkin > 0;
+    }
+
+    [[nodiscard]] int getThreads() const {
+        return threads;
+    }
+
+    [[nodiscard]] CellOrdering getCellOrdering() const {
+        return cellOrdering;
+    }
+
+    [[nodiscard]] std::vector<std::vector<int>>& getColourGroups() {
+        return colourGroups;
+    }
 };
 
+template<typename F>
+void LinkedCellsContainer::processCellGroup(const std::vector<int> &cellGroup, F &&function) {
+    //First, consider all pairs within the cell that distance is smaller or equal then the cutoff radius
+    const double rCutOffSquared = rCutOff * rCutOff;
+    auto &cell = cells[cellGroup[0]];
+    for (size_t i = 0; i < cell.size(); i++) {
+        for (size_t j = i + 1; j < cell.size(); j++) {
+            if (ArrayUtils::L2NormSquared(cell[i].getX() - cell[j].getX()) <= rCutOffSquared) {
+                function(cellGroup[0], i, cellGroup[0], j);
+            }
+        }
+    }
+    //Then, consider all relevant neighbour cells
+    for (auto neighbour = cellGroup.begin() + 1; neighbour != cellGroup.end(); std::advance(neighbour, 1)) {
+        auto &neighbourCell = cells[*neighbour];
+        for (size_t i = 0; i < cell.size(); i++) {
+            for (size_t j = 0; j < neighbourCell.size(); j++) {
+                if (ArrayUtils::L2NormSquared(cell[i].getX() - neighbourCell[j].getX()) <= rCutOffSquared) {
+                    function(cellGroup[0], i, *neighbour, j);
+                }
+            }
+        }
+    }
+}
+
+template<typename F>
+void LinkedCellsContainer::forEachParticle(F &&function) {
+    for (auto &cell: cells) {
+        for (auto &p: cell) {
+            function(p);
+        }
+    }
+}
+
+template<typename F>
+void LinkedCellsContainer::forEachParticleInDomain(F &&function) {
+    for (auto &cellGroup: domainCellIterationScheme) {
+        for (auto &p: cells[cellGroup[0]]) {
+            function(p);
+        }
+    }
+}
+
+template<typename F>
+void LinkedCellsContainer::forEachUniquePairInDomain(F &&function) {
+    const double rCutOffSquared = rCutOff * rCutOff;
+    for (auto &cellGroup: domainCellIterationScheme) {
+        //First, consider all pairs within the cell that distance is smaller or equal then the cutoff radius
+
+        for (auto p_i = cells[cellGroup[0]].begin(); p_i != cells[cellGroup[0]].end(); std::advance(p_i, 1)) {
+            for (auto p_j = std::next(p_i); p_j != cells[cellGroup[0]].end(); std::advance(p_j, 1)) {
+                if (ArrayUtils::L2NormSquared(p_i->getX() - p_j->getX()) <= rCutOffSquared) {
+                    function(*p_i, *p_j);
+                }
+            }
+        }
+        //Then, consider all relevant neighbour cells
+
+        for (auto neighbour = cellGroup.begin() + 1; neighbour != cellGroup.end(); std::advance(neighbour, 1)) {
+            for (auto &p_i: cells[cellGroup[0]]) {
+                for (auto &p_j: cells[*neighbour]) {
+                    if (ArrayUtils::L2NormSquared(p_i.getX() - p_j.getX()) <= rCutOffSquared) {
+                        function(p_i, p_j);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<typename F>
+void LinkedCellsContainer::forEachUniquePairInDomainOptimized(F &&function) {
+    //The square root is only taken for the pairs within the cut-off radius
+    const double rCutOffSquared = rCutOff * rCutOff;
+    for (auto &cellGroup: domainCellIterationScheme) {
+        //First, consider all pairs within the cell that distance is smaller or equal then the cutoff radius
+
+        for (auto p_i = cells[cellGroup[0]].begin(); p_i != cells[cellGroup[0]].end(); std::advance(p_i, 1)) {
+            for (auto p_j = std::next(p_i); p_j != cells[cellGroup[0]].end(); std::advance(p_j, 1)) {
+                auto difference = p_j->getX() - p_i->getX();
+                const double squaredDistance = ArrayUtils::L2NormSquared(difference);
+                if (squaredDistance <= rCutOffSquared) {
+                    double distance = std::sqrt(squaredDistance);
+                    function(*p_i, *p_j, difference, distance);
+                }
+            }
+        }
+        //Then, consider all relevant neighbour cells
+
+        for (auto neighbour = cellGroup.begin() + 1; neighbour != cellGroup.end(); std::advance(neighbour, 1)) {
+            for (auto &p_i: cells[cellGroup[0]]) {
+                for (auto &p_j: cells[*neighbour]) {
+                    auto difference = p_j.getX() - p_i.getX();
+                    const double squaredDistance = ArrayUtils::L2NormSquared(difference);
+                    if (squaredDistance <= rCutOffSquared) {
+                        double distance = std::sqrt(squaredDistance);
+                        function(p_i, p_j, difference, distance);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<typename F>
+void LinkedCellsContainer::applyForcesToAllUniquePairsInDomainParallel(F &&forceFunction) {
+    const int numberCellGroups = static_cast<int>(domainCellIterationScheme.size());
+
+    if (parallelStrategy == ParallelStrategy::coloring) {
+        //Cell groups of the same colour do not share any cell, so the forces can be added directly to the particles
+        for (auto &colour: colourGroups) {
+            const int numberColourGroups = static_cast<int>(colour.size());
+            #pragma omp parallel num_threads(threads)
+            {
+                TRACE_SPAN("pair forces (colour)");
+                #pragma omp for schedule(dynamic)
+                for (int i = 0; i < numberColourGroups; i++) {
+                    processCellGroup(domainCellIterationScheme[colour[i]],
+                                     [&](int cellI, size_t i_, int cellJ, size_t j_) {
+                                         Particle &p_i = cells[cellI][i_];
+                                         Particle &p_j = cells[cellJ][j_];
+                                         auto f_ij{forceFunction(p_i, p_j)};
+                                         p_i.setF(p_i.getF() + f_ij);
+                                         p_j.setF(p_j.getF() - f_ij);
+                                     });
+                }
+            }
+        }
+        return;
+    }
+
+    //Number all particles cell by cell to be able to index the force buffers
+    cellOffsets.resize(cells.size() + 1);
+    cellOffsets[0] = 0;
+    for (size_t c = 0; c < cells.size(); c++) {
+        cellOffsets[c + 1] = cellOffsets[c] + cells[c].size();
+    }
+    threadForceBuffers.resize(threads);
+
+    #pragma omp parallel num_threads(threads)
+    {
+        TRACE_SPAN("pair forces (buffers)");
+        auto &buffer = threadForceBuffers[omp_get_thread_num()];
+        buffer.assign(cellOffsets.back(), {0, 0, 0});
+
+        //Each thread accumulates the forces of its cell groups in its own buffer
+        #pragma omp for schedule(dynamic)
+        for (int i = 0; i < numberCellGroups; i++) {
+            processCellGroup(domainCellIterationScheme[i], [&](int cellI, size_t i_, int cellJ, size_t j_) {
+                auto f_ij{forceFunction(cells[cellI][i_], cells[cellJ][j_])};
+                buffer[cellOffsets[cellI] + i_] = buffer[cellOffsets[cellI] + i_] + f_ij;
+                buffer[cellOffsets[cellJ] + j_] = buffer[cellOffsets[cellJ] + j_] - f_ij;
+            });
+        }
+
+        //Reduce all buffers. The implicit barrier of the loop above guarantees that all buffers are complete.
+        #pragma omp for schedule(static)
+        for (int i = 0; i < numberCellGroups; i++) {
+            int cell = domainCellIterationScheme[i][0];
+            for (size_t k = 0; k < cells[cell].size(); k++) {
+                std::array<double, 3> force = cells[cell][k].getF();
+                for (auto &threadBuffer: threadForceBuffers) {
+                    force = force + threadBuffer[cellOffsets[cell] + k];
+                }
+                cells[cell][k].setF(force);
+            }
+        }
+
+        //The images in the ghost layer collect their forces the same way
+        const int numberGhostCells = static_cast<int>(ghostLayer.size());
+        #pragma omp for schedule(static)
+        for (int i = 0; i < numberGhostCells; i++) {
+            int cell = ghostLayer[i].haloCell;
+            for (size_t k = ghostLayer[i].start; k < cells[cell].size(); k++) {
+                std::array<double, 3> force = cells[cell][k].getF();
+                for (auto &threadBuffer: threadForceBuffers) {
+                    force = force + threadBuffer[cellOffsets[cell] + k];
+                }
+                cells[cell][k].setF(force);
+            }
+        }
+    }
+}
+
+template<typename F, typename A>
+void LinkedCellsContainer::processVerletNeighbours(size_t i, F &&forceFunction, A &&addForces) {
+    const double rCutOffSquared = rCutOff * rCutOff;
+    Particle &p_i = *verletParticles[i];
+    for (size_t n = verletNeighbourOffsets[i]; n < verletNeighbourOffsets[i + 1]; n++) {
+        const VerletNeighbour &neighbour = verletNeighbours[n];
+        Particle &p_j = *verletParticles[neighbour.index];
+        auto difference = (p_j.getX() + verletShifts[neighbour.shift]) - p_i.getX();
+        const double squaredDistance = ArrayUtils::L2NormSquared(difference);
+        if (squaredDistance <= rCutOffSquared) {
+            double distance = std::sqrt(squaredDistance);
+            addForces(i, neighbour.index, forceFunction(p_i, p_j, difference, distance));
+        }
+    }
+}
+
+template<typename F>
+void LinkedCellsContainer::applyForcesToAllVerletPairs(F &&forceFunction) {
+    const int numberParticles = static_cast<int>(verletParticles.size());
+    if (threads == 1) {
+        for (int i = 0; i < numberParticles; i++) {
+            processVerletNeighbours(i, forceFunction, [this](size_t i_, size_t j_, const std::array<double, 3> &f_ij) {
+                verletParticles[i_]->setF(verletParticles[i_]->getF() + f_ij);
+                verletParticles[j_]->setF(verletParticles[j_]->getF() - f_ij);
+            });
+        }
+        return;
+    }
+
+    threadForceBuffers.resize(threads);
+    #pragma omp parallel num_threads(threads)
+    {
+        TRACE_SPAN("pair forces (Verlet lists)");
+        auto &buffer = threadForceBuffers[omp_get_thread_num()];
+        buffer.assign(numberParticles, {0, 0, 0});
+
+        //Each thread accumulates the forces of its particles in its own buffer
+        #pragma omp for schedule(dynamic, 64)
+        for (int i = 0; i < numberParticles; i++) {
+            processVerletNeighbours(i, forceFunction, [&buffer](size_t i_, size_t j_, const std::array<double, 3> &f_ij) {
+                buffer[i_] = buffer[i_] + f_ij;
+                buffer[j_] = buffer[j_] - f_ij;
+            });
+        }
+
+        //Reduce all buffers. The implicit barrier of the loop above guarantees that all buffers are complete.
+        #pragma omp for schedule(static)
+        for (int i = 0; i < numberParticles; i++) {
+            std::array<double, 3> force = verletParticles[i]->getF();
+            for (auto &threadBuffer: threadForceBuffers) {
+                force = force + threadBuffer[i];
+            }
+            verletParticles[i]->setF(force);
+        }
+    }
+}
+
+template<typename F>
+void LinkedCellsContainer::applyWallForces(F &&wallForce, Side boundary) {
+    //Resolve the side once: dimension of the normal, its direction and the position of the wall
+    int dim = 0;
+    double direction = 1;
+    double wall = 0;
+    switch (boundary) {
+        case Side::front:
+            dim = 1;
+            break;
+        case Side::right:
+            dim = 0;
+            direction = -1;
+            wall = domainSize[0];
+            break;
+        case Side::back:
+            dim = 1;
+            direction = -1;
+            wall = domainSize[1];
+            break;
+        case Side::left:
+            dim = 0;
+            break;
+        case Side::top:
+            dim = 2;
+            direction = -1;
+            wall = domainSize[2];
+            break;
+        case Side::bottom:
+            dim = 2;
+            break;
+    }
+    wall += origin[dim];
+    //The repulsive part of the Leonard-Jones potential ends at 2^(1/6) * sigma
+    const double sixthRootOfTwo = std::pow(2.0, 1.0 / 6.0);
+    for (int cell: boundaries[static_cast<int>(boundary)]) {
+        for (Particle &p: cells[cell]) {
+            //Same as calcDistanceFromBoundary(p, boundary)
+            const double distanceFromBoundary = direction * (p.getX()[dim] - wall);
+            if (0 < distanceFromBoundary && distanceFromBoundary <= sixthRootOfTwo * p.getSigma()) {
+                std::array<double, 3> force = p.getF();
+                force[dim] += direction * wallForce(p, distanceFromBoundary);
+                p.setF(force);
+            }
+        }
+    }
+}
@@ -7,15 +7,16 @@
 
 #include "Particle.h"
 
-
-Particle::Particle(int type_arg) : f{0., 0., 0.}, old_f{0., 0., 0.}, type{type_arg}, epsilon{5}, sigma{1} {
+Particle::Particle(int type_arg) : f{0., 0., 0.}, old_f{0., 0., 0.}, type{type_arg}, epsilon{5}, sigma{1},
+                                   parameterType{0} {
     std::stringstream stream;
     spdlog::trace("Particle generated with the following parameters: X={}, v={}, f={}, type={}, epsilon{}, sigma{}",
                   ArrayUtils::to_string(x), ArrayUtils::to_string(v), ArrayUtils::to_string(f), type, epsilon, sigma);
 }
 
 Particle::Particle(const Particle &other) : x{other.x}, v{other.v}, f{other.f}, old_f{other.old_f}, m{other.m},
-                                            type{other.type}, epsilon{other.epsilon}, sigma{other.sigma} {
+                                            type{other.type}, epsilon{other.epsilon}, sigma{other.sigma},
+                                            parameterType{other.parameterType} {
     spdlog::trace(
         "Particle generated by copy with the following parameters: X={}, v={}, f={}, type={} epsilon={}, sigma={}",
         ArrayUtils::to_string(x), ArrayUtils::to_string(v), ArrayUtils::to_string(f), type, epsilon, sigma);
@@ -23,7 +24,8 @@ Particle::Particle(const Particle &other) : x{other.x}, v{other.v}, f{other.f},
 
 Particle::Particle(std::array<double, 3> x_arg, std::array<double, 3> v_arg,
                    double m_arg, int type_arg, double epsilon_arg, double sigma_arg) : x{x_arg}, v{v_arg},
-    f{{0, 0, 0}}, old_f{0, 0, 0}, m{m_arg}, type{type_arg}, epsilon{epsilon_arg}, sigma{sigma_arg} {
+    f{{0, 0, 0}}, old_f{0, 0, 0}, m{m_arg}, type{type_arg}, epsilon{epsilon_arg}, sigma{sigma_arg},
+    parameterType{0} {
     spdlog::trace("Particle generated with the following parameters: X={}, v={}, f={}, type={}, epsilon={}, sigma={}",
                   ArrayUtils::to_string(x), ArrayUtils::to_string(v), ArrayUtils::to_string(f), type, epsilon, sigma);
 }
@@ -59,6 +61,10 @@ double Particle::getSigma() const {
     return sigma;
 }
 
+int Particle::getParameterType() const {
+    return parameterType;
+}
+
 
 void Particle::setOldF(const std::array<double, 3> &oldF) {
     old_f = oldF;
@@ -80,6 +86,17 @@ void Particle::setType(const int type) {
     this->type = type;
 }
 
+void Particle::setProperties(double m, int type, double epsilon, double sigma) {
+    this->m = m;
+    this->type = type;
+    this->epsilon = epsilon;
+    this->sigma = sigma;
+}
+
+void Particle::setParameterType(int parameterType) {
+    this->parameterType = parameterType;
+}
+
 std::string Particle::toString() const {
     std::stringstream stream;
     stream << "Particle: X:" << x << " v: " << v << " f: " << f
@@ -57,11 +57,26 @@ private:
 
     double sigma;
 
+    /**
+     * Parameter type of the pair (sigma, epsilon) in the LeonardJonesTypeRegistry of the force. It is assigned when the
+     * particle is added to a model (see Force::registerParameterType()). Type 0 stands for the default parameters.
+     */
+    int parameterType;
+
 public:
     explicit Particle(int type = 0);
 
     Particle(const Particle &other);
 
+    /**
+     * Moving a particle (e.g. between cells) does not log, unlike the copy constructor.
+     */
+    Particle(Particle &&other) noexcept = default;
+
+    Particle &operator=(const Particle &other) = default;
+
+    Particle &operator=(Particle &&other) noexcept = default;
+
     Particle(
         // for visualization, we need always 3 coordinates
         // -> in case of 2d, we use only the first and the second
@@ -97,6 +112,8 @@ public:
 
     [[nodiscard]] double getSigma() const;
 
+    [[nodiscard]] int getParameterType() const;
+
     void setOldF(const std::array<double, 3> &oldF);
 
     void setF(const std::array<double, 3> &f);
@@ -107,6 +124,24 @@ public:
 
     void setType(const int type);
 
+    /**
+     * @brief Set the mass, the type and the Leonard-Jones parameters at once, e.g. when a particle is reused to
+     *        represent another one. Unlike the constructors, this does not log. The parameter type is not changed.
+     *
+     * @param m Mass.
+     * @param type Type.
+     * @param epsilon Leonard-Jones parameter epsilon.
+     * @param sigma Leonard-Jones parameter sigma.
+     */
+    void setProperties(double m, int type, double epsilon, double sigma);
+
+    /**
+     * @brief Set the parameter type of the Leonard-Jones parameters of this particle.
+     *
+     * @param parameterType Parameter type in the LeonardJonesTypeRegistry of the force.
+     */
+    void setParameterType(int parameterType);
+
     bool operator==(Particle &other) const;
 
     [[nodiscard]] std::string toString() const;
@@ -0,0 +1,41 @@
+#include "ParticleSoA.h"
+
+#include <algorithm>
+
+void ParticleSoA::resize(size_t n) {
+    for (int d = 0; d < 3; d++) {
+        x[d].resize(n);
+        f[d].resize(n);
+    }
+    m.resize(n);
+    parameterType.resize(n);
+}
+
+void ParticleSoA::load(const Particle *particles, size_t n) {
+    resize(n);
+    for (size_t i = 0; i < n; i++) {
+        const Particle &p = particles[i];
+        for (int d = 0; d < 3; d++) {
+            x[d][i] = p.getX()[d];
+        }
+        m[i] = p.getM();
+        parameterType[i] = p.getParameterType();
+    }
+    for (int d = 0; d < 3; d++) {
+        std::fill(f[d].begin(), f[d].end(), 0.0);
+    }
+}
+
+void ParticleSoA::extractForces(Particle *particles, size_t n) const {
+    for (size_t i = 0; i < n; i++) {
+        particles[i].setF({f[0][i], f[1][i], f[2][i]});
+    }
+}
+
+size_t ParticleSoA::capacityBytes() const {
+    size_t bytes = m.capacity() * sizeof(double) + parameterType.capacity() * sizeof(int);
+    for (size_t dim = 0; dim < 3; dim++) {
+        bytes += (x[dim].capacity() + f[dim].capacity()) * sizeof(double);
+    }
+    return bytes;
+}
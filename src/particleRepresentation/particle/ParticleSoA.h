@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Particle.h"
+
+/**
+ * @brief Structure-of-Arrays representation of the attributes of a group of particles (e.g. all particles of one cell)
+ *        that are needed by the force calculation.
+ *
+ * Each attribute is stored in its own contiguous array, so that the kernels do not have to drag all other attributes
+ * of the particles through the cache. The i-th entry of every array belongs to the i-th particle of the group the
+ * buffer was loaded from. Only positions, masses and parameter types are mirrored from the particles, the forces start
+ * at zero and are the only attribute written back.
+ *
+ * The arrays keep their capacity when the buffer is reloaded, so no reallocation happens in steady state.
+ */
+class ParticleSoA {
+public:
+    /**
+     * Positions of the particles, one array per dimension.
+     */
+    std::array<std::vector<double>, 3> x;
+
+    /**
+     * Forces calculated for the particles, one array per dimension.
+     */
+    std::array<std::vector<double>, 3> f;
+
+    /**
+     * Masses of the particles.
+     */
+    std::vector<double> m;
+
+    /**
+     * Parameter types of the particles in the LeonardJonesTypeRegistry.
+     */
+    std::vector<int> parameterType;
+
+    /**
+     * @brief Copy positions, masses and parameter types of the given particles into this buffer and reset the forces.
+     *        Previous content is overwritten.
+     *
+     * @param particles Particles to load.
+     * @param n Number of particles.
+     */
+    void load(const Particle *particles, size_t n);
+
+    /**
+     * @brief Copy the particles of a vector, e.g. of a cell, into this buffer.
+     *
+     * @param particles Particles to load.
+     */
+    template<typename Allocator>
+    void load(const std::vector<Particle, Allocator> &particles) {
+        load(particles.data(), particles.size());
+    }
+
+    /**
+     * @brief Write the forces stored in this buffer to the particles it was loaded from. The forces of the particles
+     *        are overwritten, so they have to be reset before loading.
+     *
+     * @param particles Particles this buffer was loaded from. Order and number must not have changed since loading.
+     * @param n Number of particles.
+     */
+    void extractForces(Particle *particles, size_t n) const;
+
+    template<typename Allocator>
+    void extractForces(std::vector<Particle, Allocator> &particles) const {
+        extractForces(particles.data(), particles.size());
+    }
+
+    /**
+     * @brief Get the number of particles stored in this buffer.
+     *
+     * @return Number of particles stored in this buffer.
+     */
+    [[nodiscard]] size_t size() const {
+        return m.size();
+    }
+
+    /**
+     * @brief Get the number of bytes allocated by all arrays of this buffer.
+     *
+     * @return Allocated bytes.
+     */
+    [[nodiscard]] size_t capacityBytes() const;
+
+private:
+    /**
+     * @brief Resize all arrays to hold n particles.
+     *
+     * @param n Number of particles.
+     */
+    void resize(size_t n);
+};
@@ -0,0 +1,258 @@
+#include "HardwareCounters.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <omp.h>
+#include <sstream>
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef __linux__
+    /**
+     * @brief Description of an event for perf_event_open.
+     */
+    struct EventConfig {
+        CounterEvent event;
+        uint32_t type;
+        uint64_t config;
+        double weight;
+    };
+
+    /**
+     * @brief Determine the vendor of the processor.
+     *
+     * @return Vendor id from /proc/cpuinfo, e.g. GenuineIntel or AuthenticAMD.
+     */
+    std::string cpuVendor() {
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line)) {
+            if (line.rfind("vendor_id", 0) == 0) {
+                return line.substr(line.find(':') + 2);
+            }
+        }
+        return "";
+    }
+
+    uint64_t cacheEvent(uint64_t cache, uint64_t operation, uint64_t result) {
+        return cache | (operation << 8) | (result << 16);
+    }
+
+    std::vector<EventConfig> eventConfigs() {
+        std::vector<EventConfig> configs = {
+            {CounterEvent::cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, 1},
+            {CounterEvent::instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, 1},
+            {
+                CounterEvent::l1dMisses, PERF_TYPE_HW_CACHE,
+                cacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS), 1
+            },
+            {CounterEvent::llcMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, 1},
+            {CounterEvent::branchMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, 1},
+        };
+        const std::string vendor = cpuVendor();
+        if (vendor == "GenuineIntel") {
+            //FP_ARITH_INST_RETIRED: scalar, 128, 256 and 512 bit packed double, weighted by the doubles per instruction
+            configs.push_back({CounterEvent::flops, PERF_TYPE_RAW, 0x01c7, 1});
+            configs.push_back({CounterEvent::flops, PERF_TYPE_RAW, 0x04c7, 2});
+            configs.push_back({CounterEvent::flops, PERF_TYPE_RAW, 0x10c7, 4});
+            configs.push_back({CounterEvent::flops, PERF_TYPE_RAW, 0x40c7, 8});
+        } else if (vendor == "AuthenticAMD") {
+            //RETIRED_SSE_AVX_FLOPS of all types
+            configs.push_back({CounterEvent::flops, PERF_TYPE_RAW, 0xff03, 1});
+        }
+        return configs;
+    }
+
+    /**
+     * @brief Open an event for the calling thread.
+     *
+     * @return File descriptor, or -1 if the event cannot be counted.
+     */
+    int openEvent(const EventConfig &config) {
+        perf_event_attr attributes{};
+        attributes.size = sizeof(perf_event_attr);
+        attributes.type = config.type;
+        attributes.config = config.config;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+#endif
+
+    /**
+     * @brief Format a value for the report.
+     *
+     * @param value Value.
+     * @param valid If false, n/a is returned.
+     *
+     * @return Formatted value.
+     */
+    std::string format(double value, bool valid) {
+        if (!valid) {
+            return "n/a";
+        }
+        std::ostringstream out;
+        if (value >= 1e5) {
+            out << std::scientific << std::setprecision(3) << value;
+        } else {
+            out << std::fixed << std::setprecision(3) << value;
+        }
+        return out.str();
+    }
+}
+
+HardwareCounters &HardwareCounters::global() {
+    static HardwareCounters counters;
+    return counters;
+}
+
+const char *HardwareCounters::name(CounterEvent event) {
+    switch (event) {
+        case CounterEvent::cycles:
+            return "cycles";
+        case CounterEvent::instructions:
+            return "instructions";
+        case CounterEvent::l1dMisses:
+            return "L1d misses";
+        case CounterEvent::llcMisses:
+            return "LLC misses";
+        case CounterEvent::branchMisses:
+            return "branch misses";
+        case CounterEvent::flops:
+            return "FP64 ops";
+    }
+    return "invalid";
+}
+
+HardwareCounters::~HardwareCounters() {
+    close();
+}
+
+bool HardwareCounters::open() {
+    close();
+#ifdef __linux__
+    const auto configs = eventConfigs();
+    const int threads = omp_get_max_threads();
+    std::vector<std::vector<Counter>> threadCounters(threads);
+    //An event is only available, if it can be counted on every thread
+    std::vector<std::vector<bool>> opened(threads, std::vector<bool>(configs.size(), false));
+
+    //Counters of a thread only count the events of the thread that opened them
+    #pragma omp parallel num_threads(threads)
+    {
+        const int thread = omp_get_thread_num();
+        for (size_t i = 0; i < configs.size(); i++) {
+            int fd = openEvent(configs[i]);
+            if (fd >= 0) {
+                threadCounters[thread].push_back({fd, configs[i].event, configs[i].weight});
+                opened[thread][i] = true;
+            }
+        }
+    }
+
+    std::array<bool, numberOfEvents> complete{};
+    complete.fill(true);
+    std::array<bool, numberOfEvents> configured{};
+    for (size_t i = 0; i < configs.size(); i++) {
+        auto event = static_cast<size_t>(configs[i].event);
+        configured[event] = true;
+        for (int thread = 0; thread < threads; thread++) {
+            complete[event] = complete[event] && opened[thread][i];
+        }
+    }
+    for (size_t event = 0; event < numberOfEvents; event++) {
+        available[event] = configured[event] && complete[event];
+    }
+    for (auto &countersOfThread: threadCounters) {
+        for (auto &counter: countersOfThread) {
+            if (available[static_cast<size_t>(counter.event)]) {
+                counters.push_back(counter);
+            } else {
+                ::close(counter.fd);
+            }
+        }
+    }
+    if (counters.empty()) {
+        spdlog::warn("Hardware counters are not available (check /proc/sys/kernel/perf_event_paranoid).");
+        return false;
+    }
+    for (size_t event = 0; event < numberOfEvents; event++) {
+        if (!available[event]) {
+            spdlog::warn("The hardware event {} is not available.", name(static_cast<CounterEvent>(event)));
+        }
+    }
+    return true;
+#else
+    spdlog::warn("Hardware counters are only available on Linux.");
+    return false;
+#endif
+}
+
+void HardwareCounters::close() {
+#ifdef __linux__
+    for (auto &counter: counters) {
+        ::close(counter.fd);
+    }
+#endif
+    counters.clear();
+    available.fill(false);
+}
+
+HardwareCounters::Values HardwareCounters::read() const {
+    Values values{};
+#ifdef __linux__
+    for (auto &counter: counters) {
+        //Count, time enabled and time running
+        uint64_t buffer[3];
+        if (::read(counter.fd, buffer, sizeof(buffer)) != sizeof(buffer) || buffer[2] == 0) {
+            continue;
+        }
+        const double scaling = static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]);
+        values[static_cast<size_t>(counter.event)] += counter.weight * static_cast<double>(buffer[0]) * scaling;
+    }
+#endif
+    return values;
+}
+
+void HardwareCounters::printReport(std::ostream &out, const std::vector<Row> &rows, double pairInteractions) const {
+    auto value = [](const Row &row, CounterEvent event) {
+        return row.values[static_cast<size_t>(event)];
+    };
+    const bool perPair = pairInteractions > 0;
+
+    out << "Hardware counters" << (perPair ? " (misses per pair interaction)" : "") << ":\n";
+    out << std::left << std::setw(12) << "phase" << std::right;
+    for (const char *column: {"cycles", "instructions", "IPC", "L1d misses", "LLC misses", "branch misses", "GFLOP/s"}) {
+        out << std::setw(14) << column;
+    }
+    out << "\n";
+    for (const auto &row: rows) {
+        const double cycles = value(row, CounterEvent::cycles);
+        const double divisor = perPair ? pairInteractions : 1;
+        out << std::left << std::setw(12) << row.name << std::right
+                << std::setw(14) << format(cycles, isAvailable(CounterEvent::cycles))
+                << std::setw(14) << format(value(row, CounterEvent::instructions),
+                                           isAvailable(CounterEvent::instructions))
+                << std::setw(14) << format(value(row, CounterEvent::instructions) / cycles,
+                                           isAvailable(CounterEvent::cycles) &&
+                                           isAvailable(CounterEvent::instructions) && cycles > 0)
+                << std::setw(14) << format(value(row, CounterEvent::l1dMisses) / divisor,
+                                           isAvailable(CounterEvent::l1dMisses))
+                << std::setw(14) << format(value(row, CounterEvent::llcMisses) / divisor,
+                                           isAvailable(CounterEvent::llcMisses))
+                << std::setw(14) << format(value(row, CounterEvent::branchMisses),
+                                           isAvailable(CounterEvent::branchMisses))
+                << std::setw(14) << format(value(row, CounterEvent::flops) / row.seconds / 1e9,
+                                           isAvailable(CounterEvent::flops) && row.seconds > 0)
+                << "\n";
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Hardware events counted by HardwareCounters.
+ */
+enum class CounterEvent {
+    cycles, instructions, l1dMisses, llcMisses, branchMisses, flops
+};
+
+/**
+ * @brief Counts hardware events of the process with perf_event_open (Linux only).
+ *
+ * Every event is counted separately on every thread of the OpenMP thread pool, so that the counts include the work of
+ * all threads. If the kernel multiplexes the events, the counts are scaled by the fraction of time the event was
+ * actually counted. Double precision floating point operations are counted on Intel (FP_ARITH_INST_RETIRED) and AMD
+ * (RETIRED_SSE_AVX_FLOPS) processors. Events which are not supported by the processor or the kernel are marked as
+ * unavailable.
+ */
+class HardwareCounters {
+public:
+    static constexpr size_t numberOfEvents = static_cast<size_t>(CounterEvent::flops) + 1;
+
+    //Counts of all events, indexed by CounterEvent
+    using Values = std::array<double, numberOfEvents>;
+
+    /**
+     * @brief Row of a counter report.
+     */
+    struct Row {
+        std::string name;
+        //Wall-clock time in seconds
+        double seconds;
+        Values values;
+    };
+
+    /**
+     * @brief Get the counters shared by the whole program.
+     *
+     * @return Global counters.
+     */
+    static HardwareCounters &global();
+
+    /**
+     * @brief Get the name of an event.
+     *
+     * @param event Event.
+     *
+     * @return Name of the event.
+     */
+    static const char *name(CounterEvent event);
+
+    ~HardwareCounters();
+
+    /**
+     * @brief Start counting on all threads of the OpenMP thread pool (see omp_get_max_threads()).
+     *
+     * @return true, if at least one event can be counted.
+     */
+    bool open();
+
+    /**
+     * @brief Stop counting and release all counters.
+     */
+    void close();
+
+    [[nodiscard]] bool isOpen() const {
+        return !counters.empty();
+    }
+
+    /**
+     * @brief Check, if an event is counted.
+     *
+     * @param event Event.
+     *
+     * @return true, if the event is supported and counted.
+     */
+    [[nodiscard]] bool isAvailable(CounterEvent event) const {
+        return available[static_cast<size_t>(event)];
+    }
+
+    /**
+     * @brief Read the counts since open(), summed over all threads.
+     *
+     * @return Current counts. The counts of unavailable events are 0.
+     */
+    [[nodiscard]] Values read() const;
+
+    /**
+     * @brief Print the counts and derived metrics (IPC, misses per pair interaction, GFLOP/s) of several rows.
+     *
+     * @param out Stream to print to.
+     * @param rows Rows to print.
+     * @param pairInteractions Number of pair interactions the misses are related to. If 0, the misses per pair
+     *                         interaction are omitted.
+     */
+    void printReport(std::ostream &out, const std::vector<Row> &rows, double pairInteractions) const;
+
+private:
+    /**
+     * @brief File descriptor of one event on one thread.
+     */
+    struct Counter {
+        int fd;
+        CounterEvent event;
+        //Factor applied to the count, e.g. the number of operations of a vector instruction
+        double weight;
+    };
+
+    std::vector<Counter> counters;
+    std::array<bool, numberOfEvents> available{};
+};
+
+/**
+ * @brief Subtract the counts of two readings.
+ *
+ * @param end Later reading.
+ * @param start Earlier reading.
+ *
+ * @return Counts between both readings.
+ */
+inline HardwareCounters::Values operator-(const HardwareCounters::Values &end, const HardwareCounters::Values &start) {
+    HardwareCounters::Values difference{};
+    for (size_t i = 0; i < HardwareCounters::numberOfEvents; i++) {
+        difference[i] = end[i] - start[i];
+    }
+    return difference;
+}
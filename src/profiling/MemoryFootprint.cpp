@@ -0,0 +1,106 @@
+#include "MemoryFootprint.h"
+
+#include <algorithm>
+#include <iomanip>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+namespace {
+    double toMegabytes(size_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+}
+
+const char *MemoryFootprint::name(MemoryCategory category) {
+    switch (category) {
+        case MemoryCategory::particles:
+            return "particles";
+        case MemoryCategory::cellSlack:
+            return "cell slack";
+        case MemoryCategory::haloCells:
+            return "halo cells";
+        case MemoryCategory::boundaries:
+            return "boundaries";
+        case MemoryCategory::cellIterationScheme:
+            return "iteration scheme";
+        case MemoryCategory::cellStructures:
+            return "cell structures";
+        case MemoryCategory::verletLists:
+            return "verlet lists";
+        case MemoryCategory::workBuffers:
+            return "work buffers";
+        case MemoryCategory::outputBuffers:
+            return "output buffers";
+        case MemoryCategory::vtkTree:
+            return "vtk tree";
+    }
+    return "invalid";
+}
+
+size_t MemoryFootprint::total() const {
+    size_t sum = 0;
+    for (size_t value: bytes) {
+        sum += value;
+    }
+    return sum;
+}
+
+void MemoryAccounting::record(const MemoryFootprint &footprint) {
+    if (numberSamples++ == 0) {
+        startup = footprint;
+    }
+    for (size_t category = 0; category < MemoryFootprint::numberOfCategories; category++) {
+        auto c = static_cast<MemoryCategory>(category);
+        peak.set(c, std::max(peak.get(c), footprint.get(c)));
+    }
+    peakTotal = std::max(peakTotal, footprint.total());
+}
+
+void MemoryAccounting::reset() {
+    numberSamples = 0;
+    startup = {};
+    peak = {};
+    peakTotal = 0;
+}
+
+size_t MemoryAccounting::peakResidentSetSize() {
+#ifdef __linux__
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        //Linux reports the maximum resident set size in kilobytes
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+    }
+#endif
+    return 0;
+}
+
+void MemoryAccounting::printReport(std::ostream &out) const {
+    if (numberSamples == 0) {
+        return;
+    }
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << "Memory footprint over " << numberSamples << " samples (in MB):\n";
+    out << std::left << std::setw(20) << "category" << std::right << std::setw(12) << "startup" << std::setw(12)
+            << "peak" << "\n" << std::fixed << std::setprecision(3);
+    for (size_t category = 0; category < MemoryFootprint::numberOfCategories; category++) {
+        auto c = static_cast<MemoryCategory>(category);
+        out << std::left << std::setw(20) << MemoryFootprint::name(c) << std::right << std::setw(12)
+                << toMegabytes(startup.get(c)) << std::setw(12) << toMegabytes(peak.get(c)) << "\n";
+    }
+    out << std::left << std::setw(20) << "total" << std::right << std::setw(12) << toMegabytes(startup.total())
+            << std::setw(12) << toMegabytes(peakTotal) << "\n";
+
+    const size_t residentSetSize = peakResidentSetSize();
+    if (residentSetSize > 0) {
+        //The resident set size also covers the program, its libraries and everything not accounted above
+        const auto request = static_cast<long long>(toMegabytes(residentSetSize) * 1.2 + 64);
+        out << std::left << std::setw(20) << "peak resident set" << std::right << std::setw(24)
+                << toMegabytes(residentSetSize) << "\n";
+        out << "Suggested Slurm request: --mem=" << request << "mb\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief Data structures whose memory is accounted separately.
+ */
+enum class MemoryCategory {
+    //Particles stored in the container (only the used part of the storage)
+    particles,
+    //Allocated, but unused storage of the particles, i.e. of the cells, the free blocks of the cell arena and of the
+    //vector of cells
+    cellSlack,
+    //Indices of the halo cells of each side
+    haloCells,
+    //Indices of the boundary cells of each side
+    boundaries,
+    //Cell groups of the domain cell iteration scheme
+    cellIterationScheme,
+    //Colour groups, ghost layer and cell ordering
+    cellStructures,
+    verletLists,
+    //Buffers kept between steps, e.g. for migration, ghost particles, per-thread forces and the structure of arrays
+    workBuffers,
+    //Buffers of the output writers, including the snapshots of the background writer
+    outputBuffers,
+    //Object tree of the last vtk file
+    vtkTree
+};
+
+/**
+ * @brief Bytes held by the data structures of a simulation at one point in time.
+ *
+ * The bytes are determined by explicit size queries of the data structures, i.e. the capacity of their vectors. The
+ * overhead of the allocator and small members are not included.
+ */
+class MemoryFootprint {
+public:
+    static constexpr size_t numberOfCategories = static_cast<size_t>(MemoryCategory::vtkTree) + 1;
+
+    /**
+     * @brief Get the name of a category as used in the report.
+     *
+     * @param category Category.
+     *
+     * @return Name of the category.
+     */
+    static const char *name(MemoryCategory category);
+
+    /**
+     * @brief Get the bytes allocated by a vector.
+     *
+     * @param vector Vector.
+     *
+     * @return Bytes of the storage of the vector.
+     */
+    template<typename T>
+    static size_t bytesOf(const std::vector<T> &vector) {
+        return vector.capacity() * sizeof(T);
+    }
+
+    /**
+     * @brief Get the bytes allocated by a vector of vectors, including the inner vectors.
+     *
+     * @param vector Vector of vectors.
+     *
+     * @return Bytes of the storage of all vectors.
+     */
+    template<typename T>
+    static size_t bytesOf(const std::vector<std::vector<T>> &vector) {
+        size_t bytes = vector.capacity() * sizeof(std::vector<T>);
+        for (auto &inner: vector) {
+            bytes += inner.capacity() * sizeof(T);
+        }
+        return bytes;
+    }
+
+    void add(MemoryCategory category, size_t numberOfBytes) {
+        bytes[static_cast<size_t>(category)] += numberOfBytes;
+    }
+
+    void set(MemoryCategory category, size_t numberOfBytes) {
+        bytes[static_cast<size_t>(category)] = numberOfBytes;
+    }
+
+    [[nodiscard]] size_t get(MemoryCategory category) const {
+        return bytes[static_cast<size_t>(category)];
+    }
+
+    /**
+     * @brief Get the bytes of all categories.
+     *
+     * @return Sum over all categories.
+     */
+    [[nodiscard]] size_t total() const;
+
+private:
+    std::array<size_t, numberOfCategories> bytes{};
+};
+
+/**
+ * @brief Keeps the memory footprint at the start of a run and the largest footprint during the run.
+ */
+class MemoryAccounting {
+public:
+    /**
+     * @brief Record a footprint. The first footprint after a reset is kept as footprint at startup.
+     *
+     * @param footprint Footprint of the current state.
+     */
+    void record(const MemoryFootprint &footprint);
+
+    /**
+     * @brief Discard all recorded footprints.
+     */
+    void reset();
+
+    [[nodiscard]] size_t samples() const {
+        return numberSamples;
+    }
+
+    [[nodiscard]] const MemoryFootprint &getStartup() const {
+        return startup;
+    }
+
+    /**
+     * @brief Get the largest footprint of each category. The peaks of different categories may occur at different
+     *        times.
+     *
+     * @return Peak of each category.
+     */
+    [[nodiscard]] const MemoryFootprint &getPeak() const {
+        return peak;
+    }
+
+    /**
+     * @brief Get the largest total footprint.
+     *
+     * @return Largest sum over all categories of a single footprint.
+     */
+    [[nodiscard]] size_t getPeakTotal() const {
+        return peakTotal;
+    }
+
+    /**
+     * @brief Get the largest resident set size of this process so far, as seen by the operating system.
+     *
+     * @return Peak resident set size in bytes, or 0 if it is not available on this platform.
+     */
+    static size_t peakResidentSetSize();
+
+    /**
+     * @brief Print the footprint at startup and at peak of each category, the peak resident set size of the process and
+     *        the memory to request from Slurm (sbatch --mem) with some headroom.
+     *
+     * @param out Stream to print to.
+     */
+    void printReport(std::ostream &out) const;
+
+private:
+    size_t numberSamples = 0;
+    MemoryFootprint startup;
+    MemoryFootprint peak;
+    size_t peakTotal = 0;
+};
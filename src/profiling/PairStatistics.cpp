@@ -0,0 +1,131 @@
+#include "PairStatistics.h"
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+    double share(uint64_t part, uint64_t whole) {
+        return whole > 0 ? static_cast<double>(part) / static_cast<double>(whole) : 0;
+    }
+}
+
+uint64_t PairStatistics::cells() const {
+    uint64_t sum = 0;
+    for (uint64_t count: occupancy) {
+        sum += count;
+    }
+    return sum;
+}
+
+double PairStatistics::emptyCellFraction() const {
+    return occupancy.empty() ? 0 : share(occupancy[0], cells());
+}
+
+double PairStatistics::meanOccupancy() const {
+    uint64_t particles = 0;
+    for (size_t n = 0; n < occupancy.size(); n++) {
+        particles += n * occupancy[n];
+    }
+    return share(particles, cells());
+}
+
+double PairStatistics::hitRate() const {
+    return share(pairsWithinCutOff, candidatePairs);
+}
+
+void PairStatisticsRecorder::add(int iteration, const PairStatistics &statistics) {
+    iterations.push_back(iteration);
+    snapshots.push_back(statistics);
+}
+
+void PairStatisticsRecorder::reset() {
+    iterations.clear();
+    snapshots.clear();
+}
+
+void PairStatisticsRecorder::printReport(std::ostream &out) const {
+    if (snapshots.empty()) {
+        return;
+    }
+    const auto numberSamples = static_cast<double>(snapshots.size());
+    double candidates = 0;
+    double withinCutOff = 0;
+    double verlet = 0;
+    double emptyCells = 0;
+    double particlesPerCell = 0;
+    //Histogram summed over all snapshots
+    std::vector<uint64_t> occupancy;
+    for (auto &snapshot: snapshots) {
+        candidates += static_cast<double>(snapshot.candidatePairs);
+        withinCutOff += static_cast<double>(snapshot.pairsWithinCutOff);
+        verlet += static_cast<double>(snapshot.verletPairs);
+        emptyCells += snapshot.emptyCellFraction();
+        particlesPerCell += snapshot.meanOccupancy();
+        if (occupancy.size() < snapshot.occupancy.size()) {
+            occupancy.resize(snapshot.occupancy.size(), 0);
+        }
+        for (size_t n = 0; n < snapshot.occupancy.size(); n++) {
+            occupancy[n] += snapshot.occupancy[n];
+        }
+    }
+    uint64_t cells = 0;
+    for (uint64_t count: occupancy) {
+        cells += count;
+    }
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << "Pair statistics over " << snapshots.size() << " samples (iterations " << iterations.front() << " to "
+            << iterations.back() << "), means per sample:\n" << std::fixed << std::setprecision(1);
+    out << std::left << std::setw(24) << "candidate pairs" << std::right << std::setw(16) << candidates / numberSamples
+            << "\n";
+    out << std::left << std::setw(24) << "pairs within cut-off" << std::right << std::setw(16)
+            << withinCutOff / numberSamples << " (" << 100 * (candidates > 0 ? withinCutOff / candidates : 0)
+            << "% of the candidates)\n";
+    if (verlet > 0) {
+        out << std::left << std::setw(24) << "pairs in Verlet lists" << std::right << std::setw(16)
+                << verlet / numberSamples << " (" << 100 * withinCutOff / verlet << "% within cut-off)\n";
+    }
+    out << std::left << std::setw(24) << "particles per cell" << std::right << std::setw(16) << std::setprecision(2)
+            << particlesPerCell / numberSamples << " (max " << (occupancy.empty() ? 0 : occupancy.size() - 1) << ")\n";
+    out << std::left << std::setw(24) << "empty cells" << std::right << std::setw(15) << std::setprecision(1)
+            << 100 * emptyCells / numberSamples << "%\n";
+    out << "Share of cells per number of particles:";
+    int column = 0;
+    for (size_t n = 0; n < occupancy.size(); n++) {
+        if (occupancy[n] == 0) {
+            continue;
+        }
+        out << (column++ % 8 == 0 ? "\n  " : "  ") << std::setw(4) << n << ":" << std::setw(6)
+                << 100 * share(occupancy[n], cells) << "%";
+    }
+    out << "\n";
+    //The snapshots hold the number of particles migrated since the container has been created
+    const uint64_t migrated = snapshots.back().totalMigratedParticles - snapshots.front().totalMigratedParticles;
+    const int steps = iterations.back() - iterations.front();
+    out << std::left << std::setw(24) << "migrated particles" << std::right << std::setw(16) << migrated << " ("
+            << std::setprecision(1) << (steps > 0 ? static_cast<double>(migrated) / steps : 0) << " per step)\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void PairStatisticsRecorder::writeCSV(const std::string &path) const {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot write the pair statistics to " + path);
+    }
+    file << "iteration,candidatePairs,pairsWithinCutOff,hitRate,verletPairs,cells,emptyCellFraction,meanOccupancy,"
+            "maxOccupancy,migratedParticles\n" << std::setprecision(6);
+    for (size_t i = 0; i < snapshots.size(); i++) {
+        const PairStatistics &snapshot = snapshots[i];
+        file << iterations[i] << "," << snapshot.candidatePairs << "," << snapshot.pairsWithinCutOff << ","
+                << snapshot.hitRate() << "," << snapshot.verletPairs << "," << snapshot.cells() << ","
+                << snapshot.emptyCellFraction() << "," << snapshot.meanOccupancy() << ","
+                << (snapshot.occupancy.empty() ? 0 : snapshot.occupancy.size() - 1) << ","
+                << snapshot.migratedParticles << "\n";
+    }
+    if (!file) {
+        throw std::runtime_error("Cannot write the pair statistics to " + path);
+    }
+}
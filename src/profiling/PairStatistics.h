@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Snapshot of the efficiency of the linked cells traversal.
+ *
+ * The candidate pairs are all pairs whose distance the cell traversal tests, i.e. the pairs within each domain cell and
+ * between each domain cell and the neighbours of its half shell. Only the pairs within the cut-off radius interact, so
+ * their share tells how much of the traversal is wasted, e.g. because the cells are too large.
+ */
+struct PairStatistics {
+    //Pairs of particles tested by the cell traversal
+    uint64_t candidatePairs = 0;
+    //Pairs of particles within the cut-off radius
+    uint64_t pairsWithinCutOff = 0;
+    //Pairs stored in the Verlet lists, 0 if no Verlet lists are used
+    uint64_t verletPairs = 0;
+    //Number of domain cells holding a given number of particles (indexed by the number of particles)
+    std::vector<uint64_t> occupancy;
+    //Particles moved to another cell by the last cell update
+    uint64_t migratedParticles = 0;
+    //Particles moved to another cell by all cell updates since the container has been created
+    uint64_t totalMigratedParticles = 0;
+
+    /**
+     * @brief Get the number of domain cells.
+     *
+     * @return Number of domain cells.
+     */
+    [[nodiscard]] uint64_t cells() const;
+
+    /**
+     * @brief Get the share of the domain cells without any particle.
+     *
+     * @return Fraction between 0 and 1, 0 if there are no cells.
+     */
+    [[nodiscard]] double emptyCellFraction() const;
+
+    /**
+     * @brief Get the mean number of particles per domain cell.
+     *
+     * @return Mean number of particles, 0 if there are no cells.
+     */
+    [[nodiscard]] double meanOccupancy() const;
+
+    /**
+     * @brief Get the share of the candidate pairs that are within the cut-off radius.
+     *
+     * @return Fraction between 0 and 1, 0 if there are no candidate pairs.
+     */
+    [[nodiscard]] double hitRate() const;
+};
+
+/**
+ * @brief Collects snapshots of the pair statistics during a run and reports them per run and per sampled step.
+ */
+class PairStatisticsRecorder {
+public:
+    /**
+     * @brief Store a snapshot.
+     *
+     * @param iteration Iteration at which the snapshot has been taken.
+     * @param statistics Snapshot.
+     */
+    void add(int iteration, const PairStatistics &statistics);
+
+    /**
+     * @brief Discard all snapshots.
+     */
+    void reset();
+
+    [[nodiscard]] size_t samples() const {
+        return snapshots.size();
+    }
+
+    [[nodiscard]] const PairStatistics &sample(size_t index) const {
+        return snapshots[index];
+    }
+
+    /**
+     * @brief Print the means over all snapshots, the histogram of the particles per cell and the number of migrated
+     *        particles of the run.
+     *
+     * @param out Stream to print to.
+     */
+    void printReport(std::ostream &out) const;
+
+    /**
+     * @brief Write one row per snapshot to a csv file.
+     *
+     * @param path Path of the csv file.
+     *
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void writeCSV(const std::string &path) const;
+
+private:
+    std::vector<int> iterations;
+    std::vector<PairStatistics> snapshots;
+};
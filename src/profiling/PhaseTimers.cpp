@@ -0,0 +1,161 @@
+#include "PhaseTimers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+    /**
+     * @brief Get the value below which a given fraction of the sorted values lies (nearest rank).
+     *
+     * @param sorted Values in ascending order, not empty.
+     * @param fraction Fraction between 0 and 1.
+     *
+     * @return Percentile.
+     */
+    int64_t percentile(const std::vector<int64_t> &sorted, double fraction) {
+        auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    double toMilliseconds(double nanoseconds) {
+        return nanoseconds / 1e6;
+    }
+}
+
+PhaseTimers &PhaseTimers::global() {
+    static PhaseTimers timers;
+    return timers;
+}
+
+const char *PhaseTimers::name(Phase phase) {
+    switch (phase) {
+        case Phase::forces:
+            return "forces";
+        case Phase::gravity:
+            return "gravity";
+        case Phase::boundaries:
+            return "boundaries";
+        case Phase::velocities:
+            return "velocities";
+        case Phase::positions:
+            return "positions";
+        case Phase::cells:
+            return "cells";
+        case Phase::halo:
+            return "halo";
+        case Phase::migration:
+            return "migration";
+        case Phase::sorting:
+            return "sorting";
+        case Phase::thermostat:
+            return "thermostat";
+        case Phase::output:
+            return "output";
+    }
+    return "invalid";
+}
+
+void PhaseTimers::addCounts(Phase phase, const HardwareCounters::Values &counts) {
+    auto &totals = counterTotals[static_cast<size_t>(phase)];
+    for (size_t event = 0; event < HardwareCounters::numberOfEvents; event++) {
+        totals[event] += counts[event];
+    }
+}
+
+int64_t PhaseTimers::total(Phase phase) const {
+    int64_t sum = 0;
+    for (size_t step = 0; step < steps(); step++) {
+        sum += sample(step, phase);
+    }
+    return sum;
+}
+
+void PhaseTimers::endStep(int iteration) {
+    iterations.push_back(iteration);
+    samples.insert(samples.end(), current.begin(), current.end());
+    current.fill(0);
+}
+
+void PhaseTimers::reset() {
+    current.fill(0);
+    iterations.clear();
+    samples.clear();
+    counterTotals = {};
+}
+
+void PhaseTimers::printReport(std::ostream &out) const {
+    if (iterations.empty()) {
+        return;
+    }
+    const size_t numberSteps = steps();
+    std::vector<int64_t> stepTotals(numberSteps, 0);
+    for (size_t step = 0; step < numberSteps; step++) {
+        for (size_t phase = 0; phase < numberOfPhases; phase++) {
+            stepTotals[step] += samples[step * numberOfPhases + phase];
+        }
+    }
+    int64_t total = 0;
+    for (int64_t stepTotal: stepTotals) {
+        total += stepTotal;
+    }
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << "Time per phase over " << numberSteps << " steps (per step in ms):\n";
+    out << std::left << std::setw(12) << "phase" << std::right << std::setw(12) << "total [s]" << std::setw(8) << "share"
+            << std::setw(12) << "mean" << std::setw(12) << "p50" << std::setw(12) << "p99" << "\n";
+    out << std::fixed;
+    auto printRow = [&](const std::string &name, std::vector<int64_t> values) {
+        int64_t sum = 0;
+        for (int64_t value: values) {
+            sum += value;
+        }
+        std::sort(values.begin(), values.end());
+        out << std::left << std::setw(12) << name << std::right << std::setprecision(3) << std::setw(12)
+                << static_cast<double>(sum) / 1e9 << std::setprecision(1) << std::setw(7)
+                << (total > 0 ? 100.0 * static_cast<double>(sum) / static_cast<double>(total) : 0) << "%"
+                << std::setprecision(4) << std::setw(12)
+                << toMilliseconds(static_cast<double>(sum) / static_cast<double>(numberSteps)) << std::setw(12)
+                << toMilliseconds(static_cast<double>(percentile(values, 0.5))) << std::setw(12)
+                << toMilliseconds(static_cast<double>(percentile(values, 0.99))) << "\n";
+    };
+    std::vector<int64_t> values(numberSteps);
+    for (size_t phase = 0; phase < numberOfPhases; phase++) {
+        bool occurred = false;
+        for (size_t step = 0; step < numberSteps; step++) {
+            values[step] = samples[step * numberOfPhases + phase];
+            occurred = occurred || values[step] > 0;
+        }
+        if (occurred) {
+            printRow(name(static_cast<Phase>(phase)), values);
+        }
+    }
+    printRow("step", stepTotals);
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void PhaseTimers::writeCSV(const std::string &path) const {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot write the phase times to " + path);
+    }
+    file << "iteration";
+    for (size_t phase = 0; phase < numberOfPhases; phase++) {
+        file << "," << name(static_cast<Phase>(phase));
+    }
+    file << "\n" << std::setprecision(9);
+    for (size_t step = 0; step < steps(); step++) {
+        file << iterations[step];
+        for (size_t phase = 0; phase < numberOfPhases; phase++) {
+            file << "," << static_cast<double>(samples[step * numberOfPhases + phase]) / 1e9;
+        }
+        file << "\n";
+    }
+    if (!file) {
+        throw std::runtime_error("Cannot write the phase times to " + path);
+    }
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "HardwareCounters.h"
+#include "Tracer.h"
+
+/**
+ * @brief Phases of a simulation step, which are timed separately.
+ */
+enum class Phase {
+    forces, gravity, boundaries, velocities, positions, cells, halo, migration, sorting, thermostat, output
+};
+
+/**
+ * @brief Collects the wall-clock time spent in each phase of every simulation step.
+ *
+ * The phases are timed with ScopedPhaseTimer, usually through the PHASE_TIMER macro. It only creates a timer if MolSim
+ * is built with MOLSIM_WITH_PHASE_TIMERS or MOLSIM_WITH_TRACING, so the timers cost nothing otherwise. The times of a
+ * phase are summed until endStep() is called, which stores them as one sample per phase. At the end of a run, the
+ * samples can be printed as a table and written to a csv file. While the global HardwareCounters are open, the timers
+ * also sum the hardware events of each phase over all steps.
+ */
+class PhaseTimers {
+public:
+    static constexpr size_t numberOfPhases = static_cast<size_t>(Phase::output) + 1;
+
+    /**
+     * @brief Get the timers shared by the whole program.
+     *
+     * @return Global timers.
+     */
+    static PhaseTimers &global();
+
+    /**
+     * @brief Get the name of a phase.
+     *
+     * @param phase Phase.
+     *
+     * @return Name of the phase, as used in the table and the csv file.
+     */
+    static const char *name(Phase phase);
+
+    /**
+     * @brief Add time to a phase of the current step.
+     *
+     * @param phase Phase.
+     * @param duration Time spent in the phase.
+     */
+    void add(Phase phase, std::chrono::steady_clock::duration duration) {
+        current[static_cast<size_t>(phase)] += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    }
+
+    /**
+     * @brief Add hardware events to a phase.
+     *
+     * @param phase Phase.
+     * @param counts Events counted during the phase.
+     */
+    void addCounts(Phase phase, const HardwareCounters::Values &counts);
+
+    /**
+     * @brief Get the hardware events counted in a phase since the last reset().
+     *
+     * @param phase Phase.
+     *
+     * @return Events of all steps.
+     */
+    [[nodiscard]] const HardwareCounters::Values &counts(Phase phase) const {
+        return counterTotals[static_cast<size_t>(phase)];
+    }
+
+    /**
+     * @brief Get the time spent in a phase during all finished steps.
+     *
+     * @param phase Phase.
+     *
+     * @return Time in nanoseconds.
+     */
+    [[nodiscard]] int64_t total(Phase phase) const;
+
+    /**
+     * @brief Finish the current step and store its times.
+     *
+     * @param iteration Iteration of the finished step.
+     */
+    void endStep(int iteration);
+
+    /**
+     * @brief Discard all samples and the times of the current step.
+     */
+    void reset();
+
+    /**
+     * @brief Get the number of finished steps.
+     *
+     * @return Number of steps.
+     */
+    [[nodiscard]] size_t steps() const {
+        return iterations.size();
+    }
+
+    /**
+     * @brief Get the time spent in a phase during a finished step.
+     *
+     * @param step Index of the step, counting from the first step after the last reset().
+     * @param phase Phase.
+     *
+     * @return Time in nanoseconds.
+     */
+    [[nodiscard]] int64_t sample(size_t step, Phase phase) const {
+        return samples[step * numberOfPhases + static_cast<size_t>(phase)];
+    }
+
+    /**
+     * @brief Print the total time of each phase and its mean, median and 99th percentile per step.
+     *
+     * Phases which did not occur are omitted. The last row sums all phases.
+     *
+     * @param out Stream to print to.
+     */
+    void printReport(std::ostream &out) const;
+
+    /**
+     * @brief Write the time of each phase of every step to a csv file.
+     *
+     * @param path Path of the csv file. There is one row per step and one column per phase, in seconds.
+     *
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void writeCSV(const std::string &path) const;
+
+private:
+    //Nanoseconds spent in each phase of the current step
+    std::array<int64_t, numberOfPhases> current{};
+    //Iterations of all finished steps
+    std::vector<int> iterations;
+    //Nanoseconds spent in each phase of all finished steps, step after step
+    std::vector<int64_t> samples;
+    //Hardware events of each phase, summed over all steps
+    std::array<HardwareCounters::Values, numberOfPhases> counterTotals{};
+};
+
+/**
+ * @brief Measures the time from its construction to its destruction and adds it to a phase of the global timers.
+ *
+ * If the global HardwareCounters are open, the events counted in between are added as well. If the global Tracer is
+ * enabled, the phase is recorded as a span.
+ */
+class ScopedPhaseTimer {
+public:
+    explicit ScopedPhaseTimer(Phase phase) : phase{phase}, counting{HardwareCounters::global().isOpen()} {
+        if (counting) {
+            startCounts = HardwareCounters::global().read();
+        }
+        start = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedPhaseTimer() {
+        const auto end = std::chrono::steady_clock::now();
+        PhaseTimers::global().add(phase, end - start);
+        if (Tracer::global().isEnabled()) {
+            Tracer::global().record(PhaseTimers::name(phase), start, end);
+        }
+        if (counting) {
+            PhaseTimers::global().addCounts(phase, HardwareCounters::global().read() - startCounts);
+        }
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer &) = delete;
+
+    ScopedPhaseTimer &operator=(const ScopedPhaseTimer &) = delete;
+
+private:
+    Phase phase;
+    bool counting;
+    HardwareCounters::Values startCounts{};
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Time the rest of the enclosing scope as the given phase, if MolSim is built with MOLSIM_WITH_PHASE_TIMERS or
+ * MOLSIM_WITH_TRACING.
+ */
+#if defined(MOLSIM_WITH_PHASE_TIMERS) || defined(MOLSIM_WITH_TRACING)
+#define PHASE_TIMER(phase) ScopedPhaseTimer MOLSIM_CONCATENATE(phaseTimer, __LINE__){phase}
+#else
+#define PHASE_TIMER(phase) static_cast<void>(0)
+#endif
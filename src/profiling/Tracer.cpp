@@ -0,0 +1,110 @@
+#include "Tracer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <stdexcept>
+
+namespace {
+    std::atomic<uint32_t> numberOfThreads{0};
+
+    /**
+     * @brief Write a string as JSON string literal.
+     *
+     * @param out Stream to write to.
+     * @param text String to write.
+     */
+    void writeString(std::ostream &out, const char *text) {
+        out << '"';
+        for (const char *c = text; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') {
+                out << '\\';
+            }
+            out << *c;
+        }
+        out << '"';
+    }
+}
+
+Tracer &Tracer::global() {
+    static Tracer tracer;
+    return tracer;
+}
+
+uint32_t Tracer::threadNumber() {
+    thread_local const uint32_t number = numberOfThreads.fetch_add(1);
+    return number;
+}
+
+void Tracer::enable(size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("The capacity of the trace has to be at least 1.");
+    }
+    disable();
+    buffer.assign(capacity, {});
+    next = 0;
+    //The thread enabling the tracer is shown as main thread
+    mainThread = threadNumber();
+    origin = std::chrono::steady_clock::now();
+    enabled = true;
+}
+
+void Tracer::disable() {
+    enabled = false;
+}
+
+void Tracer::record(const char *name, std::chrono::steady_clock::time_point begin,
+                    std::chrono::steady_clock::time_point end) {
+    const uint64_t index = next.fetch_add(1, std::memory_order_relaxed);
+    buffer[index % buffer.size()] = {
+        name, std::chrono::duration_cast<std::chrono::nanoseconds>(begin - origin).count(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count(), threadNumber()
+    };
+}
+
+std::vector<Tracer::Span> Tracer::spans() const {
+    const uint64_t recorded = next.load();
+    const uint64_t kept = std::min<uint64_t>(recorded, buffer.size());
+    std::vector<Span> result;
+    result.reserve(kept);
+    for (uint64_t i = recorded - kept; i < recorded; i++) {
+        result.push_back(buffer[i % buffer.size()]);
+    }
+    return result;
+}
+
+uint64_t Tracer::dropped() const {
+    const uint64_t recorded = next.load();
+    return recorded > buffer.size() ? recorded - buffer.size() : 0;
+}
+
+void Tracer::writeJSON(const std::string &path, int process) const {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot write the trace to " + path);
+    }
+    std::set<uint32_t> threads;
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" << std::fixed << std::setprecision(3);
+    bool first = true;
+    for (const Span &span: spans()) {
+        threads.insert(span.thread);
+        file << (first ? "" : ",\n") << "{\"name\":";
+        writeString(file, span.name);
+        //Complete events with begin and duration in microseconds
+        file << ",\"cat\":\"MolSim\",\"ph\":\"X\",\"ts\":" << static_cast<double>(span.begin) / 1e3 << ",\"dur\":"
+                << static_cast<double>(span.duration) / 1e3 << ",\"pid\":" << process << ",\"tid\":" << span.thread
+                << "}";
+        first = false;
+    }
+    for (uint32_t thread: threads) {
+        file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << process << ",\"tid\":"
+                << thread << ",\"args\":{\"name\":\""
+                << (thread == mainThread ? std::string("main") : "thread " + std::to_string(thread)) << "\"}}";
+        first = false;
+    }
+    file << "\n]}\n";
+    if (!file) {
+        throw std::runtime_error("Cannot write the trace to " + path);
+    }
+}
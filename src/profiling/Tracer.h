@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Records the begin and end of named spans on all threads and exports them in the Chrome trace-event format,
+ *        which can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *
+ * The spans are stored in a ring buffer of fixed capacity, so a long run keeps only its most recent spans and the
+ * memory needed for tracing is bounded. Spans are recorded by ScopedTraceSpan, usually through the TRACE_SPAN macro,
+ * and by the phase timers (see PhaseTimers.h). Both only exist if MolSim is built with MOLSIM_WITH_TRACING and do
+ * nothing until the tracer is enabled.
+ */
+class Tracer {
+public:
+    /**
+     * @brief Span of one thread.
+     */
+    struct Span {
+        //Name of the span, has to outlive the tracer (e.g. a string literal)
+        const char *name;
+        //Begin and duration in nanoseconds since the tracer has been enabled
+        int64_t begin;
+        int64_t duration;
+        //Number of the thread that recorded the span (see threadNumber())
+        uint32_t thread;
+    };
+
+    /**
+     * @brief Get the tracer shared by the whole program.
+     *
+     * @return Global tracer.
+     */
+    static Tracer &global();
+
+    /**
+     * @brief Get a number identifying the calling thread in the trace.
+     *
+     * @return Number of the calling thread.
+     */
+    static uint32_t threadNumber();
+
+    /**
+     * @brief Discard all recorded spans and start recording.
+     *
+     * @param capacity Maximal number of spans kept. If more spans are recorded, the oldest ones are overwritten.
+     *
+     * @throws std::invalid_argument If the capacity is 0.
+     */
+    void enable(size_t capacity);
+
+    /**
+     * @brief Stop recording. The recorded spans are kept.
+     */
+    void disable();
+
+    [[nodiscard]] bool isEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record a span of the calling thread. Thread-safe.
+     *
+     * @param name Name of the span, has to outlive the tracer (e.g. a string literal).
+     * @param begin Begin of the span.
+     * @param end End of the span.
+     */
+    void record(const char *name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+
+    /**
+     * @brief Get the spans kept in the ring buffer, from the oldest to the most recent one.
+     *
+     * Must not be called while other threads record spans.
+     *
+     * @return Recorded spans.
+     */
+    [[nodiscard]] std::vector<Span> spans() const;
+
+    /**
+     * @brief Get the number of spans which have been overwritten, because the ring buffer was full.
+     *
+     * @return Number of dropped spans.
+     */
+    [[nodiscard]] uint64_t dropped() const;
+
+    /**
+     * @brief Write all spans kept in the ring buffer as Chrome trace-event JSON.
+     *
+     * Must not be called while other threads record spans.
+     *
+     * @param path Path of the JSON file.
+     * @param process Id of the process in the trace, e.g. the MPI rank.
+     *
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void writeJSON(const std::string &path, int process = 0) const;
+
+private:
+    std::atomic<bool> enabled{false};
+    std::chrono::steady_clock::time_point origin;
+    std::vector<Span> buffer;
+    //Number of spans recorded since enable(). The next span is stored at next % buffer.size().
+    std::atomic<uint64_t> next{0};
+    //Number of the thread that enabled the tracer
+    uint32_t mainThread = 0;
+};
+
+/**
+ * @brief Records a span from its construction to its destruction, if the global tracer is enabled.
+ */
+class ScopedTraceSpan {
+public:
+    explicit ScopedTraceSpan(const char *name) : name{name}, active{Tracer::global().isEnabled()} {
+        if (active) {
+            begin = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedTraceSpan() {
+        if (active) {
+            Tracer::global().record(name, begin, std::chrono::steady_clock::now());
+        }
+    }
+
+    ScopedTraceSpan(const ScopedTraceSpan &) = delete;
+
+    ScopedTraceSpan &operator=(const ScopedTraceSpan &) = delete;
+
+private:
+    const char *name;
+    bool active;
+    std::chrono::steady_clock::time_point begin;
+};
+
+#define MOLSIM_CONCATENATE_DETAIL(a, b) a##b
+#define MOLSIM_CONCATENATE(a, b) MOLSIM_CONCATENATE_DETAIL(a, b)
+
+/**
+ * Record the rest of the enclosing scope as a span of the calling thread, if MolSim is built with MOLSIM_WITH_TRACING.
+ */
+#ifdef MOLSIM_WITH_TRACING
+#define TRACE_SPAN(name) ScopedTraceSpan MOLSIM_CONCATENATE(traceSpan, __LINE__){name}
+#else
+#define TRACE_SPAN(name) static_cast<void>(0)
+#endif
@@ -170,6 +170,18 @@ template <class Container> auto L2Norm(const Container &c) {
   return std::sqrt(std::accumulate(std::cbegin(c), std::cend(c), 0.0,
                                    [](auto a, auto b) { return a + b * b; }));
 }
+
+/**
+ * Calculates the squared L2 norm for a given container, e.g. to compare a
+ * distance against a radius without taking a square root.
+ * @tparam Container
+ * @param c
+ * @return sum_i(c[i]*c[i]).
+ */
+template <class Container> auto L2NormSquared(const Container &c) {
+  return std::accumulate(std::cbegin(c), std::cend(c), 0.0,
+                         [](auto a, auto b) { return a + b * b; });
+}
 } // namespace ArrayUtils
 
 
@@ -4,20 +4,55 @@
 #pragma once
 
 #include <iostream>
+#include "profiling/HardwareCounters.h"
+#include "profiling/PhaseTimers.h"
 #include "utils/Logging.h"
 
+/**
+ * @brief Print the hardware events counted during a run, per phase if MolSim is built with MOLSIM_WITH_PHASE_TIMERS.
+ *
+ * @param simulator Simulator that has performed the run.
+ * @param total Events of the whole run.
+ * @param seconds Duration of the run in seconds.
+ */
+inline void printHardwareCounters(Simulator &simulator, const HardwareCounters::Values &total, double seconds) {
+    std::vector<HardwareCounters::Row> rows;
+#ifdef MOLSIM_WITH_PHASE_TIMERS
+    for (size_t phase = 0; phase < PhaseTimers::numberOfPhases; phase++) {
+        const int64_t nanoseconds = PhaseTimers::global().total(static_cast<Phase>(phase));
+        if (nanoseconds > 0) {
+            rows.push_back({PhaseTimers::name(static_cast<Phase>(phase)), static_cast<double>(nanoseconds) / 1e9,
+                            PhaseTimers::global().counts(static_cast<Phase>(phase))});
+        }
+    }
+#endif
+    rows.push_back({"run", seconds, total});
+    //The pairs are counted in the final state and assumed to be the same in every step
+    const double pairInteractions = static_cast<double>(simulator.countPairInteractions()) *
+                                    simulator.getStepsOfLastRun();
+    HardwareCounters::global().printReport(std::cout, rows, pairInteractions);
+}
+
 /**
  * @brief Measure the execution time of the simulation
  *
  * @param simulator Simulator on which the simulation will run
+ * @param hardwareCounters Additionally count hardware events (cycles, instructions, cache and branch misses, floating
+ *                         point operations) with perf_event_open and print them with derived metrics.
  *
  * During the time measurement all output (logs and file output) is disabled
  */
-inline void performBenchmark(Simulator &simulator) {
+inline void performBenchmark(Simulator &simulator, bool hardwareCounters = false) {
     spdlog::set_level(spdlog::level::off);
+    auto &counters = HardwareCounters::global();
+    if (hardwareCounters && !counters.open()) {
+        std::cout << "Hardware counters are not available, only the time is measured.\n";
+    }
+    HardwareCounters::Values countsStart = counters.read();
     auto tStart = std::chrono::steady_clock::now();
     simulator.run(true);
     auto tEnd = std::chrono::steady_clock::now();
+    HardwareCounters::Values counts = counters.read() - countsStart;
     std::chrono::nanoseconds duration_ns{tEnd - tStart};
     double duration_s = static_cast<double>(duration_ns.count()) / 1e9;
     long duration_min = duration_ns.count() / 60000000000;
@@ -26,4 +61,8 @@ inline void performBenchmark(Simulator &simulator) {
             << duration_s << " sec | " << duration_ns.count() << " ns.\n";
     std::cout << "Molecule updates per second: " << static_cast<double>(simulator.getTotalMoleculeUpdates()) / duration_s << "\n";
 
+    if (counters.isOpen()) {
+        printHardwareCounters(simulator, counts, duration_s);
+        counters.close();
+    }
 }
@@ -10,6 +10,19 @@
 #include <random>
 #include <array>
 
+/**
+ * Get the random engine used to generate the Brownian Motion. Its state is stored in checkpoints, so that a resumed
+ * simulation draws the same random numbers as an uninterrupted one.
+ *
+ * @return Random engine of the Maxwell-Boltzmann distribution.
+ */
+inline std::default_random_engine &maxwellBoltzmannRandomEngine() {
+    // we use a constant seed for repeatability.
+    // random engine needs static lifetime otherwise it would be recreated for every call.
+    static std::default_random_engine randomEngine(42);
+    return randomEngine;
+}
+
 /**
  * Generate a random velocity vector according to the Maxwell-Boltzmann distribution, with a given average velocity.
  *
@@ -18,9 +31,7 @@
  * @return Array containing the generated velocity vector.
  */
 inline std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions) {
-    // we use a constant seed for repeatability.
-    // random engine needs static lifetime otherwise it would be recreated for every call.
-    static std::default_random_engine randomEngine(42);
+    std::default_random_engine &randomEngine = maxwellBoltzmannRandomEngine();
     // when adding independent normally distributed values to all velocity components
     // the velocity change is maxwell boltzmann distributed
     std::normal_distribution<double> normalDistribution{0, 1};
@@ -11,15 +11,60 @@
  *
  * @param OutputFormat String containing the file format
  * @return FileHandler::outputFormat::vtk, if the file format is vtk,
+ * FileHandler::outputFormat::vtu, if the file format is vtu,
+ * FileHandler::outputFormat::pvtu, if the file format is pvtu,
+ * FileHandler::outputFormat::traj, if the file format is traj,
  * FileHandler::outputFormat::xyz, if the file format is xyz,
  * FileHandler::outputFormat::invalid, if the file format is none of the above.
  */
 inline FileHandler::outputFormat setOutputFormat(const std::string &OutputFormat) {
     static const std::unordered_map<std::string, FileHandler::outputFormat> formatMap = {
             {"vtk", FileHandler::outputFormat::vtk},
+            {"vtu", FileHandler::outputFormat::vtu},
+            {"pvtu", FileHandler::outputFormat::pvtu},
+            {"traj", FileHandler::outputFormat::traj},
             {"xyz", FileHandler::outputFormat::xyz}
     };
 
     auto it = formatMap.find(OutputFormat);
     return (it != formatMap.end()) ? it->second : FileHandler::outputFormat::invalid;
 }
+
+/**
+ * @brief Sets the format of the checkpoint which is specified in the string.
+ *
+ * @param StateFormat String containing the checkpoint format
+ * @return FileHandler::stateFormat::binary, if the format is binary,
+ * FileHandler::stateFormat::txt, if the format is txt,
+ * FileHandler::stateFormat::invalid, if the format is none of the above.
+ */
+inline FileHandler::stateFormat setStateFormat(const std::string &StateFormat) {
+    static const std::unordered_map<std::string, FileHandler::stateFormat> formatMap = {
+            {"binary", FileHandler::stateFormat::binary},
+            {"txt", FileHandler::stateFormat::txt}
+    };
+
+    auto it = formatMap.find(StateFormat);
+    return (it != formatMap.end()) ? it->second : FileHandler::stateFormat::invalid;
+}
+
+/**
+ * @brief Sets the precision of the vtu output which is specified in the string.
+ *
+ * @param Precision String containing the precision
+ * @param precision Set to the selected precision, if the string is valid
+ * @return True, if the precision is float32 or float64, false otherwise.
+ */
+inline bool setVTUPrecision(const std::string &Precision, outputWriter::VTUWriter::Precision &precision) {
+    static const std::unordered_map<std::string, outputWriter::VTUWriter::Precision> precisionMap = {
+            {"float32", outputWriter::VTUWriter::Precision::float32},
+            {"float64", outputWriter::VTUWriter::Precision::float64}
+    };
+
+    auto it = precisionMap.find(Precision);
+    if (it == precisionMap.end()) {
+        return false;
+    }
+    precision = it->second;
+    return true;
+}
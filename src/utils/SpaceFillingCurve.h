@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Keys of grid coordinates along space-filling curves.
+ *
+ * Sorting grid points by their key orders them along the curve, so that points which are close in space are mostly
+ * close in the order as well. Both curves work on grids with up to 2^21 points per dimension.
+ */
+namespace SpaceFillingCurve {
+    /**
+     * @brief Calculate the number of bits needed to represent all coordinates below a given extent.
+     *
+     * @param extent Number of grid points in the largest dimension.
+     *
+     * @return Number of bits, at least 1.
+     */
+    inline int bitsFor(uint32_t extent) {
+        int bits = 1;
+        while (bits < 21 && (1u << bits) < extent) {
+            bits++;
+        }
+        return bits;
+    }
+
+    /**
+     * @brief Calculate the position of a grid point along the Morton (Z-order) curve.
+     *
+     * @param coordinates Coordinates of the grid point.
+     * @param bits Number of bits per coordinate (see bitsFor()).
+     *
+     * @return Key obtained by interleaving the bits of the coordinates.
+     */
+    inline uint64_t mortonKey(const std::array<uint32_t, 3> &coordinates, int bits) {
+        uint64_t key = 0;
+        for (int bit = bits - 1; bit >= 0; bit--) {
+            for (int dim = 2; dim >= 0; dim--) {
+                key = (key << 1) | ((coordinates[dim] >> bit) & 1u);
+            }
+        }
+        return key;
+    }
+
+    /**
+     * @brief Calculate the position of a grid point along the Hilbert curve.
+     *
+     * Consecutive points of the Hilbert curve are always adjacent in space, which is not the case for the Morton curve.
+     * The coordinates are transformed into the transposed Hilbert index with the algorithm of J. Skilling
+     * ("Programming the Hilbert curve", 2004), whose bits are then interleaved.
+     *
+     * @param coordinates Coordinates of the grid point.
+     * @param bits Number of bits per coordinate (see bitsFor()).
+     * @param dimensions Number of dimensions (2 or 3). In 2D the third coordinate is ignored.
+     *
+     * @return Key along the Hilbert curve.
+     */
+    inline uint64_t hilbertKey(std::array<uint32_t, 3> coordinates, int bits, int dimensions) {
+        const uint32_t highestBit = 1u << (bits - 1);
+        //Inverse undo
+        for (uint32_t q = highestBit; q > 1; q >>= 1) {
+            const uint32_t p = q - 1;
+            for (int dim = 0; dim < dimensions; dim++) {
+                if (coordinates[dim] & q) {
+                    coordinates[0] ^= p;
+                } else {
+                    const uint32_t t = (coordinates[0] ^ coordinates[dim]) & p;
+                    coordinates[0] ^= t;
+                    coordinates[dim] ^= t;
+                }
+            }
+        }
+        //Gray encode
+        for (int dim = 1; dim < dimensions; dim++) {
+            coordinates[dim] ^= coordinates[dim - 1];
+        }
+        uint32_t t = 0;
+        for (uint32_t q = highestBit; q > 1; q >>= 1) {
+            if (coordinates[dimensions - 1] & q) {
+                t ^= q - 1;
+            }
+        }
+        for (int dim = 0; dim < dimensions; dim++) {
+            coordinates[dim] ^= t;
+        }
+
+        uint64_t key = 0;
+        for (int bit = bits - 1; bit >= 0; bit--) {
+            for (int dim = 0; dim < dimensions; dim++) {
+                key = (key << 1) | ((coordinates[dim] >> bit) & 1u);
+            }
+        }
+        return key;
+    }
+}
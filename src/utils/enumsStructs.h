@@ -5,6 +5,9 @@
 #pragma once
 
 #include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace enumsStructs {
     /**
@@ -25,7 +28,7 @@ namespace enumsStructs {
      * Enum to specify the type of model used in the simulation.
      */
     enum class TypeOfModel {
-        directSum, linkedCells, invalid
+        directSum, linkedCells, barnesHut, invalid
     };
 
     /**
@@ -35,6 +38,27 @@ namespace enumsStructs {
         outflow, reflective, periodic, invalid
     };
 
+    /**
+     * Enum to specify the memory layout the particles are processed in during the force calculation.
+     */
+    enum class ParticleLayout {
+        aos, soa, invalid
+    };
+
+    /**
+     * Enum to specify how the force calculation is parallelised without data races when using Newton's third law of motion.
+     */
+    enum class ParallelStrategy {
+        coloring, forceBuffers, invalid
+    };
+
+    /**
+     * Enum to specify the order in which the cells of the linked cells container are numbered and stored.
+     */
+    enum class CellOrdering {
+        rowMajor, morton, hilbert, invalid
+    };
+
     struct BoundarySet {
         BoundaryCondition front = BoundaryCondition::invalid;
         BoundaryCondition right = BoundaryCondition::invalid;
@@ -51,6 +75,19 @@ namespace enumsStructs {
         double deltaT;
         double endT;
         TypeOfForce force;
+        //Number of threads used for the force calculation. If set to 1, the force calculation runs serially.
+        int threads = 1;
+    };
+
+    /**
+     * Struct for passing parameters of the Barnes-Hut model.
+     */
+    struct BarnesHutSimulationParameters {
+        double deltaT;
+        double endT;
+        TypeOfForce force;
+        //Opening angle. If set to 0, the forces are computed exactly.
+        double theta = 0.5;
     };
 
     /**
@@ -63,6 +100,15 @@ namespace enumsStructs {
         double rCutOff;
         std::array<double, 3> domainSize;
         BoundarySet boundaryConditions;
+        ParticleLayout particleLayout = ParticleLayout::aos;
+        //Skin radius of the Verlet lists. If set to 0, no Verlet lists are used.
+        double verletSkin = 0;
+        //Number of threads used for the force calculation. If set to 1, the force calculation runs serially.
+        int threads = 1;
+        ParallelStrategy parallelStrategy = ParallelStrategy::coloring;
+        CellOrdering cellOrdering = CellOrdering::rowMajor;
+        //Number of iterations between two re-sorts of the particle storage. If set to 0, it is never re-sorted.
+        int sortInterval = 0;
     };
 
     /**
@@ -157,6 +203,9 @@ namespace enumsStructs {
         //Parameters for LinkedCellModel
         LinkedCellsSimulationParameters parametersLinkedCells;
 
+        //Parameters for BarnesHutModel
+        BarnesHutSimulationParameters parametersBarnesHut;
+
         //Particles and objects of particles
         std::vector<Cuboid> cuboids;
         std::vector<Disc> discs;
@@ -207,7 +256,8 @@ namespace enumsStructs {
     inline TypeOfModel setModel(const std::string &selectedModel) {
         static const std::unordered_map<std::string, TypeOfModel> formatMap = {
             {"DirectSum", TypeOfModel::directSum},
-            {"LinkedCells", TypeOfModel::linkedCells}
+            {"LinkedCells", TypeOfModel::linkedCells},
+            {"BarnesHut", TypeOfModel::barnesHut}
         };
 
         auto it = formatMap.find(selectedModel);
@@ -224,7 +274,8 @@ namespace enumsStructs {
     inline std::string getModel(TypeOfModel &model) {
         static const std::unordered_map<TypeOfModel, std::string> formatMap = {
             {TypeOfModel::directSum, "DirectSum"},
-            {TypeOfModel::linkedCells, "LinkedCells"}
+            {TypeOfModel::linkedCells, "LinkedCells"},
+            {TypeOfModel::barnesHut, "BarnesHut"}
         };
         auto it = formatMap.find(model);
         return (it != formatMap.end()) ? it->second : "Invalid";
@@ -263,4 +314,102 @@ namespace enumsStructs {
         auto it = formatMap.find(boundaryCondition);
         return (it != formatMap.end()) ? it->second : "Invalid";
     }
+
+    /**
+     * @brief Convert string selection to corresponding enum value.
+     *
+     * @param selectedParticleLayout String to convert.
+     *
+     * @return Corresponding enum value.
+     */
+    inline ParticleLayout setParticleLayout(const std::string &selectedParticleLayout) {
+        static const std::unordered_map<std::string, ParticleLayout> formatMap = {
+            {"AoS", ParticleLayout::aos},
+            {"SoA", ParticleLayout::soa}
+        };
+        auto it = formatMap.find(selectedParticleLayout);
+        return (it != formatMap.end()) ? it->second : ParticleLayout::invalid;
+    }
+
+    /**
+     * @brief Convert enum value to string.
+     *
+     * @param particleLayout Enum value to convert.
+     *
+     * @return Corresponding string.
+     */
+    inline std::string getParticleLayout(ParticleLayout &particleLayout) {
+        static const std::unordered_map<ParticleLayout, std::string> formatMap = {
+            {ParticleLayout::aos, "AoS"},
+            {ParticleLayout::soa, "SoA"}
+        };
+        auto it = formatMap.find(particleLayout);
+        return (it != formatMap.end()) ? it->second : "Invalid";
+    }
+
+    /**
+     * @brief Convert string selection to corresponding enum value.
+     *
+     * @param selectedParallelStrategy String to convert.
+     *
+     * @return Corresponding enum value.
+     */
+    inline ParallelStrategy setParallelStrategy(const std::string &selectedParallelStrategy) {
+        static const std::unordered_map<std::string, ParallelStrategy> formatMap = {
+            {"Coloring", ParallelStrategy::coloring},
+            {"ForceBuffers", ParallelStrategy::forceBuffers}
+        };
+        auto it = formatMap.find(selectedParallelStrategy);
+        return (it != formatMap.end()) ? it->second : ParallelStrategy::invalid;
+    }
+
+    /**
+     * @brief Convert enum value to string.
+     *
+     * @param parallelStrategy Enum value to convert.
+     *
+     * @return Corresponding string.
+     */
+    inline std::string getParallelStrategy(ParallelStrategy &parallelStrategy) {
+        static const std::unordered_map<ParallelStrategy, std::string> formatMap = {
+            {ParallelStrategy::coloring, "Coloring"},
+            {ParallelStrategy::forceBuffers, "ForceBuffers"}
+        };
+        auto it = formatMap.find(parallelStrategy);
+        return (it != formatMap.end()) ? it->second : "Invalid";
+    }
+
+    /**
+     * @brief Convert string selection to corresponding enum value.
+     *
+     * @param selectedCellOrdering String to convert.
+     *
+     * @return Corresponding enum value.
+     */
+    inline CellOrdering setCellOrdering(const std::string &selectedCellOrdering) {
+        static const std::unordered_map<std::string, CellOrdering> formatMap = {
+            {"RowMajor", CellOrdering::rowMajor},
+            {"Morton", CellOrdering::morton},
+            {"Hilbert", CellOrdering::hilbert}
+        };
+        auto it = formatMap.find(selectedCellOrdering);
+        return (it != formatMap.end()) ? it->second : CellOrdering::invalid;
+    }
+
+    /**
+     * @brief Convert enum value to string.
+     *
+     * @param cellOrdering Enum value to convert.
+     *
+     * @return Corresponding string.
+     */
+    inline std::string getCellOrdering(CellOrdering &cellOrdering) {
+        static const std::unordered_map<CellOrdering, std::string> formatMap = {
+            {CellOrdering::rowMajor, "RowMajor"},
+            {CellOrdering::morton, "Morton"},
+            {CellOrdering::hilbert, "Hilbert"}
+        };
+        auto it = formatMap.find(cellOrdering);
+        return (it != formatMap.end()) ? it->second : "Invalid";
+    }
 }
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+
+#include "fileHandling/outputWriter/AsyncOutputWriter/AsyncOutputWriter.h"
+#include "particleRepresentation/container/defaultParticleContainer/DefaultParticleContainer.h"
+
+/**
+ * Each written frame has to contain the particles as they were when the frame was submitted, even if the particles
+ * are changed while the frame is still waiting to be written. After flush() all frames have to be on disk.
+ */
+
+TEST(AsyncOutputWriterTest, FramesContainSnapshotAtSubmission) {
+    std::string baseName = "AsyncOutputWriterTest";
+    DefaultParticleContainer dpc;
+    for (int i = 0; i < 100; i++) {
+        Particle p{{static_cast<double>(i), 0, 0}, {0, 0, 0}, 1};
+        dpc.add(p);
+    }
+
+    {
+        outputWriter::AsyncOutputWriter writer{FileHandler::outputFormat::xyz, 1};
+        for (int frame = 0; frame < 5; frame++) {
+            writer.submit(dpc, frame, baseName);
+            //Move all particles, the frame submitted before must not be affected
+            dpc.applyToEachParticle([](Particle &p) {
+                p.setX(p.getX() + std::array<double, 3>{0, 1, 0});
+            });
+        }
+        writer.flush();
+    }
+
+    for (int frame = 0; frame < 5; frame++) {
+        std::stringstream name;
+        name << baseName << "_000" << frame << ".xyz";
+        std::ifstream file(name.str());
+        ASSERT_TRUE(file.is_open()) << name.str();
+        size_t count;
+        file >> count;
+        EXPECT_EQ(count, 100);
+        std::string line;
+        std::getline(file, line);
+        std::getline(file, line);
+        int lines = 0;
+        std::string element;
+        double x, y, z;
+        while (file >> element >> x >> y >> z) {
+            EXPECT_DOUBLE_EQ(x, lines);
+            EXPECT_DOUBLE_EQ(y, frame);
+            lines++;
+        }
+        EXPECT_EQ(lines, 100);
+        file.close();
+        std::remove(name.str().c_str());
+    }
+}
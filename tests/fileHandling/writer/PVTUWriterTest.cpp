@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <regex>
+
+#include "fileHandling/outputWriter/PVTUWriter/PVTUWriter.h"
+#include "particleRepresentation/container/defaultParticleContainer/DefaultParticleContainer.h"
+
+/**
+ * Each frame has to be split into the requested number of pieces, which together contain every particle exactly once.
+ * The .pvtu file has to reference all pieces and the .pvd file has to list all frames with their simulation time.
+ */
+
+namespace {
+    std::string readFile(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    std::vector<std::string> findAll(const std::string &content, const std::string &expression) {
+        std::vector<std::string> matches;
+        std::regex regex(expression);
+        for (auto it = std::sregex_iterator(content.begin(), content.end(), regex); it != std::sregex_iterator(); ++it) {
+            matches.push_back((*it)[1]);
+        }
+        return matches;
+    }
+}
+
+TEST(PVTUWriterTest, PiecesAndTimeSeries) {
+    DefaultParticleContainer dpc;
+    for (int i = 0; i < 103; i++) {
+        Particle p{{static_cast<double>(i), 0, 0}, {0, 0, 0}, 1};
+        dpc.add(p);
+    }
+
+    outputWriter::PVTUWriter writer{4};
+    ASSERT_EQ(writer.getNumberOfPieces(), 4);
+    writer.plotParticles(dpc, "PVTUWriterTest", 0, 0);
+    writer.plotParticles(dpc, "PVTUWriterTest", 10, 0.25);
+
+    for (const std::string frame : {"PVTUWriterTest_0000", "PVTUWriterTest_0010"}) {
+        auto pieces = findAll(readFile(frame + ".pvtu"), "<Piece Source=\"([^\"]+)\"");
+        ASSERT_EQ(pieces.size(), 4);
+        size_t particles = 0;
+        for (size_t piece = 0; piece < pieces.size(); piece++) {
+            EXPECT_EQ(pieces[piece], frame + "_" + std::to_string(piece) + ".vtu");
+            auto points = findAll(readFile(pieces[piece]), "NumberOfPoints=\"(\\d+)\"");
+            ASSERT_EQ(points.size(), 1);
+            particles += std::stoul(points[0]);
+        }
+        EXPECT_EQ(particles, dpc.size());
+    }
+
+    auto collection = readFile("PVTUWriterTest.pvd");
+    EXPECT_EQ(findAll(collection, "file=\"([^\"]+)\""),
+              (std::vector<std::string>{"PVTUWriterTest_0000.pvtu", "PVTUWriterTest_0010.pvtu"}));
+    EXPECT_EQ(findAll(collection, "timestep=\"([^\"]+)\""), (std::vector<std::string>{"0", "0.25"}));
+}
+
+/**
+ * A writer resuming a time series has to keep the frames of the .pvd file before its first frame and replace the
+ * later ones, instead of starting an empty series.
+ */
+TEST(PVTUWriterTest, ResumedTimeSeries) {
+    DefaultParticleContainer dpc;
+    for (int i = 0; i < 10; i++) {
+        Particle p{{static_cast<double>(i), 0, 0}, {0, 0, 0}, 1};
+        dpc.add(p);
+    }
+    {
+        outputWriter::PVTUWriter writer{2};
+        for (int iteration = 0; iteration <= 30; iteration += 10) {
+            writer.plotParticles(dpc, "PVTUWriterResumeTest", iteration, 0.01 * iteration);
+        }
+    }
+    //Resume from a checkpoint at iteration 20, which is an output step as well
+    outputWriter::PVTUWriter writer{2};
+    writer.plotParticles(dpc, "PVTUWriterResumeTest", 20, 0.2);
+    writer.plotParticles(dpc, "PVTUWriterResumeTest", 30, 0.3);
+    writer.plotParticles(dpc, "PVTUWriterResumeTest", 40, 0.4);
+
+    auto collection = readFile("PVTUWriterResumeTest.pvd");
+    EXPECT_EQ(findAll(collection, "file=\"([^\"]+)\""),
+              (std::vector<std::string>{"PVTUWriterResumeTest_0000.pvtu", "PVTUWriterResumeTest_0010.pvtu",
+                                        "PVTUWriterResumeTest_0020.pvtu", "PVTUWriterResumeTest_0030.pvtu",
+                                        "PVTUWriterResumeTest_0040.pvtu"}));
+    EXPECT_EQ(collection.substr(collection.size() - 27), "  </Collection>\n</VTKFile>\n");
+
+    //A new series with the same name starting at time 0 replaces all frames
+    writer.resetSeries();
+    writer.plotParticles(dpc, "PVTUWriterResumeTest", 0, 0);
+    EXPECT_EQ(findAll(readFile("PVTUWriterResumeTest.pvd"), "file=\"([^\"]+)\""),
+              (std::vector<std::string>{"PVTUWriterResumeTest_0000.pvtu"}));
+}
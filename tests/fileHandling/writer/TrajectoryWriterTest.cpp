@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+#include "fileHandling/outputWriter/TrajectoryWriter/TrajectoryWriter.h"
+#include "fileHandling/reader/TrajectoryReader/TrajectoryReader.h"
+#include "particleRepresentation/container/defaultParticleContainer/DefaultParticleContainer.h"
+
+/**
+ * All frames have to be appended to one file and read back exactly, both via the index written on close and via
+ * scanning the frames, if the index is missing. A trajectory is continued behind its frames older than the first new
+ * frame and only replaced as a whole when a new trajectory is started explicitly.
+ */
+
+namespace {
+    DefaultParticleContainer createParticles(int n, double shift) {
+        DefaultParticleContainer dpc;
+        for (int i = 0; i < n; i++) {
+            double x = i + shift;
+            Particle p{{x, x / 3, -x}, {1 / (x + 1), 2, 3}, 1 + x, i % 3};
+            p.setF({x * x, 0.5, -1});
+            dpc.add(p);
+        }
+        return dpc;
+    }
+
+    void expectFrame(const TrajectoryReader &reader, size_t frame, int64_t iteration, int n, double shift) {
+        EXPECT_EQ(reader.getIteration(frame), iteration);
+        EXPECT_EQ(reader.getTime(frame), iteration * 0.01);
+        ASSERT_EQ(reader.getNumberOfParticles(frame), n);
+
+        DefaultParticleContainer expected = createParticles(n, shift);
+        DefaultParticleContainer actual;
+        reader.readFrame(frame, actual);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            EXPECT_EQ(actual.at(i).getX(), expected.at(i).getX());
+            EXPECT_EQ(actual.at(i).getV(), expected.at(i).getV());
+            EXPECT_EQ(actual.at(i).getF(), expected.at(i).getF());
+            EXPECT_EQ(actual.at(i).getM(), expected.at(i).getM());
+            EXPECT_EQ(actual.at(i).getType(), expected.at(i).getType());
+        }
+    }
+}
+
+TEST(TrajectoryWriterTest, AppendAndRandomAccess) {
+    const std::string baseName = "TrajectoryWriterTest";
+    const std::string path = baseName + ".traj";
+    std::filesystem::remove(path);
+
+    {
+        outputWriter::TrajectoryWriter writer;
+        for (int frame = 0; frame < 3; frame++) {
+            auto dpc = createParticles(10 + frame, frame);
+            writer.plotParticles(dpc, baseName, frame * 10, frame * 10 * 0.01);
+        }
+    }
+    {
+        TrajectoryReader reader(path);
+        ASSERT_EQ(reader.getNumberOfFrames(), 3);
+        //Random access in any order
+        expectFrame(reader, 2, 20, 12, 2);
+        expectFrame(reader, 0, 0, 10, 0);
+        DefaultParticleContainer missing;
+        EXPECT_THROW(reader.readFrame(3, missing), std::out_of_range);
+    }
+
+    //Frames with larger iterations continue the trajectory
+    {
+        outputWriter::TrajectoryWriter writer;
+        auto dpc = createParticles(5, 3);
+        writer.plotParticles(dpc, baseName, 30, 0.3);
+    }
+    uint64_t endOfFrames;
+    {
+        TrajectoryReader reader(path);
+        ASSERT_EQ(reader.getNumberOfFrames(), 4);
+        expectFrame(reader, 1, 10, 11, 1);
+        expectFrame(reader, 3, 30, 5, 3);
+        endOfFrames = reader.getEndOfFrames();
+    }
+
+    //Without the index the frames are found by scanning
+    std::filesystem::resize_file(path, endOfFrames);
+    {
+        TrajectoryReader reader(path);
+        ASSERT_EQ(reader.getNumberOfFrames(), 4);
+        expectFrame(reader, 3, 30, 5, 3);
+    }
+
+    //A new simulation replaces the trajectory
+    {
+        outputWriter::TrajectoryWriter writer;
+        writer.startNewTrajectory();
+        auto dpc = createParticles(7, 0);
+        writer.plotParticles(dpc, baseName, 0, 0);
+    }
+    {
+        TrajectoryReader reader(path);
+        ASSERT_EQ(reader.getNumberOfFrames(), 1);
+        expectFrame(reader, 0, 0, 7, 0);
+    }
+}
+
+TEST(TrajectoryWriterTest, ResumeOnOutputStep) {
+    const std::string baseName = "TrajectoryWriterResumeTest";
+    const std::string path = baseName + ".traj";
+    std::filesystem::remove(path);
+
+    {
+        outputWriter::TrajectoryWriter writer;
+        for (int frame = 0; frame < 4; frame++) {
+            auto dpc = createParticles(10, frame);
+            writer.plotParticles(dpc, baseName, frame * 10, frame * 10 * 0.01);
+        }
+    }
+
+    //The checkpoint was written at iteration 20, which is plotted again by the resumed simulation. The frames up to
+    //iteration 10 are kept, the frames from iteration 20 on are replaced by the resumed ones.
+    {
+        outputWriter::TrajectoryWriter writer;
+        for (int frame = 2; frame < 5; frame++) {
+            auto dpc = createParticles(5, frame + 10);
+            writer.plotParticles(dpc, baseName, frame * 10, frame * 10 * 0.01);
+        }
+    }
+    {
+        TrajectoryReader reader(path);
+        ASSERT_EQ(reader.getNumberOfFrames(), 5);
+        expectFrame(reader, 0, 0, 10, 0);
+        expectFrame(reader, 1, 10, 10, 1);
+        expectFrame(reader, 2, 20, 5, 12);
+        expectFrame(reader, 3, 30, 5, 13);
+        expectFrame(reader, 4, 40, 5, 14);
+    }
+
+    //Files that are no trajectory are never overwritten implicitly
+    std::filesystem::remove(path);
+    {
+        std::ofstream other(path);
+        other << "no trajectory";
+    }
+    {
+        outputWriter::TrajectoryWriter writer;
+        auto dpc = createParticles(5, 0);
+        EXPECT_THROW(writer.plotParticles(dpc, baseName, 0, 0), std::runtime_error);
+        writer.startNewTrajectory();
+        writer.plotParticles(dpc, baseName, 0, 0);
+    }
+    {
+        TrajectoryReader reader(path);
+        ASSERT_EQ(reader.getNumberOfFrames(), 1);
+        expectFrame(reader, 0, 0, 5, 0);
+    }
+    std::filesystem::remove(path);
+}
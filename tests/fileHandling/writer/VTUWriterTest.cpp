@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <regex>
+
+#include "fileHandling/outputWriter/VTUWriter/VTUWriter.h"
+#include "particleRepresentation/container/defaultParticleContainer/DefaultParticleContainer.h"
+
+#ifdef MOLSIM_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+/**
+ * The arrays written to the appended data section have to be decoded to the values of the particles again. This is
+ * checked for both precisions and for compressed files by decoding the file the same way ParaView does.
+ */
+
+namespace {
+    /**
+     * @brief Minimal reader for the files written by the VTUWriter.
+     */
+    class VTUFile {
+    private:
+        std::string content;
+        size_t dataStart;
+        bool compressed;
+
+        template<typename T>
+        T read(size_t position) const {
+            T value;
+            std::memcpy(&value, content.data() + position, sizeof(T));
+            return value;
+        }
+
+    public:
+        explicit VTUFile(const std::string &path) {
+            std::ifstream file(path, std::ios::binary);
+            content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            dataStart = content.find("<AppendedData encoding=\"raw\">");
+            dataStart = content.find('_', dataStart) + 1;
+            compressed = content.find("vtkZLibDataCompressor") < dataStart;
+        }
+
+        [[nodiscard]] std::string getType(const std::string &name) const {
+            std::smatch match;
+            std::regex expression("type=\"(\\w+)\" Name=\"" + name + "\"");
+            std::regex_search(content, match, expression);
+            return match[1];
+        }
+
+        [[nodiscard]] std::vector<char> getArray(const std::string &name) const {
+            std::smatch match;
+            std::regex expression("Name=\"" + name + "\"[^>]*offset=\"(\\d+)\"");
+            if (!std::regex_search(content, match, expression)) {
+                return {};
+            }
+            size_t position = dataStart + std::stoul(match[1]);
+            if (!compressed) {
+                auto size = read<uint64_t>(position);
+                return {content.begin() + static_cast<long>(position + 8),
+                        content.begin() + static_cast<long>(position + 8 + size)};
+            }
+            std::vector<char> result;
+#ifdef MOLSIM_WITH_ZLIB
+            auto blocks = read<uint64_t>(position);
+            auto blockSize = read<uint64_t>(position + 8);
+            auto lastBlockSize = read<uint64_t>(position + 16);
+            size_t data = position + 24 + blocks * 8;
+            for (uint64_t b = 0; b < blocks; b++) {
+                auto compressedSize = read<uint64_t>(position + 24 + b * 8);
+                uLongf size = (b == blocks - 1 && lastBlockSize != 0) ? lastBlockSize : blockSize;
+                size_t begin = result.size();
+                result.resize(begin + size);
+                uncompress(reinterpret_cast<Bytef *>(result.data() + begin), &size,
+                           reinterpret_cast<const Bytef *>(content.data() + data), compressedSize);
+                result.resize(begin + size);
+                data += compressedSize;
+            }
+#endif
+            return result;
+        }
+
+        template<typename T>
+        [[nodiscard]] std::vector<T> getValues(const std::string &name) const {
+            auto raw = getArray(name);
+            std::vector<T> values(raw.size() / sizeof(T));
+            std::memcpy(values.data(), raw.data(), values.size() * sizeof(T));
+            return values;
+        }
+    };
+
+    DefaultParticleContainer createParticles(size_t n) {
+        DefaultParticleContainer dpc;
+        for (size_t i = 0; i < n; i++) {
+            double x = static_cast<double>(i);
+            Particle p{{x / 3, 1.0 / 7 * x, -x}, {0.1 * x, 2, 3}, 1 + x / 10, static_cast<int>(i % 4)};
+            p.setOldF({x, -x, 1e-3 * x});
+            dpc.add(p);
+        }
+        return dpc;
+    }
+
+    template<typename Float>
+    void checkFile(const std::string &path, DefaultParticleContainer &dpc) {
+        VTUFile file(path);
+        auto points = file.getValues<Float>("points");
+        auto velocity = file.getValues<Float>("velocity");
+        auto force = file.getValues<Float>("force");
+        auto mass = file.getValues<Float>("mass");
+        auto type = file.getValues<int32_t>("type");
+        ASSERT_EQ(points.size(), 3 * dpc.size());
+        ASSERT_EQ(velocity.size(), 3 * dpc.size());
+        ASSERT_EQ(force.size(), 3 * dpc.size());
+        ASSERT_EQ(mass.size(), dpc.size());
+        ASSERT_EQ(type.size(), dpc.size());
+        EXPECT_TRUE(file.getArray("connectivity").empty());
+
+        size_t i = 0;
+        dpc.applyToEachParticle([&](Particle &p) {
+            for (int d = 0; d < 3; d++) {
+                EXPECT_EQ(points[3 * i + d], static_cast<Float>(p.getX()[d]));
+                EXPECT_EQ(velocity[3 * i + d], static_cast<Float>(p.getV()[d]));
+                EXPECT_EQ(force[3 * i + d], static_cast<Float>(p.getOldF()[d]));
+            }
+            EXPECT_EQ(mass[i], static_cast<Float>(p.getM()));
+            EXPECT_EQ(type[i], p.getType());
+            i++;
+        });
+    }
+}
+
+TEST(VTUWriterTest, Float32RoundTrip) {
+    auto dpc = createParticles(100);
+    outputWriter::VTUWriter writer{outputWriter::VTUWriter::Precision::float32};
+    writer.writeFile(dpc, "VTUWriterTest32.vtu");
+    EXPECT_EQ(VTUFile("VTUWriterTest32.vtu").getType("points"), "Float32");
+    checkFile<float>("VTUWriterTest32.vtu", dpc);
+}
+
+TEST(VTUWriterTest, Float64RoundTrip) {
+    auto dpc = createParticles(100);
+    outputWriter::VTUWriter writer{outputWriter::VTUWriter::Precision::float64};
+    writer.writeFile(dpc, "VTUWriterTest64.vtu");
+    EXPECT_EQ(VTUFile("VTUWriterTest64.vtu").getType("points"), "Float64");
+    checkFile<double>("VTUWriterTest64.vtu", dpc);
+}
+
+TEST(VTUWriterTest, CompressedRoundTrip) {
+    if (!outputWriter::VTUWriter::isCompressionAvailable()) {
+        EXPECT_THROW(outputWriter::VTUWriter(outputWriter::VTUWriter::Precision::float64, true), std::invalid_argument);
+        GTEST_SKIP() << "MolSim was built without zlib";
+    }
+    //Large enough to span several compressed blocks
+    auto dpc = createParticles(5000);
+    outputWriter::VTUWriter writer{outputWriter::VTUWriter::Precision::float64, true};
+    writer.writeFile(dpc, "VTUWriterTestCompressed.vtu");
+    checkFile<double>("VTUWriterTestCompressed.vtu", dpc);
+}
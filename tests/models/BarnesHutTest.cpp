@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "../../src/models/barnesHut/BarnesHut.h"
+#include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
+
+namespace {
+    /**
+     * Add a cloud of particles with different masses to the model and compute the exact gravitational forces
+     * between all of them as reference.
+     */
+    std::vector<std::array<double, 3>> addCloud(BarnesHut &model) {
+        std::vector<Particle> cloud;
+        for (int i = 0; i < 200; i++) {
+            //Deterministic, irregular positions
+            cloud.emplace_back(std::array<double, 3>{std::fmod(i * 0.6180339887, 1.0) * 10,
+                                                     std::fmod(i * 0.4142135623, 1.0) * 10,
+                                                     std::fmod(i * 0.7320508075, 1.0) * 10},
+                               std::array<double, 3>{0, 0, 0}, 1 + i % 4);
+        }
+        Gravity gravity;
+        std::vector<std::array<double, 3>> expected(cloud.size(), {0, 0, 0});
+        for (size_t i = 0; i < cloud.size(); i++) {
+            for (size_t j = i + 1; j < cloud.size(); j++) {
+                auto f = gravity.compute(cloud[i], cloud[j]);
+                expected[i] = expected[i] + f;
+                expected[j] = expected[j] - f;
+            }
+        }
+        for (auto &p: cloud) {
+            model.addParticle(p);
+        }
+        return expected;
+    }
+}
+
+/**
+ * With an opening angle of 0 no node is approximated, so the forces have to match the direct sum.
+ */
+TEST(BarnesHutTest, ThetaZeroMatchesDirectSum) {
+    Gravity gravity;
+    BarnesHut model{gravity, 0.01, FileHandler::outputFormat::vtk, false, 1, 0};
+    auto expected = addCloud(model);
+    model.updateForces();
+
+    size_t i = 0;
+    model.getParticles().applyToEachParticle([&](Particle &p) {
+        for (int d = 0; d < 3; d++) {
+            EXPECT_NEAR(p.getF()[d], expected[i][d], 1e-9 * std::max(1.0, std::abs(expected[i][d])));
+        }
+        i++;
+    });
+}
+
+/**
+ * With the usual opening angle of 0.5 the approximated forces should deviate only slightly from the exact forces.
+ */
+TEST(BarnesHutTest, ApproximationIsAccurate) {
+    Gravity gravity;
+    BarnesHut model{gravity, 0.01, FileHandler::outputFormat::vtk, false, 1, 0.5};
+    auto expected = addCloud(model);
+    model.updateForces();
+
+    double errorSquared = 0;
+    double normSquared = 0;
+    size_t i = 0;
+    model.getParticles().applyToEachParticle([&](Particle &p) {
+        auto error = p.getF() - expected[i];
+        errorSquared += std::pow(ArrayUtils::L2Norm(error), 2);
+        normSquared += std::pow(ArrayUtils::L2Norm(expected[i]), 2);
+        i++;
+    });
+    EXPECT_LT(std::sqrt(errorSquared / normSquared), 1e-2);
+}
+
+/**
+ * The Barnes-Hut approximation is only valid for gravity.
+ */
+TEST(BarnesHutTest, RejectsOtherForces) {
+    LeonardJonesForce lJF;
+    EXPECT_THROW((BarnesHut{lJF, 0.01, FileHandler::outputFormat::vtk, false}), std::invalid_argument);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "../../src/models/directSum/DirectSum.h"
+#include "moleculeSimulator/forceCalculation/gravity/Gravity.h"
+#include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
+
+namespace {
+    /**
+     * Add a cloud of particles spanning several tiles to the model and compute the forces between all of them with a
+     * plain double loop as reference.
+     */
+    std::vector<std::array<double, 3>> addCloud(DirectSum &model, Force &force) {
+        std::vector<Particle> cloud;
+        for (int i = 0; i < 300; i++) {
+            //Deterministic, irregular positions
+            cloud.emplace_back(std::array<double, 3>{std::fmod(i * 0.6180339887, 1.0) * 20,
+                                                     std::fmod(i * 0.4142135623, 1.0) * 20,
+                                                     std::fmod(i * 0.7320508075, 1.0) * 20},
+                               std::array<double, 3>{0, 0, 0}, 1 + i % 4);
+        }
+        std::vector<std::array<double, 3>> expected(cloud.size(), {0, 0, 0});
+        for (size_t i = 0; i < cloud.size(); i++) {
+            for (size_t j = i + 1; j < cloud.size(); j++) {
+                auto f = force.compute(cloud[i], cloud[j]);
+                expected[i] = expected[i] + f;
+                expected[j] = expected[j] - f;
+            }
+        }
+        for (auto &p: cloud) {
+            model.addParticle(p);
+        }
+        return expected;
+    }
+
+    void expectForces(DirectSum &model, const std::vector<std::array<double, 3>> &expected) {
+        size_t i = 0;
+        model.getParticles().applyToEachParticle([&](Particle &p) {
+            for (int d = 0; d < 3; d++) {
+                EXPECT_NEAR(p.getF()[d], expected[i][d], 1e-9 * std::max(1.0, std::abs(expected[i][d])));
+            }
+            i++;
+        });
+    }
+}
+
+/**
+ * Do the tiled serial and parallel force calculations match the plain double loop?
+ */
+TEST(DirectSumTest, TiledForcesMatchDoubleLoop) {
+    Gravity gravity;
+    LeonardJonesForce lJF;
+    for (Force *force: std::initializer_list<Force *>{&gravity, &lJF}) {
+        for (int threads: {1, 4}) {
+            DirectSum model{*force, 0.01, FileHandler::outputFormat::vtk, false, 1, threads};
+            auto expected = addCloud(model, *force);
+            model.updateForces();
+            expectForces(model, expected);
+            //The forces have to be reset between two calculations
+            model.updateForces();
+            expectForces(model, expected);
+        }
+    }
+}
+
+/**
+ * The number of threads has to be positive.
+ */
+TEST(DirectSumTest, RejectsInvalidThreads) {
+    Gravity gravity;
+    EXPECT_THROW((DirectSum{gravity, 0.01, FileHandler::outputFormat::vtk, false, 1, 0}), std::invalid_argument);
+}
@@ -0,0 +1,279 @@
+#ifdef MOLSIM_WITH_MPI
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+
+#include "models/linkedCells/DomainDecomposition.h"
+#include "models/linkedCells/LinkedCells.h"
+#include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
+#include "moleculeSimulator/thermostat/Thermostat.h"
+
+namespace {
+    /**
+     * Initialises MPI before the first test and finalises it after the last one. Without mpirun, the tests run on a
+     * single process.
+     */
+    class MPIEnvironment : public ::testing::Environment {
+    public:
+        void SetUp() override {
+            int initialized;
+            MPI_Initialized(&initialized);
+            if (!initialized) {
+                MPI_Init(nullptr, nullptr);
+            }
+        }
+
+        void TearDown() override {
+            int finalized;
+            MPI_Finalized(&finalized);
+            if (!finalized) {
+                MPI_Finalize();
+            }
+        }
+    };
+
+    [[maybe_unused]] const auto *environment = ::testing::AddGlobalTestEnvironment(new MPIEnvironment);
+
+    /**
+     * Collect the positions of the particles inside the domains of all processes.
+     */
+    std::vector<std::array<double, 3>> gatherPositions(ParticleContainer &particles) {
+        std::vector<double> local;
+        particles.applyToEachParticleInDomain([&local](Particle &p) {
+            local.insert(local.end(), p.getX().begin(), p.getX().end());
+        });
+        int processes;
+        MPI_Comm_size(MPI_COMM_WORLD, &processes);
+        int count = static_cast<int>(local.size());
+        std::vector<int> counts(processes);
+        MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+        std::vector<int> displacements(processes, 0);
+        for (int i = 1; i < processes; i++) {
+            displacements[i] = displacements[i - 1] + counts[i - 1];
+        }
+        std::vector<double> all(displacements.back() + counts.back());
+        MPI_Allgatherv(local.data(), count, MPI_DOUBLE, all.data(), counts.data(), displacements.data(), MPI_DOUBLE,
+                       MPI_COMM_WORLD);
+
+        std::vector<std::array<double, 3>> positions;
+        for (size_t i = 0; i < all.size(); i += 3) {
+            positions.push_back({all[i], all[i + 1], all[i + 2]});
+        }
+        return positions;
+    }
+
+    /**
+     * Run the same simulation on the whole domain and distributed over all processes and compare the positions.
+     */
+    void expectDistributedRunMatchesSerial(std::array<double, 3> domainSize, BoundarySet boundaries,
+                                           std::array<double, 3> cuboidPosition, std::array<unsigned, 3> cuboidSize,
+                                           std::array<double, 3> velocity, ParticleLayout layout) {
+        LeonardJonesForce lJF;
+        const double rCutOff = 2.5;
+        auto simulate = [&](std::shared_ptr<DomainDecomposition> decomposition) {
+            LinkedCells model = {
+                lJF, 0.001, domainSize, rCutOff, FileHandler::outputFormat::vtk, boundaries, false, 1, layout, 0, 1,
+                ParallelStrategy::coloring, CellOrdering::rowMajor, 0, std::move(decomposition)
+            };
+            model.addCuboid(cuboidPosition, cuboidSize[0], cuboidSize[1], cuboidSize[2], 1.12, 1, velocity, 0, 0, 5,
+                            1);
+            model.updateForces();
+            for (int i = 0; i < 200; i++) {
+                model.step();
+            }
+            return gatherPositions(model.getParticles());
+        };
+
+        //Every process runs the reference simulation on its own
+        std::vector<std::array<double, 3>> expected;
+        {
+            LinkedCells model = {
+                lJF, 0.001, domainSize, rCutOff, FileHandler::outputFormat::vtk, boundaries, false, 1, layout
+            };
+            model.addCuboid(cuboidPosition, cuboidSize[0], cuboidSize[1], cuboidSize[2], 1.12, 1, velocity, 0, 0, 5,
+                            1);
+            model.updateForces();
+            for (int i = 0; i < 200; i++) {
+                model.step();
+            }
+            model.getParticles().applyToEachParticleInDomain([&expected](Particle &p) {
+                expected.push_back(p.getX());
+            });
+        }
+
+        auto positions = simulate(std::make_shared<DomainDecomposition>(MPI_COMM_WORLD, domainSize, rCutOff,
+                                                                        boundaries));
+        ASSERT_EQ(positions.size(), expected.size());
+        //The order of the particles differs, so each particle is matched to the closest one
+        for (auto &position: positions) {
+            double closest = std::numeric_limits<double>::max();
+            for (auto &reference: expected) {
+                closest = std::min(closest, ArrayUtils::L2Norm(position - reference));
+            }
+            EXPECT_LT(closest, 1e-8);
+        }
+    }
+}
+
+/**
+ * Check the decomposition of the domain into subdomains.
+ */
+TEST(DomainDecompositionTest, SubdomainsCoverDomain) {
+    BoundarySet boundaries = {
+        BoundaryCondition::periodic, BoundaryCondition::outflow, BoundaryCondition::periodic,
+        BoundaryCondition::outflow, BoundaryCondition::reflective, BoundaryCondition::reflective
+    };
+    DomainDecomposition decomposition(MPI_COMM_WORLD, {12, 12, 12}, 2.5, boundaries);
+    auto grid = decomposition.getProcessGrid();
+    EXPECT_EQ(grid[0] * grid[1] * grid[2], decomposition.getNumberOfProcesses());
+
+    std::vector<double> volume{1};
+    for (int dim = 0; dim < 3; dim++) {
+        volume[0] *= decomposition.getSubdomainSize()[dim];
+        EXPECT_GE(decomposition.getOrigin()[dim], 0);
+        EXPECT_LE(decomposition.getOrigin()[dim] + decomposition.getSubdomainSize()[dim], 12 + 1e-12);
+    }
+    decomposition.sum(volume);
+    EXPECT_NEAR(volume[0], 12 * 12 * 12, 1e-9);
+
+    //The front and back side are periodic, so they are shared with another process, if there is more than one along y
+    auto remote = decomposition.getRemoteSides();
+    EXPECT_EQ(remote[static_cast<int>(Side::front)], grid[1] > 1);
+    EXPECT_EQ(remote[static_cast<int>(Side::back)], grid[1] > 1);
+    //The left side is an outflow boundary, so it is only remote for processes that do not touch it
+    EXPECT_EQ(remote[static_cast<int>(Side::left)], decomposition.getOrigin()[0] > 0);
+}
+
+/**
+ * Check, that a subdomain must not be smaller than the cut-off radius.
+ */
+TEST(DomainDecompositionTest, RejectsTooSmallSubdomains) {
+    BoundarySet boundaries = {
+        BoundaryCondition::outflow, BoundaryCondition::outflow, BoundaryCondition::outflow,
+        BoundaryCondition::outflow, BoundaryCondition::outflow, BoundaryCondition::outflow
+    };
+    int processes;
+    MPI_Comm_size(MPI_COMM_WORLD, &processes);
+    if (processes == 1) {
+        GTEST_SKIP() << "A single process always simulates the whole domain";
+    }
+    EXPECT_THROW(DomainDecomposition(MPI_COMM_WORLD, {3, 3, 3}, 2.5, boundaries), std::invalid_argument);
+}
+
+/**
+ * Check, that Verlet lists cannot be combined with a domain decomposition.
+ */
+TEST(DomainDecompositionTest, RejectsVerletLists) {
+    LeonardJonesForce lJF;
+    BoundarySet boundaries = {
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic,
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic
+    };
+    auto decomposition = std::make_shared<DomainDecomposition>(MPI_COMM_WORLD, std::array<double, 3>{12, 12, 12}, 2.5,
+                                                               boundaries);
+    EXPECT_THROW(LinkedCells(lJF, 0.001, {12, 12, 12}, 2.5, FileHandler::outputFormat::vtk, boundaries, false, 1,
+                             ParticleLayout::aos, 0.3, 1, ParallelStrategy::coloring, CellOrdering::rowMajor, 0,
+                             decomposition), std::invalid_argument);
+}
+
+/**
+ * Check, that particles crossing subdomains and periodic boundaries move like without decomposition.
+ */
+TEST(DomainDecompositionTest, PeriodicMatchesSerial) {
+    BoundarySet boundaries = {
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic,
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic
+    };
+    for (ParticleLayout layout: {ParticleLayout::aos, ParticleLayout::soa}) {
+        expectDistributedRunMatchesSerial({12, 12, 12}, boundaries, {3.6, 3.6, 3.6}, {7, 7, 7}, {8, -6, 5}, layout);
+    }
+}
+
+/**
+ * Check, that reflective, outflow and periodic boundaries at the edges of the domain still work.
+ */
+TEST(DomainDecompositionTest, MixedBoundariesMatchSerial) {
+    BoundarySet boundaries = {
+        BoundaryCondition::periodic, BoundaryCondition::reflective, BoundaryCondition::periodic,
+        BoundaryCondition::reflective, BoundaryCondition::outflow, BoundaryCondition::outflow
+    };
+    expectDistributedRunMatchesSerial({12, 12, 12}, boundaries, {6.5, 1.0, 6.5}, {5, 5, 4}, {12, -6, 15},
+                                      ParticleLayout::aos);
+    //In 2D, only the x and y dimension is decomposed
+    expectDistributedRunMatchesSerial({12, 12, 0}, boundaries, {1.0, 6.5, 0}, {8, 5, 1}, {-10, 6, 0},
+                                      ParticleLayout::aos);
+}
+
+/**
+ * Check, that the parameter types are the same on all processes, even if the processes hold different parameters.
+ */
+TEST(DomainDecompositionTest, ParameterTypesMatchOnAllProcesses) {
+    LeonardJonesForce lJF;
+    BoundarySet boundaries = {
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic,
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic
+    };
+    auto decomposition = std::make_shared<DomainDecomposition>(MPI_COMM_WORLD, std::array<double, 3>{12, 12, 12}, 2.5,
+                                                               boundaries);
+    LinkedCells model = {
+        lJF, 0.001, {12, 12, 12}, 2.5, FileHandler::outputFormat::vtk, boundaries, false, 1, ParticleLayout::aos, 0,
+        1, ParallelStrategy::coloring, CellOrdering::rowMajor, 0, decomposition
+    };
+    //Like particles read from a checkpoint, each process adds its own parameters in its own order
+    const int rank = decomposition->getRank();
+    std::array<double, 3> center = decomposition->getOrigin() + 0.5 * decomposition->getSubdomainSize();
+    Particle own{center, {0, 0, 0}, 1, 0, 2.5 + rank, 1};
+    Particle shared{center + std::array<double, 3>{0.1, 0, 0}, {0, 0, 0}, 1, 0, 3, 1.2};
+    model.getParticles().add(rank % 2 == 0 ? own : shared);
+    model.getParticles().add(rank % 2 == 0 ? shared : own);
+    model.registerParameterTypes();
+
+    std::vector<double> parameters;
+    for (auto [sigma, epsilon]: lJF.getRegistry().getParameters()) {
+        parameters.push_back(sigma);
+        parameters.push_back(epsilon);
+    }
+    std::vector<double> parametersOfRankZero = parameters;
+    MPI_Bcast(parametersOfRankZero.data(), static_cast<int>(parameters.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    EXPECT_EQ(parameters, parametersOfRankZero);
+    //The default type, the pair shared by all processes and one pair of each process
+    EXPECT_EQ(lJF.getRegistry().getNumberOfTypes(), 2 + decomposition->getNumberOfProcesses());
+    model.getParticles().applyToEachParticle([&lJF](Particle &p) {
+        auto [sigma, epsilon] = lJF.getRegistry().getParameters()[p.getParameterType()];
+        EXPECT_EQ(sigma, p.getSigma());
+        EXPECT_EQ(epsilon, p.getEpsilon());
+    });
+}
+
+/**
+ * Check, that the thermostat measures the temperature of the whole system.
+ */
+TEST(DomainDecompositionTest, ThermostatUsesGlobalTemperature) {
+    LeonardJonesForce lJF;
+    BoundarySet boundaries = {
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic,
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic
+    };
+    LinkedCells serial = {lJF, 0.001, {12, 12, 12}, 2.5, FileHandler::outputFormat::vtk, boundaries, false};
+    LinkedCells distributed = {
+        lJF, 0.001, {12, 12, 12}, 2.5, FileHandler::outputFormat::vtk, boundaries, false, 1, ParticleLayout::aos, 0,
+        1, ParallelStrategy::coloring, CellOrdering::rowMajor, 0,
+        std::make_shared<DomainDecomposition>(MPI_COMM_WORLD, std::array<double, 3>{12, 12, 12}, 2.5, boundaries)
+    };
+    //Velocities depend on the position, so both models are in the same state
+    for (LinkedCells *model: {&serial, &distributed}) {
+        model->addCuboid({0.5, 0.5, 0.5}, 10, 10, 10, 1.1, 1, {0, 0, 0}, 0, 0);
+        model->getParticles().applyToEachParticle([](Particle &p) {
+            p.setV({p.getX()[0] - 6, 0.5 * p.getX()[1], 1});
+        });
+    }
+    Thermostat serialThermostat(serial, 0, 40, 1000, 3);
+    Thermostat distributedThermostat(distributed, 0, 40, 1000, 3);
+    EXPECT_NEAR(distributedThermostat.calculateTemperature(), serialThermostat.calculateTemperature(), 1e-9);
+
+    distributedThermostat.setTemperatureOfTheSystemViaVelocityScaling();
+    EXPECT_NEAR(distributedThermostat.calculateTemperature(), 40, 1e-9);
+}
+
+#endif
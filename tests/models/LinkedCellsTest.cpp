@@ -3,6 +3,8 @@
 //
 
 #include <gtest/gtest.h>
+#include <limits>
+#include <tuple>
 
 #include "../../src/models/linkedCells/LinkedCells.h"
 #include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
@@ -239,3 +241,304 @@ TEST(LinkedCellsTest, Periodic_Force_Calculation) {
         current_time += 0.0005;
     }
 }
+
+/**
+ * Test 3: The structure of arrays layout only changes the way the particles are processed during the force
+ *         calculation. Therefore, both layouts have to produce the same forces (except for rounding errors
+ *         due to a different summation order) when applied to the same particles.
+ */
+
+TEST(LinkedCellsTest, SoALayoutMatchesAoSLayout) {
+    LeonardJonesForce lJF;
+    BoundarySet boundaries = {
+        BoundaryCondition::outflow, BoundaryCondition::outflow, BoundaryCondition::outflow,
+        BoundaryCondition::outflow, BoundaryCondition::outflow, BoundaryCondition::outflow
+    };
+
+    LinkedCells aosModel = {
+        lJF, 0.0005, {10, 10, 10}, 2.5, FileHandler::outputFormat::vtk, boundaries, false, 1, ParticleLayout::aos
+    };
+    LinkedCells soaModel = {
+        lJF, 0.0005, {10, 10, 10}, 2.5, FileHandler::outputFormat::vtk, boundaries, false, 1, ParticleLayout::soa
+    };
+
+    //Two cuboids of different particle types, so that the mixing rules are covered as well.
+    for (LinkedCells *model: {&aosModel, &soaModel}) {
+        model->addCuboid({1, 1, 1}, 4, 4, 4, 1.1, 1, {0, 0, 0}, 0, 0, 5, 1);
+        model->addCuboid({5.5, 5.5, 5.5}, 3, 3, 3, 1.2, 1, {0, 0, 0}, 0, 0, 2, 1.2);
+    }
+
+    for (int i = 0; i < 10; i++) {
+        aosModel.step();
+        soaModel.step();
+    }
+    aosModel.updateForces();
+    soaModel.updateForces();
+
+    std::vector<std::array<double, 3>> aosForces;
+    aosModel.getParticles().applyToEachParticle([&aosForces](Particle &p) {
+        aosForces.push_back(p.getF());
+    });
+    std::vector<std::array<double, 3>> soaForces;
+    soaModel.getParticles().applyToEachParticle([&soaForces](Particle &p) {
+        soaForces.push_back(p.getF());
+    });
+
+    ASSERT_EQ(aosForces.size(), soaForces.size());
+    for (size_t i = 0; i < aosForces.size(); i++) {
+        for (int d = 0; d < 3; d++) {
+            EXPECT_NEAR(aosForces[i][d], soaForces[i][d], 1e-8 * std::max(1.0, std::abs(aosForces[i][d])));
+        }
+    }
+}
+
+namespace {
+    /**
+     * Run the same simulation of two cuboids with and without Verlet lists and compare the forces. The particles are
+     * moving fast enough, so that the lists are rebuilt several times.
+     */
+    void expectVerletListsMatchCells(BoundarySet boundaries, int threads, std::array<double, 3> firstCuboid,
+                                     std::array<double, 3> secondCuboid) {
+        LeonardJonesForce lJF;
+        LinkedCells cellModel = {
+            lJF, 0.0005, {10, 10, 10}, 2.5, FileHandler::outputFormat::vtk, boundaries, false
+        };
+        LinkedCells verletModel = {
+            lJF, 0.0005, {10, 10, 10}, 2.5, FileHandler::outputFormat::vtk, boundaries, false, 1, ParticleLayout::aos,
+            0.3, threads
+        };
+
+        for (LinkedCells *model: {&cellModel, &verletModel}) {
+            model->addCuboid(firstCuboid, 4, 4, 4, 1.1, 1, {5, 0, 0}, 0, 0, 5, 1);
+            model->addCuboid(secondCuboid, 3, 3, 3, 1.2, 1, {0, -5, 0}, 0, 0, 2, 1.2);
+            model->updateForces();
+        }
+
+        for (int i = 0; i < 200; i++) {
+            cellModel.step();
+            verletModel.step();
+        }
+
+        //The cells of the Verlet model may be outdated and the forces may be summed up in a different order, so each
+        //particle is matched to the closest particle.
+        std::vector<Particle> cellParticles;
+        cellModel.getParticles().applyToEachParticle([&](Particle &p) {
+            cellParticles.push_back(p);
+        });
+        std::vector<Particle> verletParticles;
+        verletModel.getParticles().applyToEachParticle([&](Particle &p) {
+            verletParticles.push_back(p);
+        });
+
+        ASSERT_EQ(cellParticles.size(), verletParticles.size());
+        for (auto &p: verletParticles) {
+            const Particle *closest = nullptr;
+            for (auto &reference: cellParticles) {
+                if (closest == nullptr ||
+                    ArrayUtils::L2Norm(reference.getX() - p.getX()) < ArrayUtils::L2Norm(closest->getX() - p.getX())) {
+                    closest = &reference;
+                }
+            }
+            ASSERT_NE(closest, nullptr);
+            EXPECT_LT(ArrayUtils::L2Norm(closest->getX() - p.getX()), 1e-9);
+            for (int d = 0; d < 3; d++) {
+                EXPECT_NEAR(closest->getF()[d], p.getF()[d], 1e-6 * std::max(1.0, std::abs(closest->getF()[d])));
+            }
+        }
+    }
+}
+
+/**
+ * Test 4: Verlet lists only change which pairs of particles are tested against the cut-off radius. As long as the
+ *         lists are rebuilt in time, the same pairs interact, so the forces have to match the ones of the cell-based
+ *         calculation.
+ */
+
+TEST(LinkedCellsTest, VerletListsMatchCells) {
+    BoundarySet boundaries = {
+        BoundaryCondition::reflective, BoundaryCondition::reflective, BoundaryCondition::reflective,
+        BoundaryCondition::reflective, BoundaryCondition::reflective, BoundaryCondition::reflective
+    };
+    expectVerletListsMatchCells(boundaries, 1, {1, 1, 1}, {5.5, 5.5, 5.5});
+}
+
+/**
+ * Pairs with the images of the ghost layer are part of the Verlet lists as well. The cuboids face each other across
+ * the periodic boundary along the y-axis.
+ */
+TEST(LinkedCellsTest, VerletListsMatchCellsWithPeriodicBoundaries) {
+    BoundarySet boundaries = {
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic,
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic
+    };
+    expectVerletListsMatchCells(boundaries, 1, {1, 0.8, 1}, {1, 7.3, 1});
+}
+
+TEST(LinkedCellsTest, ParallelVerletListsMatchCells) {
+    BoundarySet boundaries = {
+        BoundaryCondition::periodic, BoundaryCondition::reflective, BoundaryCondition::periodic,
+        BoundaryCondition::reflective, BoundaryCondition::outflow, BoundaryCondition::outflow
+    };
+    expectVerletListsMatchCells(boundaries, 4, {1, 0.8, 1}, {1, 7.3, 1});
+}
+
+TEST(LinkedCellsTest, VerletListsRejectStructureOfArrays) {
+    LeonardJonesForce lJF;
+    BoundarySet boundaries = {
+        BoundaryCondition::reflective, BoundaryCondition::reflective, BoundaryCondition::reflective,
+        BoundaryCondition::reflective, BoundaryCondition::reflective, BoundaryCondition::reflective
+    };
+    EXPECT_THROW(LinkedCells(lJF, 0.0005, {9, 9, 9}, 3, FileHandler::outputFormat::vtk, boundaries, false, 1,
+                     ParticleLayout::soa, 0.3), std::invalid_argument);
+}
+
+/**
+ * Test 5: The parallel force calculation must not change the result (except for rounding errors due to a different
+ *         summation order) for both strategies avoiding data races.
+ */
+
+TEST(LinkedCellsTest, ParallelForcesMatchSerialForces) {
+    LeonardJonesForce lJF;
+    BoundarySet boundaries = {
+        BoundaryCondition::outflow, BoundaryCondition::outflow, BoundaryCondition::outflow,
+        BoundaryCondition::outflow, BoundaryCondition::outflow, BoundaryCondition::outflow
+    };
+
+    for (ParallelStrategy strategy: {ParallelStrategy::coloring, ParallelStrategy::forceBuffers}) {
+        LinkedCells serialModel = {
+            lJF, 0.0005, {10, 10, 10}, 2.5, FileHandler::outputFormat::vtk, boundaries, false
+        };
+        LinkedCells parallelModel = {
+            lJF, 0.0005, {10, 10, 10}, 2.5, FileHandler::outputFormat::vtk, boundaries, false, 1, ParticleLayout::aos, 0, 4,
+            strategy
+        };
+
+        for (LinkedCells *model: {&serialModel, &parallelModel}) {
+            model->addCuboid({1, 1, 1}, 6, 6, 6, 1.1, 1, {0, 0, 0}, 0, 0, 5, 1);
+            model->updateForces();
+        }
+
+        std::vector<std::array<double, 3>> serialForces;
+        serialModel.getParticles().applyToEachParticle([&serialForces](Particle &p) {
+            serialForces.push_back(p.getF());
+        });
+        std::vector<std::array<double, 3>> parallelForces;
+        parallelModel.getParticles().applyToEachParticle([&parallelForces](Particle &p) {
+            parallelForces.push_back(p.getF());
+        });
+
+        ASSERT_EQ(serialForces.size(), parallelForces.size());
+        for (size_t i = 0; i < serialForces.size(); i++) {
+            for (int d = 0; d < 3; d++) {
+                EXPECT_NEAR(serialForces[i][d], parallelForces[i][d], 1e-8 * std::max(1.0, std::abs(serialForces[i][d])));
+            }
+        }
+    }
+}
+
+/**
+ * Here we test, if the forces across periodic boundaries are calculated correctly by the ghost layer.
+ * For each layout and parallel strategy the forces are compared to a direct calculation of all pairs, where each pair
+ * interacts via the minimum image convention.
+ */
+TEST(LinkedCellsTest, PeriodicForcesMatchMinimumImage) {
+    LeonardJonesForce lJF;
+    BoundarySet boundaries = {
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic,
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic
+    };
+    const double rCutOff = 2.5;
+
+    for (std::array<double, 3> domainSize: {std::array<double, 3>{10, 10, 10}, std::array<double, 3>{10, 10, 0}}) {
+        const bool twoD = domainSize[2] == 0;
+        const std::vector<std::tuple<ParticleLayout, int, ParallelStrategy>> configurations = {
+            {ParticleLayout::aos, 1, ParallelStrategy::coloring},
+            {ParticleLayout::aos, 4, ParallelStrategy::coloring},
+            {ParticleLayout::aos, 4, ParallelStrategy::forceBuffers},
+            {ParticleLayout::soa, 4, ParallelStrategy::coloring}
+        };
+        for (auto [layout, threads, strategy]: configurations) {
+            LinkedCells model = {
+                lJF, 0.0005, domainSize, rCutOff, FileHandler::outputFormat::vtk, boundaries, false, 1, layout, 0,
+                threads, strategy
+            };
+            //The gap between the first and the last layer of the cuboid is smaller than the cut-off radius
+            model.addCuboid({0.2, 0.2, twoD ? 0 : 0.2}, 8, 8, twoD ? 1 : 8, 1.13, 1, {0, 0, 0}, 0, 0, 5, 1);
+            model.updateForces();
+
+            std::vector<Particle> particles;
+            model.getParticles().applyToEachParticle([&particles](Particle &p) {
+                particles.push_back(p);
+            });
+            ASSERT_EQ(particles.size(), twoD ? 64u : 512u);
+
+            for (size_t i = 0; i < particles.size(); i++) {
+                std::array<double, 3> expected{0, 0, 0};
+                for (size_t j = 0; j < particles.size(); j++) {
+                    if (i == j) {
+                        continue;
+                    }
+                    std::array<double, 3> difference = particles[j].getX() - particles[i].getX();
+                    for (int d = 0; d < (twoD ? 2 : 3); d++) {
+                        difference[d] -= domainSize[d] * std::round(difference[d] / domainSize[d]);
+                    }
+                    if (ArrayUtils::L2Norm(difference) <= rCutOff) {
+                        Particle image = particles[j];
+                        image.setX(particles[i].getX() + difference);
+                        expected = expected + lJF.compute(particles[i], image);
+                    }
+                }
+                for (int d = 0; d < 3; d++) {
+                    EXPECT_NEAR(particles[i].getF()[d], expected[d], 1e-8 * std::max(1.0, std::abs(expected[d])));
+                }
+            }
+            //The ghost layer is removed again
+            EXPECT_EQ(model.getParticles().size(), particles.size());
+        }
+    }
+}
+
+/**
+ * Here we test, if the Morton and Hilbert cell orderings and the re-sorting of the particle storage lead to the same
+ * trajectories as the row-major ordering.
+ */
+TEST(LinkedCellsTest, CellOrderingsMatchRowMajor) {
+    LeonardJonesForce lJF;
+    BoundarySet boundaries = {
+        BoundaryCondition::periodic, BoundaryCondition::reflective, BoundaryCondition::periodic,
+        BoundaryCondition::reflective, BoundaryCondition::outflow, BoundaryCondition::periodic
+    };
+
+    auto simulate = [&lJF, &boundaries](CellOrdering ordering, int sortInterval, ParticleLayout layout) {
+        LinkedCells model = {
+            lJF, 0.0005, {10, 10, 10}, 2.5, FileHandler::outputFormat::vtk, boundaries, false, 1, layout, 0, 2,
+            ParallelStrategy::coloring, ordering, sortInterval
+        };
+        model.addCuboid({0.6, 0.6, 0.6}, 6, 6, 6, 1.12, 1, {1, -1, 0.5}, 0, 0, 5, 1);
+        model.updateForces();
+        for (int i = 0; i < 50; i++) {
+            model.step();
+        }
+        std::vector<std::array<double, 3>> positions;
+        model.getParticles().applyToEachParticleInDomain([&positions](Particle &p) {
+            positions.push_back(p.getX());
+        });
+        return positions;
+    };
+
+    for (ParticleLayout layout: {ParticleLayout::aos, ParticleLayout::soa}) {
+        auto expected = simulate(CellOrdering::rowMajor, 0, layout);
+        for (CellOrdering ordering: {CellOrdering::morton, CellOrdering::hilbert}) {
+            auto positions = simulate(ordering, 10, layout);
+            ASSERT_EQ(positions.size(), expected.size());
+            //The order of the particles depends on the cell ordering, so each particle is matched to the closest one
+            for (auto &position: positions) {
+                double closest = std::numeric_limits<double>::max();
+                for (auto &reference: expected) {
+                    closest = std::min(closest, ArrayUtils::L2Norm(position - reference));
+                }
+                EXPECT_LT(closest, 1e-9);
+            }
+        }
+    }
+}
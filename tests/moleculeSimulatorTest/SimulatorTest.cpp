@@ -4,7 +4,10 @@
 #include <gtest/gtest.h>
 #include <spdlog/spdlog.h>
 #include "moleculeSimulator/Simulator.h"
+#include "fileHandling/reader/TrajectoryReader/TrajectoryReader.h"
+#include "particleRepresentation/container/defaultParticleContainer/DefaultParticleContainer.h"
 #include "moleculeSimulator/forceCalculation/gravity/Gravity.h"
+#include "utils/MaxwellBoltzmannDistribution.h"
 
 /**
  * Test some edge cases...
@@ -32,3 +35,142 @@ TEST(SimulatorTest, FileDoesNotExist) {
     std::string filepath = "IDoNotExist";
     EXPECT_THROW(Simulator simulator(dS,filepath, FileHandler::outputFormat::vtk,10,filename), std::exception);
 }
+
+namespace {
+    SimulationSettings createCheckpointTestSettings(double endT) {
+        SimulationSettings settings;
+        settings.outputFileName = "CheckpointTest";
+        settings.outputFrequency = 1000;
+        settings.gravityOn = false;
+        settings.gravityFactor = 0;
+        settings.thermostatParameters.useThermostat = false;
+        settings.model = TypeOfModel::linkedCells;
+        settings.parametersLinkedCells.deltaT = 0.0005;
+        settings.parametersLinkedCells.endT = endT;
+        settings.parametersLinkedCells.force = TypeOfForce::leonardJonesForce;
+        settings.parametersLinkedCells.rCutOff = 2.5;
+        settings.parametersLinkedCells.domainSize = {10, 10, 10};
+        settings.parametersLinkedCells.boundaryConditions = {
+            BoundaryCondition::reflective, BoundaryCondition::reflective, BoundaryCondition::reflective,
+            BoundaryCondition::reflective, BoundaryCondition::reflective, BoundaryCondition::reflective
+        };
+        settings.cuboids.push_back({{2, 2, 2}, {4, 4, 4}, 1.1225, 1, {5, 0, 0}, 3, 0.5, 5, 1});
+        return settings;
+    }
+
+    std::vector<std::array<double, 3>> collectState(Simulator &simulator) {
+        std::vector<std::array<double, 3>> state;
+        simulator.getParticles().applyToEachParticle([&state](Particle &p) {
+            state.push_back(p.getX());
+            state.push_back(p.getV());
+            state.push_back(p.getF());
+            state.push_back(p.getOldF());
+        });
+        return state;
+    }
+}
+
+/**
+ * A simulation interrupted by a binary checkpoint and resumed from it has to end in exactly the same state as a simulation
+ * running without interruption. The particles of the checkpoint replace the particles generated from the input.
+ */
+
+TEST(SimulatorTest, BinaryCheckpointResumesBitExactly) {
+    spdlog::set_level(spdlog::level::off);
+    std::string checkpoint = "SimulatorTestCheckpoint.bin";
+
+    //Uninterrupted simulation
+    maxwellBoltzmannRandomEngine().seed(42);
+    auto settings = createCheckpointTestSettings(0.05);
+    Simulator uninterrupted{settings, FileHandler::outputFormat::vtk};
+    uninterrupted.run(true);
+
+    //First half, saved to a checkpoint
+    maxwellBoltzmannRandomEngine().seed(42);
+    settings = createCheckpointTestSettings(0.025);
+    Simulator firstHalf{settings, FileHandler::outputFormat::vtk};
+    firstHalf.run(true);
+    firstHalf.saveState(FileHandler::stateFormat::binary, checkpoint);
+
+    //Second half, resumed from the checkpoint. As with an xml file and --loadState, the simulation first generates the
+    //particles of its input, which have to be replaced by the particles of the checkpoint.
+    settings = createCheckpointTestSettings(0.05);
+    Simulator secondHalf{settings, FileHandler::outputFormat::vtk};
+    secondHalf.loadState(checkpoint);
+    ASSERT_EQ(secondHalf.getParticles().size(), 64);
+    secondHalf.run(true);
+
+    auto expected = collectState(uninterrupted);
+    auto actual = collectState(secondHalf);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+        //Bitwise comparison
+        EXPECT_EQ(std::memcmp(actual[i].data(), expected[i].data(), sizeof(actual[i])), 0) << "Mismatch at " << i;
+    }
+
+    //The domain of the checkpoint has to match the domain of the simulation
+    settings.parametersLinkedCells.domainSize = {12, 10, 10};
+    Simulator otherDomain{settings, FileHandler::outputFormat::vtk};
+    EXPECT_THROW(otherDomain.loadState(checkpoint), std::runtime_error);
+
+    std::remove(checkpoint.c_str());
+    spdlog::set_level(spdlog::level::info);
+}
+
+/**
+ * A resumed simulation plots its start iteration again. If the checkpoint lands on an output step, the trajectory has
+ * to keep all frames before it and must not contain this frame twice.
+ */
+
+TEST(SimulatorTest, ResumedTrajectoryOnOutputStep) {
+    spdlog::set_level(spdlog::level::off);
+    std::string checkpoint = "SimulatorTestTrajectoryCheckpoint.bin";
+
+    //Uninterrupted simulation
+    maxwellBoltzmannRandomEngine().seed(42);
+    auto settings = createCheckpointTestSettings(0.05);
+    settings.outputFrequency = 1;
+    settings.outputFileName = "UninterruptedTrajectory";
+    {
+        Simulator uninterrupted{settings, FileHandler::outputFormat::traj};
+        uninterrupted.run(false);
+    }
+
+    //Every iteration is an output step, so the checkpoint lands on one
+    maxwellBoltzmannRandomEngine().seed(42);
+    settings = createCheckpointTestSettings(0.025);
+    settings.outputFrequency = 1;
+    settings.outputFileName = "ResumedTrajectory";
+    {
+        Simulator firstHalf{settings, FileHandler::outputFormat::traj};
+        firstHalf.run(false);
+        firstHalf.saveState(FileHandler::stateFormat::binary, checkpoint);
+    }
+    settings.parametersLinkedCells.endT = 0.05;
+    {
+        Simulator secondHalf{settings, FileHandler::outputFormat::traj};
+        secondHalf.loadState(checkpoint);
+        secondHalf.run(false);
+    }
+
+    TrajectoryReader expected("UninterruptedTrajectory.traj");
+    TrajectoryReader actual("ResumedTrajectory.traj");
+    ASSERT_EQ(actual.getNumberOfFrames(), expected.getNumberOfFrames());
+    for (size_t frame = 0; frame < actual.getNumberOfFrames(); frame++) {
+        EXPECT_EQ(actual.getIteration(frame), frame);
+    }
+    DefaultParticleContainer expectedParticles;
+    DefaultParticleContainer actualParticles;
+    const size_t last = actual.getNumberOfFrames() - 1;
+    expected.readFrame(last, expectedParticles);
+    actual.readFrame(last, actualParticles);
+    ASSERT_EQ(actualParticles.size(), expectedParticles.size());
+    for (size_t i = 0; i < actualParticles.size(); i++) {
+        EXPECT_EQ(actualParticles.at(i).getX(), expectedParticles.at(i).getX());
+    }
+
+    std::remove(checkpoint.c_str());
+    std::remove("UninterruptedTrajectory.traj");
+    std::remove("ResumedTrajectory.traj");
+    spdlog::set_level(spdlog::level::info);
+}
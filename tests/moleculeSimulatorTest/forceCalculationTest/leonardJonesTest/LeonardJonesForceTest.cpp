@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
+#include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesTypeRegistry.h"
 
 
 /**
@@ -96,3 +97,140 @@ TEST(LeonardJonesForceTest, PositionsEqual) {
     EXPECT_TRUE(std::isnan(force_p1p2[1]));
     EXPECT_TRUE(std::isnan(force_p1p2[2]));
 }
+
+/**
+ * The vectorised kernels have to produce the same forces as the pairwise computation (except for rounding errors).
+ * We use two cells with 19 and 13 particles of different types, so that full vectors, remainders and
+ * pairs outside the cut-off radius occur. Kernels not supported by the CPU are skipped.
+ */
+
+TEST(LeonardJonesForceTest, SoAKernelsMatchPairwiseComputation) {
+    const double rCutOff = 2.5;
+    std::vector<Particle> cell1;
+    std::vector<Particle> cell2;
+    for (int i = 0; i < 19; i++) {
+        cell1.emplace_back(std::array<double, 3>{0.4 * (i % 5), 0.45 * (i / 5), 0.1 * (i % 3)},
+                           std::array<double, 3>{0, 0, 0}, 1, i % 2, 1 + i % 3, 1 + 0.1 * (i % 2));
+    }
+    for (int i = 0; i < 13; i++) {
+        cell2.emplace_back(std::array<double, 3>{2.1 + 0.35 * (i % 4), 0.5 * (i / 4), 0.2},
+                           std::array<double, 3>{0, 0, 0}, 1, 2, 2, 1.2);
+    }
+
+    //Every force registers the parameters in the same order, so the parameter types are the same for all forces
+    auto registerTypes = [&cell1, &cell2](LeonardJonesForce &force) {
+        for (auto *cell: {&cell1, &cell2}) {
+            for (auto &p: *cell) {
+                p.setParameterType(force.registerParameterType(p.getSigma(), p.getEpsilon()));
+            }
+        }
+    };
+
+    //Reference using the pairwise computation
+    std::vector<std::array<double, 3>> expected1(cell1.size(), {0, 0, 0});
+    std::vector<std::array<double, 3>> expected2(cell2.size(), {0, 0, 0});
+    LeonardJonesForce reference{LeonardJonesKernels::SimdLevel::scalar};
+    registerTypes(reference);
+    for (size_t i = 0; i < cell1.size(); i++) {
+        for (size_t j = i + 1; j < cell1.size(); j++) {
+            if (ArrayUtils::L2Norm(cell1[i].getX() - cell1[j].getX()) <= rCutOff) {
+                auto f = reference.compute(cell1[i], cell1[j]);
+                expected1[i] = expected1[i] + f;
+                expected1[j] = expected1[j] - f;
+            }
+        }
+        for (size_t j = 0; j < cell2.size(); j++) {
+            if (ArrayUtils::L2Norm(cell1[i].getX() - cell2[j].getX()) <= rCutOff) {
+                auto f = reference.compute(cell1[i], cell2[j]);
+                expected1[i] = expected1[i] + f;
+                expected2[j] = expected2[j] - f;
+            }
+        }
+    }
+
+    for (auto level: {LeonardJonesKernels::SimdLevel::scalar, LeonardJonesKernels::SimdLevel::avx2,
+                      LeonardJonesKernels::SimdLevel::avx512}) {
+        if (level > LeonardJonesKernels::detectSimdLevel()) {
+            continue;
+        }
+        LeonardJonesForce lJF{level};
+        registerTypes(lJF);
+        ParticleSoA soa1;
+        ParticleSoA soa2;
+        soa1.load(cell1);
+        soa2.load(cell2);
+        lJF.computeWithinCellSoA(soa1, rCutOff);
+        lJF.computeBetweenCellsSoA(soa1, soa2, rCutOff);
+
+        for (size_t i = 0; i < cell1.size(); i++) {
+            for (int d = 0; d < 3; d++) {
+                EXPECT_NEAR(soa1.f[d][i], expected1[i][d], 1e-9 * std::max(1.0, std::abs(expected1[i][d])))
+                    << LeonardJonesKernels::toString(level);
+            }
+        }
+        for (size_t j = 0; j < cell2.size(); j++) {
+            for (int d = 0; d < 3; d++) {
+                EXPECT_NEAR(soa2.f[d][j], expected2[j][d], 1e-9 * std::max(1.0, std::abs(expected2[j][d])))
+                    << LeonardJonesKernels::toString(level);
+            }
+        }
+    }
+}
+
+/**
+ * Particles with equal Leonard-Jones parameters have to share their parameter type and the precomputed tables have to
+ * contain the constants of the Lorentz-Berthelot mixing rule. The force between two particles of different types has
+ * to match the formula with explicitly mixed constants. Each force has a registry of its own.
+ */
+
+TEST(LeonardJonesForceTest, TypeRegistryMixesParameters) {
+    LeonardJonesForce lJF;
+    Particle p1({0, 0, 0}, {0, 0, 0}, 1, 0, 3, 1.1);
+    Particle p2({1.3, 0.4, 0}, {0, 0, 0}, 1, 1, 7, 1.5);
+    Particle p3({5, 5, 5}, {0, 0, 0}, 2, 2, 3, 1.1);
+    for (Particle *p: {&p1, &p2, &p3}) {
+        p->setParameterType(lJF.registerParameterType(p->getSigma(), p->getEpsilon()));
+    }
+
+    EXPECT_EQ(p1.getParameterType(), p3.getParameterType());
+    EXPECT_NE(p1.getParameterType(), p2.getParameterType());
+    EXPECT_EQ(p1.getParameterType(), lJF.registerParameterType(1.1, 3));
+    //The default parameters are always type 0
+    EXPECT_EQ(lJF.registerParameterType(1, 5), 0);
+    EXPECT_EQ(lJF.getRegistry().getNumberOfTypes(), 3);
+    EXPECT_EQ(LeonardJonesForce{}.getRegistry().getNumberOfTypes(), 1);
+
+    const LeonardJonesTypeRegistry &registry = lJF.getRegistry();
+    const int t1 = p1.getParameterType();
+    const int t2 = p2.getParameterType();
+    EXPECT_DOUBLE_EQ(registry.getSigmaSquared(t1, t2), 1.3 * 1.3);
+    EXPECT_DOUBLE_EQ(registry.getSigmaSquared(t2, t1), 1.3 * 1.3);
+    EXPECT_DOUBLE_EQ(registry.getTwentyFourEpsilon(t1, t2), 24 * std::sqrt(21.0));
+    EXPECT_DOUBLE_EQ(registry.getSigmaSquared(t2, t2), 1.5 * 1.5);
+
+    auto difference = p2.getX() - p1.getX();
+    double squaredDistance = 1.3 * 1.3 + 0.4 * 0.4;
+    double c1 = std::pow(1.3 * 1.3 / squaredDistance, 3);
+    auto expected = ((24 * std::sqrt(21.0)) / squaredDistance) * (c1 - 2 * c1 * c1) * difference;
+    auto force = lJF.compute(p1, p2);
+    for (int d = 0; d < 3; d++) {
+        EXPECT_NEAR(force[d], expected[d], 1e-12);
+    }
+}
+
+/**
+ * A particle whose parameters have not been registered must not silently interact with the default parameters.
+ */
+
+TEST(LeonardJonesForceTest, UnregisteredParametersAreDetected) {
+    LeonardJonesForce lJF;
+    Particle p1{{0, 0, 0}, {0, 0, 0}, 1, 0, 3, 1.1};
+    Particle p2{{1.3, 0, 0}, {0, 0, 0}, 1};
+    EXPECT_TRUE(lJF.getRegistry().hasParameters(p2.getParameterType(), p2.getSigma(), p2.getEpsilon()));
+    EXPECT_FALSE(lJF.getRegistry().hasParameters(p1.getParameterType(), p1.getSigma(), p1.getEpsilon()));
+#ifndef NDEBUG
+    EXPECT_DEATH(lJF.compute(p1, p2), "Parameter type not registered");
+#endif
+    p1.setParameterType(lJF.registerParameterType(p1.getSigma(), p1.getEpsilon()));
+    EXPECT_TRUE(lJF.getRegistry().hasParameters(p1.getParameterType(), p1.getSigma(), p1.getEpsilon()));
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "particleRepresentation/container/linkedCellsContainer/CellArena.h"
+
+/**
+ * Are the requested numbers of particles rounded up to the size classes 1, 2, 3, 4, 6, 8, 12, ...?
+ */
+TEST(CellArenaTest, SizeClasses) {
+    std::vector<size_t> expected = {1, 1, 2, 3, 4, 6, 6, 8, 8, 12, 12, 12, 12, 16, 16, 16, 16, 24};
+    for (size_t n = 0; n < expected.size(); n++) {
+        EXPECT_EQ(CellArena::blockCapacity(n), expected[n]) << "n = " << n;
+    }
+    EXPECT_EQ(CellArena::blockCapacity(1000), 1024);
+    EXPECT_EQ(CellArena::blockCapacity(1025), 1536);
+}
+
+/**
+ * Are released blocks handed out again and are consecutive blocks carved from the same slab?
+ */
+TEST(CellArenaTest, ReusesReleasedBlocks) {
+    CellArena arena{64};
+    Particle *a = arena.allocate(5);
+    Particle *b = arena.allocate(3);
+    EXPECT_EQ(arena.getSlabCount(), 1);
+    EXPECT_EQ(arena.getSlabBytes(), 64 * sizeof(Particle));
+    EXPECT_EQ(b, a + 6);
+    EXPECT_EQ(arena.getBlockBytes(), 9 * sizeof(Particle));
+
+    arena.deallocate(a, 5);
+    EXPECT_EQ(arena.getBlockBytes(), 3 * sizeof(Particle));
+    EXPECT_EQ(arena.allocate(6), a);
+    arena.deallocate(a, 6);
+    arena.deallocate(b, 3);
+
+    //The slab is only left for requests larger than its rest
+    arena.allocate(48);
+    EXPECT_EQ(arena.getSlabCount(), 1);
+    arena.allocate(16);
+    EXPECT_EQ(arena.getSlabCount(), 2);
+    //The rest of the first slab has been kept as free blocks
+    EXPECT_EQ(arena.allocate(6), a + 57);
+    EXPECT_EQ(arena.getSlabBytes(), 128 * sizeof(Particle));
+}
+
+/**
+ * Does a cell keep its storage in the arena while it grows and are no slabs added once the cells have reached their
+ * sizes?
+ */
+TEST(CellArenaTest, CellStorage) {
+    CellArena arena{128};
+    ParticleCell cell{CellAllocator<Particle>{&arena}};
+    cell.reserve(100);
+    for (int i = 0; i < 100; i++) {
+        cell.emplace_back(i);
+    }
+    EXPECT_EQ(arena.getSlabCount(), 1);
+    EXPECT_EQ(cell.capacity(), 100);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(cell[i].getType(), i);
+    }
+
+    //Refill a cell from scratch again and again, the blocks of the previous round are reused
+    auto refill = [&arena, &cell]() {
+        ParticleCell other{CellAllocator<Particle>{&arena}};
+        for (int i = 0; i < 100; i++) {
+            other.emplace_back(i);
+        }
+        cell.swap(other);
+    };
+    refill();
+    const size_t slabs = arena.getSlabCount();
+    for (int round = 0; round < 10; round++) {
+        refill();
+    }
+    EXPECT_EQ(arena.getSlabCount(), slabs);
+    EXPECT_EQ(cell.size(), 100);
+    EXPECT_EQ(arena.getBlockBytes(), CellArena::blockCapacity(cell.capacity()) * sizeof(Particle));
+}
@@ -9,6 +9,7 @@
 
 #include "../../../src/fileHandling/FileHandler.h"
 #include "../../../src/particleRepresentation/container/linkedCellsContainer/LinkedCellsContainer.h"
+#include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
 
 
 
@@ -442,6 +443,103 @@ TEST(LinkedCellsContainerTest,Iterators_ApplyToAllBoundaryParticles) {
     }, Side::bottom);
 }
 
+/**
+ * Do the Morton and Hilbert cell orderings number the cells uniquely and is the conversion between one and three
+ * dimensional coordinates still consistent? Additionally, consecutive cells along the Hilbert curve have to be adjacent,
+ * if the number of cells in each dimension is a power of two.
+ */
+
+TEST(LinkedCellsContainerTest, CellOrdering_SpaceFillingCurves) {
+    BoundarySet boundaries;
+    for (CellOrdering ordering: {CellOrdering::morton, CellOrdering::hilbert}) {
+        //8 cells in each dimension, including the halo cells
+        LinkedCellsContainer lcc = {{6, 6, 6}, 1, boundaries, ParticleLayout::aos, 0, 1, ParallelStrategy::coloring, ordering};
+        std::vector<bool> used(8 * 8 * 8, false);
+        for (int z = 0; z < 8; z++) {
+            for (int y = 0; y < 8; y++) {
+                for (int x = 0; x < 8; x++) {
+                    int index = lcc.threeDToOneD(x, y, z);
+                    ASSERT_TRUE(0 <= index && index < 8 * 8 * 8);
+                    EXPECT_FALSE(used[index]);
+                    used[index] = true;
+                    std::array<int, 3> expected = {x, y, z};
+                    EXPECT_EQ(lcc.oneDToThreeD(index), expected);
+                }
+            }
+        }
+        if (ordering == CellOrdering::hilbert) {
+            for (int index = 1; index < 8 * 8 * 8; index++) {
+                auto a = lcc.oneDToThreeD(index - 1);
+                auto b = lcc.oneDToThreeD(index);
+                EXPECT_EQ(std::abs(a[0] - b[0]) + std::abs(a[1] - b[1]) + std::abs(a[2] - b[2]), 1);
+            }
+        }
+        //Particles are still assigned to the cell containing them
+        Particle p{{2.5, 0.5, 4.5}, {0, 0, 0}, 1};
+        EXPECT_EQ(lcc.calcCellIndex(p.getX()), lcc.threeDToOneD(3, 1, 5));
+    }
+}
+
+/**
+ * Does the function applyWallForces() apply the same force as a ghost particle mirrored at the wall?
+ * For each side, the forces are compared to the Leonard-Jones force of the ghost particles of applyToAllBoundaryParticles().
+ */
+
+TEST(LinkedCellsContainerTest, Iterators_ApplyWallForcesMatchesGhostParticles) {
+    BoundarySet boundaries;
+    LeonardJonesForce lJF;
+    std::vector<Particle> toAdd = {
+        Particle{{1.5,1.5,0.4},{0,0,0},1,1,1},
+        Particle{{2.5,1.5,0.5},{0,0,0},1,1,1,0.6},
+        Particle{{0.1,2.1,1.5},{0,0,0},1,1,1,0.3},
+        Particle{{1.5,2.7,1.5},{0,0,0},1,1,2,0.4},
+        Particle{{1.5,0.5,1.5},{0,0,0},1,1,1,0.5},
+        Particle{{2.9,1.2,1.5},{0,0,0},1,1,1,0.2},
+        Particle{{0.1,0.1,2.5},{0,0,0},1,1,1,0.15},
+        Particle{{1.6,2.5,2.6},{0,0,0},1,1,1,0.5}
+    };
+    for (auto &p: toAdd) {
+        p.setParameterType(lJF.registerParameterType(p.getSigma(), p.getEpsilon()));
+    }
+
+    for (Side side: {Side::front, Side::right, Side::back, Side::left, Side::top, Side::bottom}) {
+        LinkedCellsContainer wallContainer = {{3,3,3},1, boundaries};
+        LinkedCellsContainer ghostContainer = {{3,3,3},1, boundaries};
+        for (Particle p: toAdd) {
+            Particle copy = p;
+            wallContainer.add(p);
+            ghostContainer.add(copy);
+        }
+
+        wallContainer.applyWallForces([&lJF](Particle &p, double distance) {
+            return lJF.computeWall(p, distance);
+        }, side);
+        ghostContainer.applyToAllBoundaryParticles([&lJF](Particle &p, std::array<double, 3> ghostPosition) {
+            Particle ghost = p;
+            ghost.setX(ghostPosition);
+            p.setF(p.getF() + lJF.compute(p, ghost));
+        }, side);
+
+        std::vector<std::array<double, 3>> wallForces;
+        wallContainer.applyToEachParticle([&wallForces](Particle &p) {
+            wallForces.push_back(p.getF());
+        });
+        std::vector<std::array<double, 3>> ghostForces;
+        ghostContainer.applyToEachParticle([&ghostForces](Particle &p) {
+            ghostForces.push_back(p.getF());
+        });
+        ASSERT_EQ(wallForces.size(), ghostForces.size());
+        bool anyForce = false;
+        for (size_t i = 0; i < wallForces.size(); i++) {
+            for (int d = 0; d < 3; d++) {
+                EXPECT_NEAR(wallForces[i][d], ghostForces[i][d], 1e-9 * std::max(1.0, std::abs(ghostForces[i][d])));
+                anyForce = anyForce || ghostForces[i][d] != 0;
+            }
+        }
+        EXPECT_TRUE(anyForce);
+    }
+}
+
 /**
  * Does the function clearHaloCells() remove all particles from all halo cells of a specific side?
  */
@@ -524,6 +622,50 @@ TEST(LinkedCellContainerTest, UpdateCells) {
     }
 }
 
+/**
+ * Are all particles kept and assigned to their correct cell, if only some particles of crowded cells move?
+ * Staying particles may be reordered within their cell, but no particle may be lost or duplicated.
+ */
+
+TEST(LinkedCellContainerTest, UpdateCells_PartialMigration) {
+    BoundarySet boundaries;
+    LinkedCellsContainer lcc = {{3,3,3},1,boundaries};
+
+    //Add 10 particles to each cell of the slice with z = 1, every second particle will move one cell up
+    int type = 0;
+    for(int y = 0; y < 3; y++) {
+        for(int x = 0; x < 3; x++) {
+            for(int i = 0; i < 10; i++) {
+                Particle p{{x + 0.05 + 0.09 * i, y + 0.5, 0.5}, {0, 0, 0}, 1, type++};
+                lcc.add(p);
+            }
+        }
+    }
+
+    lcc.applyToEachParticle([](Particle& p) {
+        if(p.getType() % 2 == 1) {
+            p.setX(p.getX() + std::array<double, 3>{0, 0, 1});
+        }
+    });
+
+    lcc.updateCells();
+
+    std::vector<int> types;
+    for(size_t cell = 0; cell < lcc.getCells().size(); cell++) {
+        for(Particle& p : lcc.getCells()[cell]) {
+            EXPECT_EQ(lcc.calcCellIndex(p.getX()), static_cast<int>(cell));
+            EXPECT_EQ(lcc.oneDToThreeD(static_cast<int>(cell))[2], p.getType() % 2 == 1 ? 2 : 1);
+            types.push_back(p.getType());
+        }
+    }
+    std::sort(types.begin(), types.end());
+    ASSERT_EQ(types.size(), 90);
+    for(int i = 0; i < 90; i++) {
+        EXPECT_EQ(types[i], i);
+    }
+    EXPECT_EQ(lcc.size(), 90);
+}
+
 /**
  * Is the size of the linked cell container tracked properly?
  */
@@ -552,6 +694,13 @@ TEST(LinkedCellContainerTest, Size) {
     //Clear halo cells at the front and remove the 10 particles we have just added
     lcc.clearHaloCells(Side::front);
     EXPECT_EQ(lcc.size(), 100);
+
+    //Remove all particles
+    lcc.clear();
+    EXPECT_EQ(lcc.size(), 0);
+    size_t remaining = 0;
+    lcc.applyToEachParticle([&remaining](Particle &) { remaining++; });
+    EXPECT_EQ(remaining, 0);
 }
 
 /**
@@ -607,3 +756,162 @@ TEST(LinkedCellContainerTest, Add_EdgeCase_2D){
 
 
 
+
+/**
+ * Cell groups of the same colour are processed concurrently, so they must never share a cell.
+ * Additionally, each cell group has to be part of exactly one colour.
+ */
+
+TEST(LinkedCellsContainerTest, calculateColourGroups_Disjoint) {
+    BoundarySet boundaries;
+    for (std::array<double, 3> domainSize: {std::array<double, 3>{7, 8, 9}, std::array<double, 3>{7, 8, 0}}) {
+        LinkedCellsContainer lcc{domainSize, 1, boundaries};
+        auto &scheme = lcc.getDomainCellIterationScheme();
+        auto &colourGroups = lcc.getColourGroups();
+
+        EXPECT_EQ(colourGroups.size(), lcc.isTwoD() ? 9 : 18);
+
+        size_t numberCellGroups = 0;
+        for (auto &colour: colourGroups) {
+            std::set<int> touchedCells;
+            for (int cellGroup: colour) {
+                for (int cell: scheme[cellGroup]) {
+                    EXPECT_TRUE(touchedCells.insert(cell).second);
+                }
+            }
+            numberCellGroups += colour.size();
+        }
+        EXPECT_EQ(numberCellGroups, scheme.size());
+    }
+}
+
+/**
+ * Are the candidate pairs, the pairs within the cut-off radius, the particles per cell and the migrated particles counted
+ * correctly? Results for reference are calculated by hand.
+ */
+
+TEST(LinkedCellsContainerTest, CollectPairStatistics) {
+    BoundarySet boundaries;
+    LinkedCellsContainer lcc{{3, 3, 3}, 1, boundaries};
+    //Two particles within the cut-off radius in the first cell and one particle in its right neighbour, which is too
+    //far away from both of them
+    std::vector<Particle> toAdd = {
+        Particle{{0.2, 0.2, 0.2}, {0, 0, 0}, 1, 0},
+        Particle{{0.8, 0.2, 0.2}, {0, 0, 0}, 1, 1},
+        Particle{{1.9, 0.2, 0.2}, {0, 0, 0}, 1, 2}
+    };
+    for (Particle &p: toAdd) {
+        lcc.add(p);
+    }
+
+    PairStatistics statistics = lcc.collectPairStatistics();
+    EXPECT_EQ(statistics.candidatePairs, 3);
+    EXPECT_EQ(statistics.pairsWithinCutOff, 1);
+    EXPECT_EQ(statistics.verletPairs, 0);
+    ASSERT_EQ(statistics.occupancy.size(), 3);
+    EXPECT_EQ(statistics.occupancy[0], 25);
+    EXPECT_EQ(statistics.occupancy[1], 1);
+    EXPECT_EQ(statistics.occupancy[2], 1);
+    EXPECT_DOUBLE_EQ(statistics.emptyCellFraction(), 25.0 / 27);
+    EXPECT_DOUBLE_EQ(statistics.meanOccupancy(), 3.0 / 27);
+    EXPECT_EQ(statistics.migratedParticles, 0);
+
+    //Move the lonely particle one cell further and the second particle one cell up, right above the first one
+    lcc.applyToEachParticle([](Particle &p) {
+        if (p.getType() == 2) {
+            p.setX({2.5, 0.2, 0.2});
+        } else if (p.getType() == 1) {
+            p.setX({0.2, 0.2, 1.1});
+        }
+    });
+    lcc.updateCells();
+    lcc.updateCells();
+
+    statistics = lcc.collectPairStatistics();
+    EXPECT_EQ(statistics.candidatePairs, 1);
+    EXPECT_EQ(statistics.pairsWithinCutOff, 1);
+    EXPECT_EQ(statistics.migratedParticles, 0);
+    EXPECT_EQ(statistics.totalMigratedParticles, 2);
+}
+
+/**
+ * Are the capacities of the cells preallocated for the density at the first cell update and do the cells stay within
+ * the arena, while the particles move back and forth between them?
+ */
+TEST(LinkedCellsContainerTest, CellArena) {
+    BoundarySet boundaries;
+    LinkedCellsContainer lcc = {{9, 9, 9}, 3, boundaries};
+    //8 x 8 x 8 particles in 3 x 3 x 3 domain cells
+    for (int x = 0; x < 8; x++) {
+        for (int y = 0; y < 8; y++) {
+            for (int z = 0; z < 8; z++) {
+                Particle p{{0.5 + 1.1 * x, 0.5 + 1.1 * y, 0.5 + 1.1 * z}, {0, 0, 0}, 1};
+                lcc.add(p);
+            }
+        }
+    }
+    lcc.updateCells();
+    //About 19 particles per cell, rounded up to the next size class, unless a cell already holds more
+    size_t capacities = 0;
+    for (auto &cellGroup: lcc.getDomainCellIterationScheme()) {
+        auto &cell = lcc.getCells()[cellGroup[0]];
+        EXPECT_EQ(cell.capacity(), std::max<size_t>(24, CellArena::blockCapacity(cell.size())));
+        capacities += cell.capacity();
+    }
+    EXPECT_EQ(lcc.getCellArena().getSlabCount(), 1);
+    EXPECT_EQ(lcc.getCellArena().getBlockBytes(), capacities * sizeof(Particle));
+
+    double direction = 1;
+    auto move = [&lcc, &direction]() {
+        lcc.applyToEachParticle([direction](Particle &p) {
+            p.setX(p.getX() + std::array<double, 3>{0.5 * direction, 0.5 * direction, 0.5 * direction});
+        });
+        direction = -direction;
+        lcc.updateCells();
+    };
+    move();
+    move();
+    const size_t slabs = lcc.getCellArena().getSlabCount();
+    for (int i = 0; i < 20; i++) {
+        move();
+    }
+    EXPECT_EQ(lcc.getCellArena().getSlabCount(), slabs);
+    EXPECT_EQ(lcc.size(), 512);
+
+    //Re-sorting moves all particles into a single new slab
+    lcc.sortParticles();
+    EXPECT_EQ(lcc.getCellArena().getSlabCount(), 1);
+    EXPECT_EQ(lcc.size(), 512);
+    size_t particles = 0;
+    for (auto &cell: lcc.getCells()) {
+        particles += cell.size();
+    }
+    EXPECT_EQ(particles, 512);
+}
+
+/**
+ * Does a moved container keep its particles in the arena it has taken over and is assigning a container impossible?
+ */
+TEST(LinkedCellsContainerTest, CellArenaMove) {
+    static_assert(!std::is_copy_assignable_v<LinkedCellsContainer>);
+    static_assert(!std::is_move_assignable_v<LinkedCellsContainer>);
+    BoundarySet boundaries;
+    LinkedCellsContainer lcc = {{3, 3, 3}, 1, boundaries};
+    for (int i = 0; i < 10; i++) {
+        Particle p{{0.5, 0.5, 0.1 * i}, {0, 0, 0}, 1, i};
+        lcc.add(p);
+    }
+    const CellArena *arena = &lcc.getCellArena();
+    LinkedCellsContainer moved{std::move(lcc)};
+    EXPECT_EQ(&moved.getCellArena(), arena);
+    EXPECT_EQ(moved.size(), 10);
+    //Growing a cell after the move still takes the storage from the same arena
+    for (int i = 0; i < 20; i++) {
+        Particle p{{0.5, 0.5, 0.5}, {0, 0, 0}, 1, 10 + i};
+        moved.add(p);
+    }
+    EXPECT_EQ(moved.size(), 30);
+    EXPECT_EQ(moved.getCellArena().getBlockBytes(),
+              CellArena::blockCapacity(moved.getCells()[moved.calcCellIndex({0.5, 0.5, 0.5})].capacity()) *
+              sizeof(Particle));
+}
@@ -85,3 +85,27 @@ TEST_F(ParticleContainerTest, ReserveTest) {
     pc.reserve(100);
     EXPECT_EQ(pc.capacity(), 100);
 }
+
+/**
+ * Are all unique pairs visited exactly once?
+ */
+
+TEST_F(ParticleContainerTest, EachUniquePairVisitedOnce) {
+    const int n = 150;
+    for (int i = 0; i < n; i++) {
+        Particle pNew{{static_cast<double>(i), 0, 0}, {0, 0, 0}, 1};
+        pc.add(pNew);
+    }
+    std::vector<int> visits(n * n, 0);
+    pc.forEachUniquePairInDomain([&visits](Particle &p_i, Particle &p_j) {
+        int i = static_cast<int>(p_i.getX()[0]);
+        int j = static_cast<int>(p_j.getX()[0]);
+        EXPECT_LT(i, j);
+        visits[i * n + j]++;
+    });
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            EXPECT_EQ(visits[i * n + j], 1);
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "models/directSum/DirectSum.h"
+#include "models/linkedCells/LinkedCells.h"
+#include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
+#include "profiling/HardwareCounters.h"
+
+/**
+ * Do the counters count the instructions of a loop? Skipped, if the system does not permit hardware counters.
+ */
+TEST(HardwareCountersTest, CountsInstructions) {
+    HardwareCounters counters;
+    if (!counters.open() || !counters.isAvailable(CounterEvent::instructions)) {
+        GTEST_SKIP() << "Hardware counters are not available on this system";
+    }
+    auto start = counters.read();
+    volatile double sum = 0;
+    for (int i = 0; i < 1000000; i++) {
+        sum = sum + i;
+    }
+    auto counts = counters.read() - start;
+    EXPECT_GT(counts[static_cast<size_t>(CounterEvent::instructions)], 1000000);
+    counters.close();
+    EXPECT_FALSE(counters.isOpen());
+}
+
+/**
+ * Are events, which are not counted, reported as n/a instead of 0?
+ */
+TEST(HardwareCountersTest, ReportMarksUnavailableEvents) {
+    HardwareCounters counters;
+    std::stringstream report;
+    counters.printReport(report, {{"forces", 1.0, {}}}, 100);
+    EXPECT_NE(report.str().find("forces"), std::string::npos);
+    EXPECT_NE(report.str().find("n/a"), std::string::npos);
+    EXPECT_NE(report.str().find("per pair interaction"), std::string::npos);
+}
+
+/**
+ * Do the models count the pairs relating the hardware events to the force calculation?
+ */
+TEST(HardwareCountersTest, ModelsCountPairInteractions) {
+    LeonardJonesForce lJF;
+    DirectSum directSum{lJF, 0.001, FileHandler::outputFormat::vtk, false};
+    directSum.addCuboid({1, 1, 1}, 4, 5, 1, 1.1225, 1, {0, 0, 0}, 0, 0);
+    EXPECT_EQ(directSum.countPairInteractions(), 20 * 19 / 2);
+
+    BoundarySet boundaries = {
+        BoundaryCondition::outflow, BoundaryCondition::outflow, BoundaryCondition::outflow,
+        BoundaryCondition::outflow, BoundaryCondition::outflow, BoundaryCondition::outflow
+    };
+    //A line of particles with distance 1 has two neighbours within a cut-off radius of 2.5 on each side
+    LinkedCells linkedCells{lJF, 0.001, {20, 5, 5}, 2.5, FileHandler::outputFormat::vtk, boundaries, false};
+    linkedCells.addCuboid({1, 2.5, 2.5}, 10, 1, 1, 1, 1, {0, 0, 0}, 0, 0);
+    EXPECT_EQ(linkedCells.countPairInteractions(), 9 + 8);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+
+#include "fileHandling/outputWriter/AsyncOutputWriter/AsyncOutputWriter.h"
+#include "models/linkedCells/LinkedCells.h"
+#include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
+#include "particleRepresentation/container/defaultParticleContainer/DefaultParticleContainer.h"
+#include "profiling/MemoryFootprint.h"
+
+/**
+ * Is the first footprint kept as startup and the largest value of each category as peak?
+ */
+TEST(MemoryFootprintTest, StartupAndPeak) {
+    MemoryFootprint first;
+    first.add(MemoryCategory::particles, 100);
+    first.add(MemoryCategory::outputBuffers, 50);
+    MemoryFootprint second;
+    second.add(MemoryCategory::particles, 80);
+    second.add(MemoryCategory::outputBuffers, 200);
+    EXPECT_EQ(second.total(), 280);
+
+    MemoryAccounting accounting;
+    accounting.record(first);
+    accounting.record(second);
+    EXPECT_EQ(accounting.samples(), 2);
+    EXPECT_EQ(accounting.getStartup().get(MemoryCategory::particles), 100);
+    EXPECT_EQ(accounting.getPeak().get(MemoryCategory::particles), 100);
+    EXPECT_EQ(accounting.getPeak().get(MemoryCategory::outputBuffers), 200);
+    EXPECT_EQ(accounting.getPeakTotal(), 280);
+
+    std::stringstream report;
+    accounting.printReport(report);
+    EXPECT_NE(report.str().find("over 2 samples"), std::string::npos);
+    EXPECT_NE(report.str().find("output buffers"), std::string::npos);
+#ifdef __linux__
+    EXPECT_GT(MemoryAccounting::peakResidentSetSize(), 0);
+    EXPECT_NE(report.str().find("--mem="), std::string::npos);
+#endif
+
+    accounting.reset();
+    EXPECT_EQ(accounting.samples(), 0);
+    EXPECT_EQ(accounting.getPeakTotal(), 0);
+}
+
+/**
+ * Are the particles, the unused capacity of their storage and the precomputed indices of the containers accounted?
+ */
+TEST(MemoryFootprintTest, Containers) {
+    DefaultParticleContainer dpc;
+    dpc.reserve(20);
+    for (int i = 0; i < 10; i++) {
+        Particle p{{static_cast<double>(i), 0, 0}, {0, 0, 0}, 1};
+        dpc.add(p);
+    }
+    MemoryFootprint direct;
+    dpc.accountMemory(direct);
+    EXPECT_EQ(direct.get(MemoryCategory::particles), 10 * sizeof(Particle));
+    EXPECT_EQ(direct.get(MemoryCategory::cellSlack), 10 * sizeof(Particle));
+
+    LeonardJonesForce lJF;
+    BoundarySet periodic = {
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic,
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic
+    };
+    LinkedCells model = {lJF, 0.001, {9, 9, 9}, 3, FileHandler::outputFormat::vtk, periodic, false};
+    model.addCuboid({1, 1, 1}, 4, 4, 4, 1.1, 1, {0, 0, 0}, 0, 0);
+    model.updateForces();
+    MemoryFootprint linkedCells;
+    model.accountMemory(linkedCells);
+    EXPECT_EQ(linkedCells.get(MemoryCategory::particles), 64 * sizeof(Particle));
+    EXPECT_GT(linkedCells.get(MemoryCategory::haloCells), 0);
+    EXPECT_GT(linkedCells.get(MemoryCategory::boundaries), 0);
+    //27 domain cells, each paired with its 13 neighbours of the half shell
+    EXPECT_GE(linkedCells.get(MemoryCategory::cellIterationScheme), 27 * 14 * sizeof(int));
+    //The ghost layer keeps its images in the pool between steps
+    EXPECT_GT(linkedCells.get(MemoryCategory::workBuffers), 0);
+    EXPECT_EQ(linkedCells.get(MemoryCategory::verletLists), 0);
+}
+
+/**
+ * Are the snapshot buffers and the buffers of the file handler of the background writer accounted?
+ */
+TEST(MemoryFootprintTest, OutputBuffers) {
+    std::string baseName = "MemoryFootprintTest";
+    DefaultParticleContainer dpc;
+    for (int i = 0; i < 100; i++) {
+        Particle p{{static_cast<double>(i), 0, 0}, {0, 0, 0}, 1};
+        dpc.add(p);
+    }
+    outputWriter::AsyncOutputWriter writer{FileHandler::outputFormat::vtu, 2};
+    writer.submit(dpc, 0, baseName);
+    writer.flush();
+
+    MemoryFootprint footprint;
+    writer.accountMemory(footprint);
+    //The snapshot and the arrays gathered by the vtu writer
+    EXPECT_GE(footprint.get(MemoryCategory::outputBuffers), 100 * sizeof(Particle) + 100 * 11 * sizeof(float));
+    EXPECT_EQ(footprint.get(MemoryCategory::particles), 0);
+    std::remove((baseName + "_0000.vtu").c_str());
+}
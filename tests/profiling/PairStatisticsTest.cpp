@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "models/directSum/DirectSum.h"
+#include "models/linkedCells/LinkedCells.h"
+#include "moleculeSimulator/forceCalculation/leonardJones/LeonardJonesForce.h"
+#include "profiling/PairStatistics.h"
+
+namespace {
+    PairStatistics snapshot(uint64_t candidates, uint64_t withinCutOff, uint64_t totalMigrated) {
+        PairStatistics statistics;
+        statistics.candidatePairs = candidates;
+        statistics.pairsWithinCutOff = withinCutOff;
+        statistics.occupancy = {2, 0, 1, 1};
+        statistics.migratedParticles = 3;
+        statistics.totalMigratedParticles = totalMigrated;
+        return statistics;
+    }
+}
+
+/**
+ * Does the report contain the means over all samples, the histogram and the migrations of the run, and does the csv
+ * file contain one row per sample?
+ */
+TEST(PairStatisticsTest, ReportAndCSV) {
+    PairStatisticsRecorder recorder;
+    recorder.add(0, snapshot(100, 20, 10));
+    recorder.add(10, snapshot(300, 40, 40));
+    ASSERT_EQ(recorder.samples(), 2);
+    EXPECT_DOUBLE_EQ(recorder.sample(1).hitRate(), 40.0 / 300);
+    EXPECT_DOUBLE_EQ(recorder.sample(1).meanOccupancy(), 5.0 / 4);
+
+    std::stringstream report;
+    recorder.printReport(report);
+    EXPECT_NE(report.str().find("over 2 samples (iterations 0 to 10)"), std::string::npos);
+    EXPECT_NE(report.str().find("200.0"), std::string::npos);
+    EXPECT_NE(report.str().find("(15.0% of the candidates)"), std::string::npos);
+    EXPECT_NE(report.str().find("50.0%"), std::string::npos);
+    EXPECT_NE(report.str().find("30 (3.0 per step)"), std::string::npos);
+
+    const std::string path = (std::filesystem::temp_directory_path() / "MolSimPairStatisticsTest.csv").string();
+    recorder.writeCSV(path);
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    EXPECT_EQ(line.rfind("iteration,candidatePairs,pairsWithinCutOff", 0), 0);
+    std::getline(file, line);
+    EXPECT_EQ(line, "0,100,20,0.2,0,4,0.5,1.25,3,3");
+    std::filesystem::remove(path);
+
+    recorder.reset();
+    EXPECT_EQ(recorder.samples(), 0);
+}
+
+/**
+ * Are the pairs across periodic boundaries included and do the models without cells provide no statistics?
+ */
+TEST(PairStatisticsTest, ModelStatistics) {
+    LeonardJonesForce lJF;
+    BoundarySet periodic = {
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic,
+        BoundaryCondition::periodic, BoundaryCondition::periodic, BoundaryCondition::periodic
+    };
+    LinkedCells linkedCells = {lJF, 0.001, {3, 3, 3}, 1, FileHandler::outputFormat::vtk, periodic, false};
+    Particle left{{0.2, 1.5, 1.5}, {0, 0, 0}, 1, 0};
+    Particle right{{2.8, 1.5, 1.5}, {0, 0, 0}, 1, 1};
+    linkedCells.getParticles().add(left);
+    linkedCells.getParticles().add(right);
+    auto statistics = linkedCells.collectPairStatistics();
+    ASSERT_TRUE(statistics.has_value());
+    EXPECT_EQ(statistics->pairsWithinCutOff, 1);
+    EXPECT_EQ(statistics->cells(), 27);
+    //The ghost layer is emptied again
+    EXPECT_EQ(linkedCells.getParticles().size(), 2);
+
+    DirectSum directSum = {lJF, 0.001, FileHandler::outputFormat::vtk, false};
+    EXPECT_FALSE(directSum.collectPairStatistics().has_value());
+}
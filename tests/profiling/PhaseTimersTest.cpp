@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "profiling/PhaseTimers.h"
+
+/**
+ * Are the times of a phase summed within a step and stored once per step?
+ */
+TEST(PhaseTimersTest, SumsTimesPerStep) {
+    PhaseTimers timers;
+    timers.add(Phase::forces, std::chrono::nanoseconds(100));
+    timers.add(Phase::forces, std::chrono::nanoseconds(50));
+    timers.add(Phase::output, std::chrono::nanoseconds(7));
+    timers.endStep(1);
+    timers.add(Phase::forces, std::chrono::nanoseconds(20));
+    timers.endStep(2);
+
+    ASSERT_EQ(timers.steps(), 2);
+    EXPECT_EQ(timers.sample(0, Phase::forces), 150);
+    EXPECT_EQ(timers.sample(0, Phase::output), 7);
+    EXPECT_EQ(timers.sample(1, Phase::forces), 20);
+    EXPECT_EQ(timers.sample(1, Phase::output), 0);
+
+    timers.reset();
+    EXPECT_EQ(timers.steps(), 0);
+}
+
+/**
+ * Does a scoped timer add the time of its scope to the global timers?
+ */
+TEST(PhaseTimersTest, ScopedTimerMeasuresScope) {
+    PhaseTimers::global().reset();
+    {
+        ScopedPhaseTimer timer{Phase::cells};
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    PhaseTimers::global().endStep(1);
+    EXPECT_GE(PhaseTimers::global().sample(0, Phase::cells), 2000000);
+    EXPECT_EQ(PhaseTimers::global().sample(0, Phase::forces), 0);
+    PhaseTimers::global().reset();
+}
+
+/**
+ * Does the report contain the percentiles of the phases that occurred and does the csv file contain one row per step?
+ */
+TEST(PhaseTimersTest, ReportAndCSV) {
+    PhaseTimers timers;
+    for (int step = 1; step <= 100; step++) {
+        timers.add(Phase::forces, std::chrono::milliseconds(step));
+        timers.endStep(step);
+    }
+    std::stringstream report;
+    timers.printReport(report);
+    EXPECT_NE(report.str().find("over 100 steps"), std::string::npos);
+    //Mean 50.5 ms, median 50 ms and 99th percentile 99 ms
+    EXPECT_NE(report.str().find("50.5000"), std::string::npos);
+    EXPECT_NE(report.str().find("50.0000"), std::string::npos);
+    EXPECT_NE(report.str().find("99.0000"), std::string::npos);
+    EXPECT_EQ(report.str().find("thermostat"), std::string::npos);
+
+    const std::string path = "PhaseTimersTest.csv";
+    timers.writeCSV(path);
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    EXPECT_EQ(line.rfind("iteration,forces,", 0), 0);
+    int rows = 0;
+    while (std::getline(file, line)) {
+        rows++;
+    }
+    EXPECT_EQ(rows, 100);
+    std::remove(path.c_str());
+}
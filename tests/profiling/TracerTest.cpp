@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "profiling/Tracer.h"
+
+namespace {
+    void recordSpan(Tracer &tracer, const char *name) {
+        const auto now = std::chrono::steady_clock::now();
+        tracer.record(name, now, now + std::chrono::microseconds(5));
+    }
+}
+
+/**
+ * Does the ring buffer keep the most recent spans in order and count the overwritten ones?
+ */
+TEST(TracerTest, KeepsMostRecentSpans) {
+    Tracer tracer;
+    EXPECT_THROW(tracer.enable(0), std::invalid_argument);
+    tracer.enable(3);
+    const char *names[] = {"a", "b", "c", "d", "e"};
+    for (const char *name: names) {
+        recordSpan(tracer, name);
+    }
+    tracer.disable();
+
+    auto spans = tracer.spans();
+    ASSERT_EQ(spans.size(), 3);
+    EXPECT_STREQ(spans[0].name, "c");
+    EXPECT_STREQ(spans[2].name, "e");
+    EXPECT_EQ(spans[0].duration, 5000);
+    EXPECT_EQ(tracer.dropped(), 2);
+
+    //Enabling the tracer again discards the old spans
+    tracer.enable(3);
+    EXPECT_TRUE(tracer.spans().empty());
+    EXPECT_EQ(tracer.dropped(), 0);
+}
+
+/**
+ * Are the spans of different threads told apart?
+ */
+TEST(TracerTest, RecordsSpansOfAllThreads) {
+    Tracer tracer;
+    tracer.enable(100);
+    recordSpan(tracer, "main");
+    std::thread worker([&tracer]() {
+        recordSpan(tracer, "worker");
+    });
+    worker.join();
+    tracer.disable();
+
+    auto spans = tracer.spans();
+    ASSERT_EQ(spans.size(), 2);
+    EXPECT_EQ(spans[0].thread, Tracer::threadNumber());
+    EXPECT_NE(spans[1].thread, spans[0].thread);
+}
+
+/**
+ * Does the JSON file contain one complete event per span and the names of the threads?
+ */
+TEST(TracerTest, WritesTraceEvents) {
+    Tracer tracer;
+    tracer.enable(10);
+    recordSpan(tracer, "forces");
+    recordSpan(tracer, "say \"hi\"");
+    tracer.disable();
+
+    const std::string path = (std::filesystem::temp_directory_path() / "MolSimTracerTest.json").string();
+    tracer.writeJSON(path, 3);
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    const std::string json = content.str();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0);
+    EXPECT_NE(json.find("{\"name\":\"forces\",\"cat\":\"MolSim\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"dur\":5.000,\"pid\":3"), std::string::npos);
+    EXPECT_NE(json.find("\"say \\\"hi\\\"\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"main\"}"), std::string::npos);
+    std::filesystem::remove(path);
+}
+
+/**
+ * Does a scoped span only record while the global tracer is enabled?
+ */
+TEST(TracerTest, ScopedSpanRecordsIfEnabled) {
+    {
+        ScopedTraceSpan span{"disabled"};
+    }
+    Tracer::global().enable(10);
+    {
+        ScopedTraceSpan span{"enabled"};
+    }
+    Tracer::global().disable();
+    auto spans = Tracer::global().spans();
+    ASSERT_EQ(spans.size(), 1);
+    EXPECT_STREQ(spans[0].name, "enabled");
+}